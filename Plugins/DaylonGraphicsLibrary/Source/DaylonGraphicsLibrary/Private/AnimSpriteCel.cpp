@@ -28,7 +28,8 @@ void Daylon::FAnimSpriteCel::Init
 
 	SrcPx = InSrcPx;
 	DstPx = InDstPx;
-	OriginalLifepsan = LifeRemaining = InAge;
+	OriginalLifepsan = InAge;
+	SetLifeRemaining(InAge);
 	StartAge = InStartAge;
 }
 
@@ -49,9 +50,9 @@ void Daylon::FAnimSpriteCel::Update(float DeltaTime)
 		bAnimating = true;
 	}
 
-	LifeRemaining = FMath::Max(0.0f, LifeRemaining - DeltaTime);
+	SetLifeRemaining(FMath::Max(0.0f, GetLifeRemaining() - DeltaTime));
 
-	const float T = 1.0f - (LifeRemaining / OriginalLifepsan);
+	const float T = 1.0f - (GetLifeRemaining() / OriginalLifepsan);
 	const float Opacity = T;
 
 	SetRenderOpacity(Opacity);
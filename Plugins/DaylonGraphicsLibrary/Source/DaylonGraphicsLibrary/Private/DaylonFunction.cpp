@@ -0,0 +1,106 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#include "DaylonFunction.h"
+#include "DaylonLogging.h"
+#include "Misc/ScopeLock.h"
+
+
+// Set to 1 to enable debugging
+#define DEBUG_MODULE                0
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", off)
+#endif
+
+
+namespace
+{
+	struct FFreeBlock
+	{
+		FFreeBlock* Next;
+	};
+
+
+	struct FCaptureBlockPoolState
+	{
+		FCriticalSection  Lock;
+		FFreeBlock*       FreeList  = nullptr;
+		int32             NumBlocks = 0;
+	};
+
+
+	constexpr int32 BlocksPerChunk = 16;
+
+
+	FCaptureBlockPoolState& GetPoolState()
+	{
+		static FCaptureBlockPoolState State;
+		return State;
+	}
+}
+
+
+void* Daylon::FCaptureBlockPool::Allocate()
+{
+	auto& Pool = GetPoolState();
+
+	FScopeLock Lock(&Pool.Lock);
+
+	if(Pool.FreeList == nullptr)
+	{
+		auto Chunk = (uint8*)FMemory::Malloc(BlockSize * BlocksPerChunk, BlockAlignment);
+
+		for(int32 Index = BlocksPerChunk - 1; Index >= 0; Index--)
+		{
+			auto Block = (FFreeBlock*)(Chunk + Index * BlockSize);
+
+			Block->Next   = Pool.FreeList;
+			Pool.FreeList = Block;
+		}
+
+		Pool.NumBlocks += BlocksPerChunk;
+
+		UE_LOG(LogDaylon, Verbose, TEXT("FCaptureBlockPool grew to %d blocks"), Pool.NumBlocks);
+	}
+
+	auto Block = Pool.FreeList;
+
+	Pool.FreeList = Block->Next;
+
+	return Block;
+}
+
+
+void Daylon::FCaptureBlockPool::Free(void* Block)
+{
+	if(Block == nullptr)
+	{
+		return;
+	}
+
+	auto& Pool = GetPoolState();
+
+	FScopeLock Lock(&Pool.Lock);
+
+	auto FreeBlock = (FFreeBlock*)Block;
+
+	FreeBlock->Next = Pool.FreeList;
+	Pool.FreeList   = FreeBlock;
+}
+
+
+int32 Daylon::FCaptureBlockPool::GetNumBlocks()
+{
+	auto& Pool = GetPoolState();
+
+	FScopeLock Lock(&Pool.Lock);
+
+	return Pool.NumBlocks;
+}
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", on)
+#endif
+
+#undef DEBUG_MODULE
@@ -3,7 +3,6 @@
 #include "DaylonGeometry.h"
 #include "DaylonRNG.h"
 #include "Runtime/Engine/Classes/Kismet/KismetMathLibrary.h"
-#include "Runtime/GeometryCore/Public/Intersection/IntrTriangle2Triangle2.h"
 #include "Runtime/GeometryCore/Public/MathUtil.h"
 
 
@@ -29,6 +28,12 @@ FVector2D Daylon::AngleToVector2D(float Angle)
 
 
 FVector2D Daylon::RandVector2D()
+{
+	return RandVector2D(Rng);
+}
+
+
+FVector2D Daylon::RandVector2D(FRng& Rng)
 {
 	FVector2D Result;
 	FVector::FReal L;
@@ -36,8 +41,8 @@ FVector2D Daylon::RandVector2D()
 	do
 	{
 		// Check random vectors in the unit sphere so result is statistically uniform.
-		Result.X = Daylon::FRand() * 2.f - 1.f;
-		Result.Y = Daylon::FRand() * 2.f - 1.f;
+		Result.X = Rng.FRand() * 2.f - 1.f;
+		Result.Y = Rng.FRand() * 2.f - 1.f;
 		L = Result.SizeSquared();
 	} while (L > 1.0f || L < UE_KINDA_SMALL_NUMBER);
 
@@ -71,7 +76,13 @@ float Daylon::WrapAngle(float Angle)
 
 FVector2D Daylon::DeviateVector(const FVector2D& VectorOld, float MinDeviation, float MaxDeviation)
 {
-	return Daylon::Rotate(VectorOld, Daylon::FRandRange(MinDeviation, MaxDeviation));
+	return DeviateVector(Rng, VectorOld, MinDeviation, MaxDeviation);
+}
+
+
+FVector2D Daylon::DeviateVector(FRng& Rng, const FVector2D& VectorOld, float MinDeviation, float MaxDeviation)
+{
+	return Daylon::Rotate(VectorOld, Rng.FRandRange(MinDeviation, MaxDeviation));
 }
 
 
@@ -81,32 +92,76 @@ bool Daylon::DoCirclesIntersect(const FVector2D& C1, float R1, const FVector2D&
 }
 
 
-static UE::Geometry::TIntrTriangle2Triangle2<double> TriTriIntersector;
+static bool IsSeparatingAxis(const FVector2D& EdgeStart, const FVector2D& EdgeEnd, const FVector2D* PointsA, int32 NumA, const FVector2D* PointsB, int32 NumB)
+{
+	// Project both point sets onto the edge's normal. If the projections don't overlap,
+	// the normal is a separating axis and the shapes can't intersect.
+	// Touching counts as overlapping. Zero-length edges have no normal and separate nothing.
+
+	const FVector2D Axis(EdgeStart.Y - EdgeEnd.Y, EdgeEnd.X - EdgeStart.X);
+
+	if(Axis.IsZero())
+	{
+		return false;
+	}
+
+	double MinA = FVector2D::DotProduct(PointsA[0], Axis);
+	double MaxA = MinA;
+
+	for(int32 Index = 1; Index < NumA; Index++)
+	{
+		const double D = FVector2D::DotProduct(PointsA[Index], Axis);
+
+		MinA = FMath::Min(MinA, D);
+		MaxA = FMath::Max(MaxA, D);
+	}
+
+	double MinB = FVector2D::DotProduct(PointsB[0], Axis);
+	double MaxB = MinB;
+
+	for(int32 Index = 1; Index < NumB; Index++)
+	{
+		const double D = FVector2D::DotProduct(PointsB[Index], Axis);
+
+		MinB = FMath::Min(MinB, D);
+		MaxB = FMath::Max(MaxB, D);
+	}
+
+	return (MaxA < MinB || MaxB < MinA);
+}
 
 
 bool Daylon::DoesLineSegmentIntersectTriangle(const FVector2D& P1, const FVector2D& P2, const FVector2D Triangle[3])
 {
-	// Use a degenerate triangle to mimic the line segment.
+	// Separating axis test using the segment's normal and the triangle's edge normals.
+	// Keeps no state, so it's safe to call from any thread.
 
-	UE::Geometry::FTriangle2d Tri0(P1, P2, P2);
-	TriTriIntersector.SetTriangle0(Tri0);
+	const FVector2D Segment[2] = { P1, P2 };
 
-	UE::Geometry::FTriangle2d Tri1(Triangle);
-	TriTriIntersector.SetTriangle1(Tri1);
-
-	return TriTriIntersector.Test();
+	return !(IsSeparatingAxis(P1,          P2,          Segment, 2, Triangle, 3)
+		  || IsSeparatingAxis(Triangle[0], Triangle[1], Segment, 2, Triangle, 3)
+		  || IsSeparatingAxis(Triangle[1], Triangle[2], Segment, 2, Triangle, 3)
+		  || IsSeparatingAxis(Triangle[2], Triangle[0], Segment, 2, Triangle, 3));
 }
 
 
 bool Daylon::DoTrianglesIntersect(const FVector2D TriA[3], const FVector2D TriB[3])
 {
-	UE::Geometry::FTriangle2d Tri0(TriA);
-	TriTriIntersector.SetTriangle0(Tri0);
+	// Separating axis test using the edge normals of both triangles.
+	// Keeps no state, so it's safe to call from any thread.
+
+	for(int32 Index = 0; Index < 3; Index++)
+	{
+		const int32 Next = (Index + 1) % 3;
 
-	UE::Geometry::FTriangle2d Tri1(TriB);
-	TriTriIntersector.SetTriangle1(Tri1);
+		if(IsSeparatingAxis(TriA[Index], TriA[Next], TriA, 3, TriB, 3)
+			|| IsSeparatingAxis(TriB[Index], TriB[Next], TriA, 3, TriB, 3))
+		{
+			return false;
+		}
+	}
 
-	return TriTriIntersector.Test();
+	return true;
 }
 
 
@@ -243,7 +298,131 @@ bool Daylon::DoesLineSegmentIntersectCircle(const FVector2D& P1, const FVector2D
 }
 
 
+bool Daylon::DoesLineSegmentIntersectCircleFast(const FVector2D& P1, const FVector2D& P2, const FVector2D& CP, double R)
+{
+	// Same test as DoesLineSegmentIntersectCircle, done by finding the point on the segment
+	// closest to the circle center and comparing squared distances.
+	// This is the scalar version of DoesLineSegmentIntersectCircles, and does the same
+	// arithmetic in the same order as its vector lanes.
+
+	const FVector2D Delta = P2 - P1;
+
+	const double LengthSquared    = Delta.SizeSquared();
+	const double InvLengthSquared = (LengthSquared > 0.0 ? 1.0 / LengthSquared : 0.0);
+
+	const double ToCX = CP.X - P1.X;
+	const double ToCY = CP.Y - P1.Y;
+
+	const double T = FMath::Clamp((ToCX * Delta.X + ToCY * Delta.Y) * InvLengthSquared, 0.0, 1.0);
+
+	const double DX = ToCX - T * Delta.X;
+	const double DY = ToCY - T * Delta.Y;
+
+	const double DistanceSquared = DX * DX + DY * DY;
+
+	// Touching counts, like the tangent case of DoesLineSegmentIntersectCircle,
+	// but a zero-length segment has to be inside, like DoesPointIntersectCircle.
+
+	return (LengthSquared > 0.0 ? DistanceSquared <= R * R : DistanceSquared < R * R);
+}
+
+
+int32 Daylon::DoesLineSegmentIntersectCircles(const FVector2D& P1, const FVector2D& P2, const FCircleArray& Circles, TBitArray<>& OutHitMask)
+{
+	const int32 NumCircles = Circles.Num();
+
+	OutHitMask.Init(false, NumCircles);
+
+	if(NumCircles == 0)
+	{
+		return 0;
+	}
+
+	check(Circles.Y.Num() == NumCircles && Circles.Radius.Num() == NumCircles);
+
+	// The segment is the same for every circle, so work out its terms once.
+
+	const FVector2D Delta = P2 - P1;
+
+	const double LengthSquared    = Delta.SizeSquared();
+	const double InvLengthSquared = (LengthSquared > 0.0 ? 1.0 / LengthSquared : 0.0); // Zero length makes T zero, i.e. a point test.
+	const bool   IsPoint          = (LengthSquared == 0.0);                             // Points must be inside, not just touching; see DoesLineSegmentIntersectCircleFast.
+
+	const VectorRegister4Double P1X       = MakeVectorRegisterDouble(P1.X, P1.X, P1.X, P1.X);
+	const VectorRegister4Double P1Y       = MakeVectorRegisterDouble(P1.Y, P1.Y, P1.Y, P1.Y);
+	const VectorRegister4Double DeltaX    = MakeVectorRegisterDouble(Delta.X, Delta.X, Delta.X, Delta.X);
+	const VectorRegister4Double DeltaY    = MakeVectorRegisterDouble(Delta.Y, Delta.Y, Delta.Y, Delta.Y);
+	const VectorRegister4Double InvLenSq  = MakeVectorRegisterDouble(InvLengthSquared, InvLengthSquared, InvLengthSquared, InvLengthSquared);
+	const VectorRegister4Double Zero      = MakeVectorRegisterDouble(0.0, 0.0, 0.0, 0.0);
+	const VectorRegister4Double One       = MakeVectorRegisterDouble(1.0, 1.0, 1.0, 1.0);
+
+	const double* X = Circles.X.GetData();
+	const double* Y = Circles.Y.GetData();
+	const double* R = Circles.Radius.GetData();
+
+	int32 NumHits = 0;
+	int32 Index   = 0;
+
+	for(; Index + 4 <= NumCircles; Index += 4)
+	{
+		const VectorRegister4Double CX = VectorLoad(X + Index);
+		const VectorRegister4Double CY = VectorLoad(Y + Index);
+		const VectorRegister4Double CR = VectorLoad(R + Index);
+
+		// Parametric position of the closest point on the segment, clamped to its ends.
+
+		const VectorRegister4Double ToCX = VectorSubtract(CX, P1X);
+		const VectorRegister4Double ToCY = VectorSubtract(CY, P1Y);
+
+		VectorRegister4Double T = VectorMultiply(VectorMultiplyAdd(ToCX, DeltaX, VectorMultiply(ToCY, DeltaY)), InvLenSq);
+		T = VectorMin(VectorMax(T, Zero), One);
+
+		// Squared distance from the circle center to that point.
+
+		const VectorRegister4Double DX = VectorSubtract(ToCX, VectorMultiply(T, DeltaX));
+		const VectorRegister4Double DY = VectorSubtract(ToCY, VectorMultiply(T, DeltaY));
+
+		const VectorRegister4Double DistanceSquared = VectorMultiplyAdd(DX, DX, VectorMultiply(DY, DY));
+
+		const VectorRegister4Double RadiusSquared = VectorMultiply(CR, CR);
+
+		const uint32 Mask = (uint32)VectorMaskBits(IsPoint ? VectorCompareLT(DistanceSquared, RadiusSquared) : VectorCompareLE(DistanceSquared, RadiusSquared));
+
+		if(Mask != 0)
+		{
+			for(int32 Lane = 0; Lane < 4; Lane++)
+			{
+				if(Mask & (1u << Lane))
+				{
+					OutHitMask[Index + Lane] = true;
+					NumHits++;
+				}
+			}
+		}
+	}
+
+	// Leftover circles.
+
+	for(; Index < NumCircles; Index++)
+	{
+		if(DoesLineSegmentIntersectCircleFast(P1, P2, FVector2D(X[Index], Y[Index]), R[Index]))
+		{
+			OutHitMask[Index] = true;
+			NumHits++;
+		}
+	}
+
+	return NumHits;
+}
+
+
 FVector2D Daylon::ComputeFiringSolution(const FVector2D& LaunchP, float TorpedoSpeed, const FVector2D& TargetP, const FVector2D& TargetInertia)
+{
+	return ComputeFiringSolution(Rng, LaunchP, TorpedoSpeed, TargetP, TargetInertia);
+}
+
+
+FVector2D Daylon::ComputeFiringSolution(FRng& Rng, const FVector2D& LaunchP, float TorpedoSpeed, const FVector2D& TargetP, const FVector2D& TargetInertia)
 {
 	// Given launch and target positions, torpedo speed, and target inertia, 
 	// return a firing direction.
@@ -259,7 +438,7 @@ FVector2D Daylon::ComputeFiringSolution(const FVector2D& LaunchP, float TorpedoS
 
 	if(Desc <= 0)
 	{
-		return Daylon::RandVector2D();
+		return Daylon::RandVector2D(Rng);
 	}
 
 	const auto TimeToTarget = 2 * C / (FMath::Sqrt(Desc) - B);
@@ -277,7 +456,13 @@ FVector2D Daylon::ComputeFiringSolution(const FVector2D& LaunchP, float TorpedoS
 
 FVector2D Daylon::RandomPtWithinBox(const FBox2d& Box)
 {
-	return FVector2D(Daylon::FRandRange(Box.Min.X, Box.Max.X), Daylon::FRandRange(Box.Min.Y, Box.Max.Y));
+	return RandomPtWithinBox(Rng, Box);
+}
+
+
+FVector2D Daylon::RandomPtWithinBox(FRng& Rng, const FBox2d& Box)
+{
+	return FVector2D(Rng.FRandRange(Box.Min.X, Box.Max.X), Rng.FRandRange(Box.Min.Y, Box.Max.Y));
 }
 
 
@@ -352,6 +537,94 @@ void Daylon::ComputeCollisionInertia
 }
 
 
+int32 Daylon::GetWrapGhostDirections(const FBox2d& Bounds, const FVector2D& WrapSize, FIntPoint OutDirections[MaxWrapGhosts])
+{
+	// Poking past the west edge puts a ghost near the east edge, etc.
+
+	int32 DX = 0;
+	int32 DY = 0;
+
+	if(Bounds.Min.X < 0.0)
+	{
+		DX = 1;
+	}
+	else if(Bounds.Max.X > WrapSize.X)
+	{
+		DX = -1;
+	}
+
+	if(Bounds.Min.Y < 0.0)
+	{
+		DY = 1;
+	}
+	else if(Bounds.Max.Y > WrapSize.Y)
+	{
+		DY = -1;
+	}
+
+	int32 NumGhosts = 0;
+
+	if(DX != 0)
+	{
+		OutDirections[NumGhosts++] = FIntPoint(DX, 0);
+	}
+
+	if(DY != 0)
+	{
+		OutDirections[NumGhosts++] = FIntPoint(0, DY);
+	}
+
+	if(DX != 0 && DY != 0)
+	{
+		// Near a corner, the object shows up in the diagonally opposite corner too.
+		OutDirections[NumGhosts++] = FIntPoint(DX, DY);
+	}
+
+	return NumGhosts;
+}
+
+
+int32 Daylon::GetWrapOffsets(const FBox2d& TargetBounds, const FBox2d& OtherBounds, const FVector2D& WrapSize, FVector2D OutOffsets[MaxWrapOffsets])
+{
+	// Every pairing of the target (or one of its ghosts) with the other object (or one of its ghosts)
+	// amounts to moving the target by the difference of their displacements.
+
+	FIntPoint TargetDirections [MaxWrapGhosts + 1] = { FIntPoint(0, 0) };
+	FIntPoint OtherDirections  [MaxWrapGhosts + 1] = { FIntPoint(0, 0) };
+
+	const int32 NumTargetDirections = 1 + GetWrapGhostDirections(TargetBounds, WrapSize, &TargetDirections[1]);
+	const int32 NumOtherDirections  = 1 + GetWrapGhostDirections(OtherBounds,  WrapSize, &OtherDirections[1]);
+
+	int32 NumOffsets = 0;
+
+	for(int32 TargetIndex = 0; TargetIndex < NumTargetDirections; TargetIndex++)
+	{
+		for(int32 OtherIndex = 0; OtherIndex < NumOtherDirections; OtherIndex++)
+		{
+			const FVector2D Offset = FVector2D(TargetDirections[TargetIndex] - OtherDirections[OtherIndex]) * WrapSize;
+
+			bool IsUnique = true;
+
+			for(int32 Index = 0; Index < NumOffsets; Index++)
+			{
+				if(OutOffsets[Index] == Offset)
+				{
+					IsUnique = false;
+					break;
+				}
+			}
+
+			if(IsUnique)
+			{
+				OutOffsets[NumOffsets++] = Offset;
+			}
+		}
+	}
+
+	return NumOffsets;
+}
+
+
 #if(DEBUG_MODULE == 1)
 #pragma optimize("", on)
 #endif
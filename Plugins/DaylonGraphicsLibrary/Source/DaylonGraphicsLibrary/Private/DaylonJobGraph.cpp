@@ -0,0 +1,197 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#include "DaylonJobGraph.h"
+#include "DaylonLogging.h"
+#include "Tasks/Task.h"
+#include "Misc/ScopeLock.h"
+#include "Widgets/SWidget.h"
+
+
+// Set to 1 to enable debugging
+#define DEBUG_MODULE                0
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", off)
+#endif
+
+
+void Daylon::FJobGraph::Add(const TCHAR* Name, FJobDataMask Reads, FJobDataMask Writes, bool bGameThread, FJobFunction&& Work)
+{
+	if(!Work)
+	{
+		UE_LOG(LogDaylon, Warning, TEXT("FJobGraph::Add: job %s has no function"), Name);
+		return;
+	}
+
+	auto& Job = Jobs.AddDefaulted_GetRef();
+
+	Job.Name        = Name;
+	Job.Reads       = Reads;
+	Job.Writes      = Writes;
+	Job.bGameThread = bGameThread;
+	Job.Work        = MoveTemp(Work);
+}
+
+
+bool Daylon::FJobGraph::DependsOn(int32 Job, int32 EarlierJob) const
+{
+	const auto& Later   = Jobs[Job];
+	const auto& Earlier = Jobs[EarlierJob];
+
+	return ((Earlier.Writes & (Later.Reads | Later.Writes)) != 0 || (Earlier.Reads & Later.Writes) != 0);
+}
+
+
+void Daylon::FJobGraph::Run(bool bParallel)
+{
+	check(IsInGameThread());
+
+	if(!bParallel || Jobs.Num() < 2)
+	{
+		for(auto& Job : Jobs)
+		{
+			Job.Work();
+		}
+
+		return;
+	}
+
+	const int32 NumJobs = Jobs.Num();
+
+	TArray<UE::Tasks::FTask, TInlineAllocator<16>> Tasks;  // Worker jobs only
+	TArray<bool,             TInlineAllocator<16>> Started; // Launched, or run if a game thread job
+
+	Tasks  .SetNum(NumJobs);
+	Started.Init(false, NumJobs);
+
+	auto GetPrerequisites = [&](int32 Job)
+	{
+		// Earlier game thread jobs have already run, so only workers are waited on.
+
+		TArray<UE::Tasks::FTask, TInlineAllocator<16>> Prerequisites;
+
+		for(int32 Earlier = 0; Earlier < Job; Earlier++)
+		{
+			if(!Jobs[Earlier].bGameThread && DependsOn(Job, Earlier))
+			{
+				Prerequisites.Add(Tasks[Earlier]);
+			}
+		}
+
+		return Prerequisites;
+	};
+
+	int32 NumStarted = 0;
+
+	while(NumStarted < NumJobs)
+	{
+		// Launch every worker job whose prerequisites have run or been launched.
+		// Dependencies only point backward, so one pass in order catches chains of them.
+
+		for(int32 Index = 0; Index < NumJobs; Index++)
+		{
+			if(Started[Index] || Jobs[Index].bGameThread)
+			{
+				continue;
+			}
+
+			bool bReady = true;
+
+			for(int32 Earlier = 0; Earlier < Index && bReady; Earlier++)
+			{
+				bReady = (Started[Earlier] || !DependsOn(Index, Earlier));
+			}
+
+			if(!bReady)
+			{
+				continue;
+			}
+
+			auto& Job = Jobs[Index];
+
+			Tasks[Index] = UE::Tasks::Launch(Job.Name, [&Job]() { Job.Work(); }, GetPrerequisites(Index));
+
+			Started[Index] = true;
+			NumStarted++;
+		}
+
+		// Then run the next game thread job. Everything before it has been launched or run by now.
+
+		for(int32 Index = 0; Index < NumJobs; Index++)
+		{
+			if(Started[Index] || !Jobs[Index].bGameThread)
+			{
+				continue;
+			}
+
+			UE::Tasks::Wait(GetPrerequisites(Index));
+
+			Jobs[Index].Work();
+
+			Started[Index] = true;
+			NumStarted++;
+			break;
+		}
+	}
+
+	for(int32 Index = 0; Index < NumJobs; Index++)
+	{
+		if(!Jobs[Index].bGameThread)
+		{
+			Tasks[Index].Wait();
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+namespace
+{
+	struct FDeferredInvalidation
+	{
+		TWeakPtr<SWidget>        Widget;
+		EInvalidateWidgetReason  Reason;
+	};
+
+	FCriticalSection               DeferredInvalidationsLock;
+	TArray<FDeferredInvalidation>  DeferredInvalidations;
+}
+
+
+void Daylon::InvalidateWidget(SWidget& Widget, EInvalidateWidgetReason Reason)
+{
+	if(IsInGameThread())
+	{
+		Widget.Invalidate(Reason);
+		return;
+	}
+
+	FScopeLock Lock(&DeferredInvalidationsLock);
+
+	DeferredInvalidations.Add({ Widget.AsShared(), Reason });
+}
+
+
+void Daylon::FlushDeferredInvalidations()
+{
+	check(IsInGameThread());
+
+	FScopeLock Lock(&DeferredInvalidationsLock);
+
+	for(const auto& Entry : DeferredInvalidations)
+	{
+		if(auto Widget = Entry.Widget.Pin())
+		{
+			Widget->Invalidate(Entry.Reason);
+		}
+	}
+
+	DeferredInvalidations.Reset();
+}
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", on)
+#endif
+
+#undef DEBUG_MODULE
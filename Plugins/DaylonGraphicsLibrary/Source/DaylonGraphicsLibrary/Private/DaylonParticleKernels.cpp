@@ -0,0 +1,103 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#include "DaylonParticleKernels.h"
+
+
+// Set to 1 to enable debugging
+#define DEBUG_MODULE                0
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", off)
+#endif
+
+
+template <bool bComputeLiveMask>
+static int32 IntegrateParticlesImpl(float* X, float* Y, const float* InertiaX, const float* InertiaY, float* LifeRemaining, int32 Count, float DeltaTime, uint32* LiveWords)
+{
+	const VectorRegister4Float DT   = VectorSetFloat1(DeltaTime);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+
+	int32 NumLive = 0;
+	int32 Index   = 0;
+
+	for(; Index + 4 <= Count; Index += 4)
+	{
+		const VectorRegister4Float PX   = VectorMultiplyAdd(VectorLoad(InertiaX + Index), DT, VectorLoad(X + Index));
+		const VectorRegister4Float PY   = VectorMultiplyAdd(VectorLoad(InertiaY + Index), DT, VectorLoad(Y + Index));
+		const VectorRegister4Float Life = VectorSubtract(VectorLoad(LifeRemaining + Index), DT);
+
+		VectorStore(PX,   X             + Index);
+		VectorStore(PY,   Y             + Index);
+		VectorStore(Life, LifeRemaining + Index);
+
+		if(bComputeLiveMask)
+		{
+			const uint32 Mask = (uint32)VectorMaskBits(VectorCompareGT(Life, Zero));
+
+			// Index is a multiple of four, so the four bits never straddle two words.
+			LiveWords[Index >> 5] |= Mask << (Index & 31);
+			NumLive += FMath::CountBits(Mask);
+		}
+	}
+
+	// Leftover particles.
+
+	for(; Index < Count; Index++)
+	{
+		X[Index]             += InertiaX[Index] * DeltaTime;
+		Y[Index]             += InertiaY[Index] * DeltaTime;
+		LifeRemaining[Index] -= DeltaTime;
+
+		if(bComputeLiveMask && LifeRemaining[Index] > 0.0f)
+		{
+			LiveWords[Index >> 5] |= 1u << (Index & 31);
+			NumLive++;
+		}
+	}
+
+	return NumLive;
+}
+
+
+void Daylon::IntegrateParticles(float* X, float* Y, const float* InertiaX, const float* InertiaY, float* LifeRemaining, int32 Count, float DeltaTime)
+{
+	IntegrateParticlesImpl<false>(X, Y, InertiaX, InertiaY, LifeRemaining, Count, DeltaTime, nullptr);
+}
+
+
+int32 Daylon::IntegrateParticles(float* X, float* Y, const float* InertiaX, const float* InertiaY, float* LifeRemaining, int32 Count, float DeltaTime, TBitArray<>& OutLiveMask)
+{
+	OutLiveMask.Init(false, Count);
+
+	if(Count == 0)
+	{
+		return 0;
+	}
+
+	return IntegrateParticlesImpl<true>(X, Y, InertiaX, InertiaY, LifeRemaining, Count, DeltaTime, OutLiveMask.GetData());
+}
+
+
+void Daylon::AdvanceAngles(float* Angle, const float* Spin, int32 Count, float DeltaTime)
+{
+	const VectorRegister4Float DT = VectorSetFloat1(DeltaTime);
+
+	int32 Index = 0;
+
+	for(; Index + 4 <= Count; Index += 4)
+	{
+		VectorStore(VectorMultiplyAdd(VectorLoad(Spin + Index), DT, VectorLoad(Angle + Index)), Angle + Index);
+	}
+
+	for(; Index < Count; Index++)
+	{
+		Angle[Index] += Spin[Index] * DeltaTime;
+	}
+}
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", on)
+#endif
+
+#undef DEBUG_MODULE
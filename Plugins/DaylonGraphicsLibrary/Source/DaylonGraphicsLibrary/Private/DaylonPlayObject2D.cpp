@@ -2,9 +2,97 @@
 
 #include "DaylonPlayObject2D.h"
 #include "DaylonWidgetUtils.h"
+#include "DaylonJobGraph.h"
 #include "DaylonLogging.h"
+#include "Misc/ScopeLock.h"
 
 
+// Play objects waiting for SyncPlayObjects(). Only touched from the game thread.
+static TArray<Daylon::FPlayObjectSyncable*> PendingPlayObjectSyncs;
+
+// Play objects marked dirty by worker frame jobs. They join PendingPlayObjectSyncs at the next sync.
+static FCriticalSection                     DeferredPlayObjectSyncsLock;
+static TArray<Daylon::FPlayObjectSyncable*> DeferredPlayObjectSyncs;
+
+
+Daylon::FPlayObjectSyncable::~FPlayObjectSyncable()
+{
+	if(bSyncPending)
+	{
+		PendingPlayObjectSyncs.RemoveSingleSwap(this, false);
+
+		FScopeLock Lock(&DeferredPlayObjectSyncsLock);
+		DeferredPlayObjectSyncs.RemoveSingleSwap(this, false);
+	}
+}
+
+
+void Daylon::FPlayObjectSyncable::MarkTransformDirty()
+{
+	if(bSyncPending || bDrawnByBatch)
+	{
+		return;
+	}
+
+	bSyncPending = true;
+
+	if(IsInGameThread())
+	{
+		PendingPlayObjectSyncs.Add(this);
+		return;
+	}
+
+	// Each object is only touched by one frame job at a time, so bSyncPending needs no lock.
+
+	FScopeLock Lock(&DeferredPlayObjectSyncsLock);
+	DeferredPlayObjectSyncs.Add(this);
+}
+
+
+Daylon::FPlayObjectEntity::FPlayObjectEntity()
+{
+	FPlayObjectStore::GetDefault().Add(*this);
+}
+
+
+Daylon::FPlayObjectEntity::~FPlayObjectEntity()
+{
+	Store->Remove(EntityIndex, false);
+}
+
+
+void Daylon::SyncPlayObjects()
+{
+	check(IsInGameThread());
+
+	{
+		FScopeLock Lock(&DeferredPlayObjectSyncsLock);
+
+		PendingPlayObjectSyncs.Append(DeferredPlayObjectSyncs);
+		DeferredPlayObjectSyncs.Reset();
+	}
+
+	FlushDeferredInvalidations();
+
+	// Objects still being drawn between simulation steps stay queued for the next frame.
+
+	int32 NumKept = 0;
+
+	for(auto PlayObject : PendingPlayObjectSyncs)
+	{
+		if(PlayObject->SyncToWidget())
+		{
+			PendingPlayObjectSyncs[NumKept++] = PlayObject;
+		}
+		else
+		{
+			PlayObject->bSyncPending = false;
+		}
+	}
+
+	PendingPlayObjectSyncs.SetNum(NumKept, false);
+}
+
 
 TSharedPtr<Daylon::ImagePlayObject2D> Daylon::SpawnImagePlayObject2D(const FSlateBrush& Brush, float Radius)
 {
@@ -37,6 +125,19 @@ void Daylon::UninstallImpl(TSharedPtr<SWidget> Widget)
 	Daylon::GetRootCanvas()->GetCanvasWidget()->RemoveSlot(Widget.ToSharedRef());
 }
 
+
+void Daylon::InstallCanvasOverlay(TSharedRef<SWidget> Widget, const FVector2D& Size)
+{
+	Widget->SetVisibility(EVisibility::HitTestInvisible);
+
+	auto SlotArgs = Daylon::GetRootCanvas()->GetCanvasWidget()->AddSlot();
+
+	SlotArgs[Widget];
+	SlotArgs.AutoSize(false);
+	SlotArgs.Alignment(FVector2D(0));
+	SlotArgs.Offset(FMargin(0, 0, Size.X, Size.Y));
+}
+
 #define UNINSTALL_PLAYOBJECT(_Widget)	\
 	if(!_Widget->IsValid())	\
 	{	\
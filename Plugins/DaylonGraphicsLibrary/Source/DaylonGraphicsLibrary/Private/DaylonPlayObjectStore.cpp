@@ -0,0 +1,192 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#include "DaylonPlayObjectStore.h"
+#include "DaylonPlayObject2D.h"
+#include "DaylonLogging.h"
+
+
+// Set to 1 to enable debugging
+#define DEBUG_MODULE                0
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", off)
+#endif
+
+
+// Only touched from the game thread.
+static uint32 SimulationStep      = 0;
+static float  RenderInterpolation = 1.0f;
+
+
+void Daylon::BeginSimulationStep()
+{
+	// Skip zero when wrapping, since that means "not moving".
+	SimulationStep = FMath::Max(1u, SimulationStep + 1);
+}
+
+
+uint32 Daylon::GetSimulationStep()
+{
+	return SimulationStep;
+}
+
+
+void Daylon::SetRenderInterpolation(float Alpha)
+{
+	RenderInterpolation = FMath::Clamp(Alpha, 0.0f, 1.0f);
+}
+
+
+FVector2D Daylon::GetRenderPosition(const FMotionComponent& Motion)
+{
+	// Back up along the step's motion rather than lerping from OldPosition,
+	// so an object that wrapped during the step doesn't slide across the screen.
+
+	if(!Motion.IsMovingThisStep())
+	{
+		return Motion.Position;
+	}
+
+	return Motion.Position - Motion.StepMotion * (1.0f - RenderInterpolation);
+}
+
+
+Daylon::FPlayObjectStore::~FPlayObjectStore()
+{
+	// Play objects can outlive the collection that held them.
+
+	ReleaseAll();
+}
+
+
+Daylon::FPlayObjectStore& Daylon::FPlayObjectStore::GetDefault()
+{
+	// Never destroyed, since widgets can be released after static destructors run.
+
+	static FPlayObjectStore* DefaultStore = new FPlayObjectStore;
+
+	return *DefaultStore;
+}
+
+
+void Daylon::FPlayObjectStore::Reserve(int32 Number)
+{
+	Motion   .Reserve(Number);
+	Collision.Reserve(Number);
+	Lifetime .Reserve(Number);
+	Values   .Reserve(Number);
+	Sprites  .Reserve(Number);
+}
+
+
+void Daylon::FPlayObjectStore::Add(FPlayObjectEntity& Entity)
+{
+	Entity.Store       = this;
+	Entity.EntityIndex = Sprites.Num();
+
+	Motion   .AddDefaulted();
+	Collision.AddDefaulted();
+	Lifetime .AddDefaulted();
+	Values   .AddDefaulted();
+	Sprites  .Add(&Entity);
+}
+
+
+void Daylon::FPlayObjectStore::Remove(int32 Index, bool bKeepOrder)
+{
+	if(bKeepOrder)
+	{
+		Motion   .RemoveAt(Index, 1, false);
+		Collision.RemoveAt(Index, 1, false);
+		Lifetime .RemoveAt(Index, 1, false);
+		Values   .RemoveAt(Index, 1, false);
+		Sprites  .RemoveAt(Index, 1, false);
+
+		for(int32 Later = Index; Later < Sprites.Num(); Later++)
+		{
+			Sprites[Later]->EntityIndex = Later;
+		}
+
+		return;
+	}
+
+	Motion   .RemoveAtSwap(Index, 1, false);
+	Collision.RemoveAtSwap(Index, 1, false);
+	Lifetime .RemoveAtSwap(Index, 1, false);
+	Values   .RemoveAtSwap(Index, 1, false);
+	Sprites  .RemoveAtSwap(Index, 1, false);
+
+	if(Index < Sprites.Num())
+	{
+		// The last entity took over the removed one's index.
+		Sprites[Index]->EntityIndex = Index;
+	}
+}
+
+
+void Daylon::FPlayObjectStore::Transfer(int32 Index, FPlayObjectStore& Dest, bool bKeepOrder)
+{
+	FPlayObjectEntity& Entity = *Sprites[Index];
+
+	const int32 NewIndex = Dest.Sprites.Num();
+
+	Dest.Motion   .Add(Motion   [Index]);
+	Dest.Collision.Add(Collision[Index]);
+	Dest.Lifetime .Add(Lifetime [Index]);
+	Dest.Values   .Add(Values   [Index]);
+	Dest.Sprites  .Add(&Entity);
+
+	Remove(Index, bKeepOrder);
+
+	Entity.Store       = &Dest;
+	Entity.EntityIndex = NewIndex;
+}
+
+
+int32 Daylon::FPlayObjectStore::Adopt(FPlayObjectEntity& Entity)
+{
+	if(Entity.Store != this)
+	{
+		Entity.Store->Transfer(Entity.EntityIndex, *this, false);
+	}
+
+	return Entity.EntityIndex;
+}
+
+
+void Daylon::FPlayObjectStore::Release(int32 Index, bool bKeepOrder)
+{
+	if(!Sprites.IsValidIndex(Index))
+	{
+		UE_LOG(LogDaylon, Error, TEXT("FPlayObjectStore::Release: bad index %d"), Index);
+		return;
+	}
+
+	auto& DefaultStore = GetDefault();
+
+	if(this != &DefaultStore)
+	{
+		Transfer(Index, DefaultStore, bKeepOrder);
+	}
+}
+
+
+void Daylon::FPlayObjectStore::ReleaseAll()
+{
+	if(this == &GetDefault())
+	{
+		return;
+	}
+
+	while(!IsEmpty())
+	{
+		Transfer(Num() - 1, GetDefault(), false);
+	}
+}
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", on)
+#endif
+
+#undef DEBUG_MODULE
@@ -0,0 +1,139 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#include "DaylonQuadBatch.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/SlateRenderer.h"
+
+
+// Set to 1 to enable debugging
+#define DEBUG_MODULE                0
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", off)
+#endif
+
+
+void Daylon::FQuadBatch::Begin(const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FSlateBrush* Brush)
+{
+	Vertices.Reset();
+	Indices .Reset();
+
+	ElementList     = &OutDrawElements;
+	Layer           = LayerId;
+	NumCulled       = 0;
+	RenderTransform = AllottedGeometry.GetAccumulatedRenderTransform();
+
+	// The culling rect is in window space; bring it into local space once instead of
+	// transforming every quad out. Play widgets aren't rotated, so the corners suffice.
+
+	const FVector2D CullMin = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetTopLeft());
+	const FVector2D CullMax = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetBottomRight());
+
+	LocalCullingRect = FSlateRect(
+		FMath::Min(CullMin.X, CullMax.X), FMath::Min(CullMin.Y, CullMax.Y), 
+		FMath::Max(CullMin.X, CullMax.X), FMath::Max(CullMin.Y, CullMax.Y));
+
+	ResourceHandle = (Brush != nullptr ? FSlateApplication::Get().GetRenderer()->GetResourceHandle(*Brush) : FSlateResourceHandle());
+}
+
+
+bool Daylon::FQuadBatch::IsCulled(const FVector2f& Min, const FVector2f& Max) const
+{
+	return (Max.X < LocalCullingRect.Left || Min.X > LocalCullingRect.Right || Max.Y < LocalCullingRect.Top || Min.Y > LocalCullingRect.Bottom);
+}
+
+
+void Daylon::FQuadBatch::AddQuad(const FVector2f Corners[4], const FColor& Color)
+{
+	// Corners go top-left, top-right, bottom-right, bottom-left.
+
+	static const FVector2f UVs[4] = { FVector2f(0, 0), FVector2f(1, 0), FVector2f(1, 1), FVector2f(0, 1) };
+
+	if(Vertices.Num() >= MaxQuadsPerElement * 4)
+	{
+		Flush();
+	}
+
+	const SlateIndex First = (SlateIndex)Vertices.Num();
+
+	for(int32 Corner = 0; Corner < 4; Corner++)
+	{
+		Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, Corners[Corner], UVs[Corner], Color));
+	}
+
+	Indices.Add(First);
+	Indices.Add(First + 1);
+	Indices.Add(First + 2);
+	Indices.Add(First);
+	Indices.Add(First + 2);
+	Indices.Add(First + 3);
+}
+
+
+void Daylon::FQuadBatch::AddBox(const FVector2f& TopLeft, const FVector2f& Size, const FLinearColor& Color)
+{
+	const FVector2f BottomRight = TopLeft + Size;
+
+	if(IsCulled(TopLeft, BottomRight))
+	{
+		NumCulled++;
+		return;
+	}
+
+	const FVector2f Corners[4] = { TopLeft, FVector2f(BottomRight.X, TopLeft.Y), BottomRight, FVector2f(TopLeft.X, BottomRight.Y) };
+
+	AddQuad(Corners, Color.ToFColor(true));
+}
+
+
+void Daylon::FQuadBatch::AddLine(const FVector2f& P1, const FVector2f& P2, float Thickness, const FLinearColor& Color)
+{
+	const float HalfThickness = Thickness / 2;
+
+	const FVector2f Min(FMath::Min(P1.X, P2.X) - HalfThickness, FMath::Min(P1.Y, P2.Y) - HalfThickness);
+	const FVector2f Max(FMath::Max(P1.X, P2.X) + HalfThickness, FMath::Max(P1.Y, P2.Y) + HalfThickness);
+
+	if(IsCulled(Min, Max))
+	{
+		NumCulled++;
+		return;
+	}
+
+	// Widen the segment into a quad along its normal.
+
+	const FVector2f Direction = (P2 - P1).GetSafeNormal();
+	const FVector2f Offset    = FVector2f(-Direction.Y, Direction.X) * HalfThickness;
+
+	const FVector2f Corners[4] = { P1 - Offset, P2 - Offset, P2 + Offset, P1 + Offset };
+
+	AddQuad(Corners, Color.ToFColor(true));
+}
+
+
+void Daylon::FQuadBatch::Flush()
+{
+	check(ElementList != nullptr);
+
+	if(!Indices.IsEmpty())
+	{
+		FSlateDrawElement::MakeCustomVerts(*ElementList, Layer, ResourceHandle, Vertices, Indices, nullptr, 0, 0);
+	}
+
+	Vertices.Reset();
+	Indices .Reset();
+}
+
+
+void Daylon::FQuadBatch::End()
+{
+	Flush();
+
+	ElementList = nullptr;
+}
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", on)
+#endif
+
+#undef DEBUG_MODULE
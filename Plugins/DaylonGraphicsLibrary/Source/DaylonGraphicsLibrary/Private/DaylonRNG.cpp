@@ -4,11 +4,11 @@
 #include "DaylonRange.h"
 
 
-Daylon::MTRand Daylon::Rng;
+Daylon::FRng Daylon::Rng(FPlatformTime::Cycles64());
 
-double Daylon::FRand      () { return Rng.rand(); }
-double Daylon::FRandRange (double Min, double Max) { return (Min + Rng.rand(Max - Min)); }
-int32  Daylon::RandRange  (int32  Min, int32  Max) { return (Min + Rng.randInt(Max - Min)); }
-bool   Daylon::RandBool   () { return (Rng.rand() >= 0.5); }
+double Daylon::FRand      () { return Rng.FRand(); }
+double Daylon::FRandRange (double Min, double Max) { return Rng.FRandRange(Min, Max); }
+int32  Daylon::RandRange  (int32  Min, int32  Max) { return Rng.RandRange(Min, Max); }
+bool   Daylon::RandBool   () { return Rng.RandBool(); }
 
 int32  Daylon::RandRange  (MTRand& R, int32 Min, int32 Max) { return (Min + R.randInt(Max - Min)); }
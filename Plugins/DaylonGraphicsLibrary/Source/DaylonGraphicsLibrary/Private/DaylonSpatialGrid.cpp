@@ -0,0 +1,206 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#include "DaylonSpatialGrid.h"
+#include "DaylonLogging.h"
+
+
+// Set to 1 to enable debugging
+#define DEBUG_MODULE                0
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", off)
+#endif
+
+
+void Daylon::FUniformGrid2D::Init(const FBox2d& InExtent, double InCellSize)
+{
+	check(InExtent.bIsValid);
+	check(InCellSize > 0.0);
+
+	Extent      = InExtent;
+	CellSize    = InCellSize;
+	InvCellSize = 1.0 / InCellSize;
+
+	const FVector2D ExtentSize = Extent.GetSize();
+
+	CellsAcross = FMath::Max(1, FMath::CeilToInt32(ExtentSize.X * InvCellSize));
+	CellsDown   = FMath::Max(1, FMath::CeilToInt32(ExtentSize.Y * InvCellSize));
+
+	Cells.SetNum(CellsAcross * CellsDown);
+
+	Reset();
+}
+
+
+void Daylon::FUniformGrid2D::Reset()
+{
+	// Keep each cell's allocation so rebuilding every frame doesn't churn the heap.
+
+	for(auto& Cell : Cells)
+	{
+		Cell.Reset();
+	}
+
+	Boxes.Reset();
+}
+
+
+Daylon::FUniformGrid2D::FCellRange Daylon::FUniformGrid2D::ComputeCellRange(const FBox2d& Bounds) const
+{
+	FCellRange Range;
+
+	Range.MinX = FMath::Clamp(FMath::FloorToInt32((Bounds.Min.X - Extent.Min.X) * InvCellSize), 0, CellsAcross - 1);
+	Range.MinY = FMath::Clamp(FMath::FloorToInt32((Bounds.Min.Y - Extent.Min.Y) * InvCellSize), 0, CellsDown   - 1);
+	Range.MaxX = FMath::Clamp(FMath::FloorToInt32((Bounds.Max.X - Extent.Min.X) * InvCellSize), 0, CellsAcross - 1);
+	Range.MaxY = FMath::Clamp(FMath::FloorToInt32((Bounds.Max.Y - Extent.Min.Y) * InvCellSize), 0, CellsDown   - 1);
+
+	return Range;
+}
+
+
+void Daylon::FUniformGrid2D::Add(int32 Id, const FBox2d& Bounds, int32 Tag)
+{
+	if(Id == Boxes.Num())
+	{
+		Boxes.AddDefaulted();
+	}
+	else if(Id != Boxes.Num() - 1)
+	{
+		UE_LOG(LogDaylon, Error, TEXT("FUniformGrid2D::Add: id %d is neither the newest nor the next index (%d)"), Id, Boxes.Num());
+		return;
+	}
+
+	FCellBox Box;
+
+	Box.Range = ComputeCellRange(Bounds);
+	Box.Tag   = Tag;
+
+	Boxes[Id].Add(Box);
+
+	const FEntry Entry = { Id, Tag };
+
+	for(int32 Y = Box.Range.MinY; Y <= Box.Range.MaxY; Y++)
+	{
+		for(int32 X = Box.Range.MinX; X <= Box.Range.MaxX; X++)
+		{
+			GetCell(X, Y).Add(Entry);
+		}
+	}
+}
+
+
+void Daylon::FUniformGrid2D::RemoveFromCells(int32 Id)
+{
+	for(const auto& Box : Boxes[Id])
+	{
+		const FEntry Entry = { Id, Box.Tag };
+
+		for(int32 Y = Box.Range.MinY; Y <= Box.Range.MaxY; Y++)
+		{
+			for(int32 X = Box.Range.MinX; X <= Box.Range.MaxX; X++)
+			{
+				GetCell(X, Y).RemoveSingleSwap(Entry, false);
+			}
+		}
+	}
+}
+
+
+void Daylon::FUniformGrid2D::RenameInCells(int32 OldId, int32 NewId)
+{
+	for(const auto& Box : Boxes[OldId])
+	{
+		const FEntry OldEntry = { OldId, Box.Tag };
+
+		for(int32 Y = Box.Range.MinY; Y <= Box.Range.MaxY; Y++)
+		{
+			for(int32 X = Box.Range.MinX; X <= Box.Range.MaxX; X++)
+			{
+				auto& Cell = GetCell(X, Y);
+
+				const int32 Index = Cell.Find(OldEntry);
+
+				if(Index != INDEX_NONE)
+				{
+					Cell[Index].Id = NewId;
+				}
+			}
+		}
+	}
+}
+
+
+void Daylon::FUniformGrid2D::RemoveAtSwap(int32 Id)
+{
+	// Mirror TArray::RemoveAtSwap: the last id takes over the removed one's index.
+
+	if(!Boxes.IsValidIndex(Id))
+	{
+		UE_LOG(LogDaylon, Error, TEXT("FUniformGrid2D::RemoveAtSwap: bad id %d"), Id);
+		return;
+	}
+
+	RemoveFromCells(Id);
+
+	const int32 LastId = Boxes.Num() - 1;
+
+	if(Id != LastId)
+	{
+		RenameInCells(LastId, Id);
+	}
+
+	Boxes.RemoveAtSwap(Id, 1, false);
+}
+
+
+void Daylon::FUniformGrid2D::ForEachEntry(const FBox2d& Bounds, TFunctionRef<void(const FEntry&)> Visitor) const
+{
+	if(Boxes.IsEmpty())
+	{
+		return;
+	}
+
+	const auto Range = ComputeCellRange(Bounds);
+
+	for(int32 Y = Range.MinY; Y <= Range.MaxY; Y++)
+	{
+		for(int32 X = Range.MinX; X <= Range.MaxX; X++)
+		{
+			for(const auto& Entry : GetCell(X, Y))
+			{
+				Visitor(Entry);
+			}
+		}
+	}
+}
+
+
+void Daylon::FUniformGrid2D::Query(const FBox2d& Bounds, TArray<FEntry>& OutEntries) const
+{
+	OutEntries.Reset();
+
+	ForEachEntry(Bounds, [&OutEntries](const FEntry& Entry) { OutEntries.Add(Entry); });
+
+	// Objects spanning several cells show up more than once.
+
+	OutEntries.Sort();
+
+	int32 NumUnique = 0;
+
+	for(int32 Index = 0; Index < OutEntries.Num(); Index++)
+	{
+		if(NumUnique == 0 || !(OutEntries[Index] == OutEntries[NumUnique - 1]))
+		{
+			OutEntries[NumUnique++] = OutEntries[Index];
+		}
+	}
+
+	OutEntries.SetNum(NumUnique, false);
+}
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", on)
+#endif
+
+#undef DEBUG_MODULE
@@ -0,0 +1,152 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#include "DaylonTask.h"
+#include "DaylonLogging.h"
+
+
+// Set to 1 to enable debugging
+#define DEBUG_MODULE                0
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", off)
+#endif
+
+
+void Daylon::FTaskScheduler::Tick(float DeltaTime)
+{
+	Now += DeltaTime;
+
+	// Tasks added by the ones we run get higher IDs; leave them for a later tick.
+	const FScheduledTaskId FirstNewId = NextId;
+
+	while(!Pending.IsEmpty())
+	{
+		const auto& Top = Pending.HeapTop();
+
+		if(Top.Due > Now || Top.Id >= FirstNewId)
+		{
+			break;
+		}
+
+		FPendingTask Task;
+		Pending.HeapPop(Task, FPendingTaskOrder(), false);
+
+		Task.What();
+	}
+
+	for(int32 Index = DurationTasks.Num() - 1; Index >= 0; Index--)
+	{
+		if(!DurationTasks[Index].Tick(DeltaTime))
+		{
+			DurationTasks.RemoveAtSwap(Index);
+		}
+	}
+}
+
+
+Daylon::FScheduledTaskId Daylon::FTaskScheduler::Schedule(float When, FTaskFunction&& What)
+{
+	if(!What)
+	{
+		UE_LOG(LogDaylon, Warning, TEXT("FTaskScheduler::Schedule: task has no function"));
+		return InvalidScheduledTaskId;
+	}
+
+	FPendingTask Task;
+
+	Task.Due  = Now + FMath::Max(0.0f, When);
+	Task.Id   = NextId++;
+	Task.What = MoveTemp(What);
+
+	const FScheduledTaskId Id = Task.Id;
+
+	Pending.HeapPush(MoveTemp(Task), FPendingTaskOrder());
+
+	return Id;
+}
+
+
+bool Daylon::FTaskScheduler::Cancel(FScheduledTaskId Id)
+{
+	if(Id == InvalidScheduledTaskId)
+	{
+		return false;
+	}
+
+	const int32 Index = Pending.IndexOfByPredicate([Id](const FPendingTask& Task) { return Task.Id == Id; });
+
+	if(Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Pending.HeapRemoveAt(Index, FPendingTaskOrder(), false);
+
+	return true;
+}
+
+
+void Daylon::FTaskScheduler::RemoveAll()
+{
+	Pending.Reset();
+	DurationTasks.Reset();
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void Daylon::FCountdown::Set(float Seconds)
+{
+	if(bPaused)
+	{
+		PausedRemaining = Seconds;
+		return;
+	}
+
+	Due = GetNow() + Seconds;
+}
+
+
+float Daylon::FCountdown::Adjust(float Amount)
+{
+	Set(GetRemaining() + Amount);
+
+	return GetRemaining();
+}
+
+
+float Daylon::FCountdown::GetRemaining() const
+{
+	if(bPaused)
+	{
+		return PausedRemaining;
+	}
+
+	return (float)(Due - GetNow());
+}
+
+
+void Daylon::FCountdown::SetPaused(bool bPause)
+{
+	if(bPause == bPaused)
+	{
+		return;
+	}
+
+	if(bPause)
+	{
+		PausedRemaining = GetRemaining();
+	}
+	else
+	{
+		Due = GetNow() + PausedRemaining;
+	}
+
+	bPaused = bPause;
+}
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", on)
+#endif
+
+#undef DEBUG_MODULE
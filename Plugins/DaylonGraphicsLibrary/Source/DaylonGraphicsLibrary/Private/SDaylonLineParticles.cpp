@@ -2,6 +2,8 @@
 
 #include "SDaylonLineParticles.h"
 #include "DaylonGeometry.h"
+#include "DaylonJobGraph.h"
+#include "DaylonParticleKernels.h"
 #include "DaylonRNG.h"
 
 
@@ -24,7 +26,7 @@ void SDaylonLineParticles::Construct(const FArguments& InArgs)
 }
 
 
-void SDaylonLineParticles::Set(const FDaylonLineParticlesParams& Params)
+void SDaylonLineParticles::Set(const FDaylonLineParticlesParams& Params, Daylon::FRng& Rng)
 {
 	MinParticleVelocity = Params.MinParticleVelocity;
 	MaxParticleVelocity = Params.MaxParticleVelocity;
@@ -33,38 +35,82 @@ void SDaylonLineParticles::Set(const FDaylonLineParticlesParams& Params)
 	LineThickness       = Params.LineThickness;
 	FinalOpacity        = Params.FinalOpacity;
 
-	SetParticles(Params.Particles);
+	SetParticles(Params.Particles, Rng);
 }
 
 
-void SDaylonLineParticles::SetParticles(const TArray<FDaylonLineParticle>& InParticles) 
+void SDaylonLineParticles::SetParticles(const TArray<FDaylonLineParticle>& InParticles, Daylon::FRng& Rng) 
 { 
-	Particles = InParticles;
-
-	for(auto& Particle : Particles)
+	const int32 Count = InParticles.Num();
+
+	PositionX            .SetNumUninitialized(Count);
+	PositionY            .SetNumUninitialized(Count);
+	InertiaX             .SetNumUninitialized(Count);
+	InertiaY             .SetNumUninitialized(Count);
+	Lengths              .SetNumUninitialized(Count);
+	Angles               .SetNumUninitialized(Count);
+	Spins                .SetNumUninitialized(Count);
+	Colors               .SetNumUninitialized(Count);
+	LifeRemaining        .SetNumUninitialized(Count);
+	StartingLifeRemaining.SetNumUninitialized(Count);
+
+	for(int32 Index = 0; Index < Count; Index++)
 	{
+		const auto& Particle = InParticles[Index];
+
 		// Make each line segment fly off along its vector to the center with a little random deviation.
-		const auto Angle = Daylon::Vector2DToAngle(Particle.P) + Daylon::FRandRange(-15.0f, 15.0f);
+		const auto Angle = Daylon::Vector2DToAngle(Particle.P) + Rng.FRandRange(-15.0f, 15.0f);
 
-		Particle.Inertia       = /*Daylon::RandVector2D()*/ 
+		const FVector2D Inertia = /*Daylon::RandVector2D()*/ 
 			Daylon::AngleToVector2D(Angle) 
-			* Daylon::FRandRange(MinParticleVelocity, MaxParticleVelocity);
-			
-		Particle.LifeRemaining = Particle.StartingLifeRemaining = Daylon::FRandRange(MinParticleLifetime, MaxParticleLifetime);
+			* Rng.FRandRange(MinParticleVelocity, MaxParticleVelocity);
+
+		PositionX[Index] = Particle.P.X;
+		PositionY[Index] = Particle.P.Y;
+		InertiaX [Index] = Inertia.X;
+		InertiaY [Index] = Inertia.Y;
+		Lengths  [Index] = Particle.Length;
+		Angles   [Index] = Particle.Angle;
+		Spins    [Index] = Particle.Spin;
+		Colors   [Index] = Particle.Color;
+
+		LifeRemaining[Index] = StartingLifeRemaining[Index] = Rng.FRandRange(MinParticleLifetime, MaxParticleLifetime);
 	}
+
+	Invalidate(EInvalidateWidgetReason::Paint);
 }
 
 
 bool SDaylonLineParticles::Update(float DeltaTime)
 {
-	bool Alive = false;
+	const int32 Count = PositionX.Num();
+
+	if(Count == 0)
+	{
+		return false;
+	}
+
+	Daylon::InvalidateWidget(*this, EInvalidateWidgetReason::Paint);
+
+	Daylon::AdvanceAngles(Angles.GetData(), Spins.GetData(), Count, DeltaTime);
+
+	const int32 NumLive = Daylon::IntegrateParticles(PositionX.GetData(), PositionY.GetData(), InertiaX.GetData(), InertiaY.GetData(), LifeRemaining.GetData(), Count, DeltaTime, LiveMask);
 
-	for(auto& Particle : Particles)
+	if(NumLive < Count)
 	{
-		Alive |= Particle.Update(DeltaTime);
+		Daylon::CompactByMask(PositionX,             LiveMask, NumLive);
+		Daylon::CompactByMask(PositionY,             LiveMask, NumLive);
+		Daylon::CompactByMask(InertiaX,              LiveMask, NumLive);
+		Daylon::CompactByMask(InertiaY,              LiveMask, NumLive);
+		Daylon::CompactByMask(Lengths,               LiveMask, NumLive);
+		Daylon::CompactByMask(Angles,                LiveMask, NumLive);
+		Daylon::CompactByMask(Spins,                 LiveMask, NumLive);
+		Daylon::CompactByMask(Colors,                LiveMask, NumLive);
+		Daylon::CompactByMask(LifeRemaining,         LiveMask, NumLive);
+		Daylon::CompactByMask(StartingLifeRemaining, LiveMask, NumLive);
 	}
 
-	return Alive;
+	return (NumLive > 0);
 }
 
 
@@ -79,35 +125,31 @@ int32 SDaylonLineParticles::OnPaint
 	bool                       bParentEnabled
 ) const
 {
-	for(const auto& Particle : Particles)
+	// The line segments go out as one batch of solid quads rather than a line element each.
+
+	// Overdrive starting opacity so that we don't start darkening right away.
+	const float OpacityRange = 1.5f - FinalOpacity;
+
+	QuadBatch.Begin(AllottedGeometry, MyCullingRect, OutDrawElements, LayerId);
+
+	for(int32 Index = 0; Index < PositionX.Num(); Index++)
 	{
-		if(Particle.LifeRemaining <= 0.0f)
+		if(LifeRemaining[Index] <= 0.0f)
 		{
 			continue;
 		}
 
-		// Draw the line particle.
-
-		// Overdrive starting opacity so that we don't start darkening right away.
-		float CurrentOpacity = FMath::Lerp(FinalOpacity, 1.5f, Particle.LifeRemaining / Particle.StartingLifeRemaining);
-		CurrentOpacity = FMath::Min(1.0f, CurrentOpacity);
-
-		FLinearColor Color = Particle.Color;
-		Color.A = CurrentOpacity;
+		FLinearColor Color = Colors[Index];
+		Color.A = FMath::Min(1.0f, FinalOpacity + OpacityRange * LifeRemaining[Index] / StartingLifeRemaining[Index]);
 
-		TArray<FVector2f> Points;
+		const auto AngleVec = UE::Slate::CastToVector2f(Daylon::AngleToVector2D(Angles[Index]) * Lengths[Index] / 2);
+		const FVector2f P(PositionX[Index], PositionY[Index]);
 
-		const auto AngleVec = Daylon::AngleToVector2D(Particle.Angle) * Particle.Length / 2;
-
-		const auto P1 = Particle.P + AngleVec;
-		const auto P2 = Particle.P - AngleVec;
-
-		Points.Add(UE::Slate::CastToVector2f(P1));
-		Points.Add(UE::Slate::CastToVector2f(P2));
-
-		FSlateDrawElement::MakeLines(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), Points, ESlateDrawEffect::None, Color, true, LineThickness);
+		QuadBatch.AddLine(P + AngleVec, P - AngleVec, LineThickness, Color);
 	}
 
+	QuadBatch.End();
+
 	return LayerId;
 }
 
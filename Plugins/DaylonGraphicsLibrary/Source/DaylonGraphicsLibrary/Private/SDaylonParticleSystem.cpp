@@ -0,0 +1,227 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+#include "SDaylonParticleSystem.h"
+#include "DaylonGeometry.h"
+#include "DaylonJobGraph.h"
+#include "DaylonParticleKernels.h"
+#include "DaylonRNG.h"
+#include "DaylonLogging.h"
+
+
+#define DEBUG_MODULE      0
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", off)
+#endif
+
+
+void SDaylonParticleSystem::Construct(const FArguments& InArgs)
+{
+	Size = InArgs._Size.Get();
+}
+
+
+FVector2D SDaylonParticleSystem::ComputeDesiredSize(float) const 
+{
+	return Size; 
+}
+
+
+void SDaylonParticleSystem::SetSize           (const FVector2D& InSize)    { Size = InSize; }
+void SDaylonParticleSystem::SetParticleBrush  (const FSlateBrush& InBrush) { ParticleBrush = InBrush; }
+
+
+void SDaylonParticleSystem::SetCapacity(int32 InMaxParticles, int32 InMaxBursts)
+{
+	check(InMaxParticles > 0 && InMaxBursts > 0);
+
+	MaxParticles = InMaxParticles;
+
+	PositionX            .SetNumUninitialized(MaxParticles);
+	PositionY            .SetNumUninitialized(MaxParticles);
+	InertiaX             .SetNumUninitialized(MaxParticles);
+	InertiaY             .SetNumUninitialized(MaxParticles);
+	ParticleSizes        .SetNumUninitialized(MaxParticles);
+	LifeRemaining        .SetNumUninitialized(MaxParticles);
+	StartingLifeRemaining.SetNumUninitialized(MaxParticles);
+
+	Bursts.SetNumUninitialized(InMaxBursts);
+
+	RemoveAll();
+}
+
+
+void SDaylonParticleSystem::RemoveAll()
+{
+	if(NumBurstsUsed > 0)
+	{
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+
+	Head          = 0;
+	NumUsed       = 0;
+	BurstHead     = 0;
+	NumBurstsUsed = 0;
+}
+
+
+void SDaylonParticleSystem::RemoveOldestBurst()
+{
+	// Bursts sit in the ring back to back in spawn order, so the oldest one's particles start at Head.
+
+	const auto& Burst = GetBurst(0);
+
+	Head     = (Head + Burst.Count) % MaxParticles;
+	NumUsed -= Burst.Count;
+
+	BurstHead = (BurstHead + 1) % Bursts.Num();
+	NumBurstsUsed--;
+}
+
+
+void SDaylonParticleSystem::SpawnBurst(const FVector2D& Origin, const FVector2D& Inertia, const FDaylonParticlesParams& Params, Daylon::FRng& Rng)
+{
+	if(MaxParticles == 0)
+	{
+		UE_LOG(LogDaylon, Error, TEXT("SDaylonParticleSystem::SpawnBurst: SetCapacity was never called"));
+		return;
+	}
+
+	const int32 Count = FMath::Clamp(Params.NumParticles, 0, MaxParticles);
+
+	while(NumBurstsUsed > 0 && (NumUsed + Count > MaxParticles || NumBurstsUsed == Bursts.Num()))
+	{
+		RemoveOldestBurst();
+		NumDropped++;
+	}
+
+	auto& Burst = Bursts[(BurstHead + NumBurstsUsed) % Bursts.Num()];
+	NumBurstsUsed++;
+
+	Burst.Origin        = Origin;
+	Burst.Inertia       = Inertia;
+	Burst.First         = (Head + NumUsed) % MaxParticles;
+	Burst.Count         = Count;
+	Burst.FinalOpacity  = Params.FinalOpacity;
+	Burst.LifeRemaining = 0.0f;
+
+	NumUsed += Count;
+
+	Invalidate(EInvalidateWidgetReason::Paint);
+
+	for(int32 N = 0, Index = Burst.First; N < Count; N++, Index = (Index + 1) % MaxParticles)
+	{
+		// todo: could randomize the starting position a small distance for more realism
+		const FVector2D ParticleInertia = Daylon::RandVector2D(Rng) * Rng.FRandRange(Params.MinParticleVelocity, Params.MaxParticleVelocity);
+
+		PositionX    [Index] = 0.0f;
+		PositionY    [Index] = 0.0f;
+		InertiaX     [Index] = ParticleInertia.X;
+		InertiaY     [Index] = ParticleInertia.Y;
+		ParticleSizes[Index] = Rng.FRandRange(Params.MinParticleSize, Params.MaxParticleSize);
+		LifeRemaining[Index] = StartingLifeRemaining[Index] = Rng.FRandRange(Params.MinParticleLifetime, Params.MaxParticleLifetime);
+
+		Burst.LifeRemaining = FMath::Max(Burst.LifeRemaining, LifeRemaining[Index]);
+	}
+}
+
+
+void SDaylonParticleSystem::IntegrateSpan(int32 First, int32 Count, float DeltaTime)
+{
+	// Burnt-out particles keep integrating; it's cheaper than testing them.
+	// Bursts own fixed ranges of the ring, so nothing is compacted here.
+
+	Daylon::IntegrateParticles(
+		PositionX    .GetData() + First, 
+		PositionY    .GetData() + First, 
+		InertiaX     .GetData() + First, 
+		InertiaY     .GetData() + First, 
+		LifeRemaining.GetData() + First, 
+		Count, 
+		DeltaTime);
+}
+
+
+void SDaylonParticleSystem::UpdateParticles(float DeltaTime)
+{
+	if(NumBurstsUsed == 0)
+	{
+		return;
+	}
+
+	Daylon::InvalidateWidget(*this, EInvalidateWidgetReason::Paint);
+
+	// The occupied part of the ring is at most two contiguous spans.
+
+	const int32 FirstSpan = FMath::Min(NumUsed, MaxParticles - Head);
+
+	IntegrateSpan(Head, FirstSpan,           DeltaTime);
+	IntegrateSpan(0,    NumUsed - FirstSpan, DeltaTime);
+
+	while(NumBurstsUsed > 0 && GetBurst(0).LifeRemaining <= 0.0f)
+	{
+		RemoveOldestBurst();
+	}
+}
+
+
+int32 SDaylonParticleSystem::OnPaint
+(
+	const FPaintArgs&          Args,
+	const FGeometry&           AllottedGeometry,
+	const FSlateRect&          MyCullingRect,
+	FSlateWindowElementList&   OutDrawElements,
+	int32                      LayerId,
+	const FWidgetStyle&        InWidgetStyle,
+	bool                       bParentEnabled
+) const
+{
+	if(NumBurstsUsed == 0 || !IsValid(ParticleBrush.GetResourceObject()))
+	{
+		return LayerId;
+	}
+
+	// Every burst's particles go out as one batch of quads rather than a box element each.
+
+	const FLinearColor Color = ParticleBrush.TintColor.GetSpecifiedColor() * RenderOpacity * InWidgetStyle.GetColorAndOpacityTint().A;
+
+	QuadBatch.Begin(AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, &ParticleBrush);
+
+	for(int32 Age = 0; Age < NumBurstsUsed; Age++)
+	{
+		const auto& Burst = GetBurst(Age);
+
+		if(Burst.LifeRemaining <= 0.0f)
+		{
+			continue;
+		}
+
+		const FVector2f Origin = UE::Slate::CastToVector2f(Burst.Origin);
+
+		// Overdrive starting opacity so that we don't start darkening right away.
+		const float OpacityRange = 1.5f - Burst.FinalOpacity;
+
+		for(int32 N = 0, Index = Burst.First; N < Burst.Count; N++, Index = (Index + 1 == MaxParticles ? 0 : Index + 1))
+		{
+			if(LifeRemaining[Index] <= 0.0f)
+			{
+				continue;
+			}
+
+			const float CurrentOpacity = FMath::Min(1.0f, Burst.FinalOpacity + OpacityRange * LifeRemaining[Index] / StartingLifeRemaining[Index]);
+
+			QuadBatch.AddBox(Origin + FVector2f(PositionX[Index], PositionY[Index]), FVector2f(ParticleSizes[Index]), Color * CurrentOpacity);
+		}
+	}
+
+	QuadBatch.End();
+
+	return LayerId;
+}
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", on)
+#endif
+
+#undef DEBUG_MODULE
@@ -2,6 +2,8 @@
 
 #include "SDaylonParticles.h"
 #include "DaylonGeometry.h"
+#include "DaylonJobGraph.h"
+#include "DaylonParticleKernels.h"
 #include "DaylonRNG.h"
 
 
@@ -47,33 +49,62 @@ void SDaylonParticles::SetFinalOpacity          (float Opacity)              { F
 void SDaylonParticles::SetNumParticles          (int32 Count)             
 {
 	check(Count > 0);
-	Particles.SetNum(Count);
+	NumParticles = Count;
 	Reset();
 }
 
 
 void SDaylonParticles::Reset()
 {
-	for(auto& Particle : Particles)
+	PositionX            .SetNumUninitialized(NumParticles, false);
+	PositionY            .SetNumUninitialized(NumParticles, false);
+	InertiaX             .SetNumUninitialized(NumParticles, false);
+	InertiaY             .SetNumUninitialized(NumParticles, false);
+	ParticleSizes        .SetNumUninitialized(NumParticles, false);
+	LifeRemaining        .SetNumUninitialized(NumParticles, false);
+	StartingLifeRemaining.SetNumUninitialized(NumParticles, false);
+
+	for(int32 Index = 0; Index < NumParticles; Index++)
 	{
-		Particle.P             = FVector2D(0); // todo: could randomize this a small distance for more realism
-		Particle.Size          = Daylon::FRandRange(MinParticleSize, MaxParticleSize);
-		Particle.Inertia       = Daylon::RandVector2D() * Daylon::FRandRange(MinParticleVelocity, MaxParticleVelocity);
-		Particle.LifeRemaining = Particle.StartingLifeRemaining = Daylon::FRandRange(MinParticleLifetime, MaxParticleLifetime);
+		const FVector2D Inertia = Daylon::RandVector2D() * Daylon::FRandRange(MinParticleVelocity, MaxParticleVelocity);
+
+		PositionX    [Index] = 0.0f; // todo: could randomize this a small distance for more realism
+		PositionY    [Index] = 0.0f;
+		InertiaX     [Index] = Inertia.X;
+		InertiaY     [Index] = Inertia.Y;
+		ParticleSizes[Index] = Daylon::FRandRange(MinParticleSize, MaxParticleSize);
+		LifeRemaining[Index] = StartingLifeRemaining[Index] = Daylon::FRandRange(MinParticleLifetime, MaxParticleLifetime);
 	}
+
+	Invalidate(EInvalidateWidgetReason::Paint);
 }
 
 
 bool SDaylonParticles::Update(float DeltaTime)
 {
-	bool Alive = false;
+	const int32 Count   = PositionX.Num();
+
+	if(Count == 0)
+	{
+		return false;
+	}
+
+	Daylon::InvalidateWidget(*this, EInvalidateWidgetReason::Paint);
+
+	const int32 NumLive = Daylon::IntegrateParticles(PositionX.GetData(), PositionY.GetData(), InertiaX.GetData(), InertiaY.GetData(), LifeRemaining.GetData(), Count, DeltaTime, LiveMask);
 
-	for(auto& Particle : Particles)
+	if(NumLive < Count)
 	{
-		Alive |= (Particle.Update(DeltaTime)); 
+		Daylon::CompactByMask(PositionX,             LiveMask, NumLive);
+		Daylon::CompactByMask(PositionY,             LiveMask, NumLive);
+		Daylon::CompactByMask(InertiaX,              LiveMask, NumLive);
+		Daylon::CompactByMask(InertiaY,              LiveMask, NumLive);
+		Daylon::CompactByMask(ParticleSizes,         LiveMask, NumLive);
+		Daylon::CompactByMask(LifeRemaining,         LiveMask, NumLive);
+		Daylon::CompactByMask(StartingLifeRemaining, LiveMask, NumLive);
 	}
 
-	return Alive;
+	return (NumLive > 0);
 }
 
 
@@ -93,33 +124,30 @@ int32 SDaylonParticles::OnPaint
 		return LayerId;
 	}
 
-	for(const auto& Particle : Particles)
+	// All the particles go out as one batch of quads rather than a box element each.
+
+	const FVector2f    Center = UE::Slate::CastToVector2f(AllottedGeometry.GetLocalSize() / 2);
+	const FLinearColor Color  = ParticleBrush.TintColor.GetSpecifiedColor() * RenderOpacity * InWidgetStyle.GetColorAndOpacityTint().A;
+
+	// Overdrive starting opacity so that we don't start darkening right away.
+	const float OpacityRange = 1.5f - FinalOpacity;
+
+	QuadBatch.Begin(AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, &ParticleBrush);
+
+	for(int32 Index = 0; Index < PositionX.Num(); Index++)
 	{
-		if(Particle.LifeRemaining <= 0.0f)
+		if(LifeRemaining[Index] <= 0.0f)
 		{
 			continue;
 		}
 
-		// Draw the particle.
-		
-		const FPaintGeometry PaintGeometry(
-			AllottedGeometry.GetAbsolutePosition() + AllottedGeometry.GetAbsoluteSize() / 2  + (Particle.P * AllottedGeometry.Scale) + 0.5f, 
-			FVector2D(Particle.Size) * AllottedGeometry.Scale,
-			1.0f);
-
-		// Overdrive starting opacity so that we don't start darkening right away.
-		float CurrentOpacity = FMath::Lerp(FinalOpacity, 1.5f, Particle.LifeRemaining / Particle.StartingLifeRemaining);
-		CurrentOpacity = FMath::Min(1.0f, CurrentOpacity);
-
-		FSlateDrawElement::MakeBox(
-			OutDrawElements,
-			LayerId,
-			PaintGeometry,
-			&ParticleBrush,
-			ESlateDrawEffect::None,
-			ParticleBrush.TintColor.GetSpecifiedColor() * RenderOpacity * CurrentOpacity * InWidgetStyle.GetColorAndOpacityTint().A);
+		const float CurrentOpacity = FMath::Min(1.0f, FinalOpacity + OpacityRange * LifeRemaining[Index] / StartingLifeRemaining[Index]);
+
+		QuadBatch.AddBox(Center + FVector2f(PositionX[Index], PositionY[Index]), FVector2f(ParticleSizes[Index]), Color * CurrentOpacity);
 	}
 
+	QuadBatch.End();
+
 	return LayerId;
 }
 
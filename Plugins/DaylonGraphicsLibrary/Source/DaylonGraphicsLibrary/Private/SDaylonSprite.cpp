@@ -2,6 +2,7 @@
 
 #include "SDaylonSprite.h"
 #include "DaylonGeometry.h"
+#include "DaylonJobGraph.h"
 #include "DaylonLogging.h"
 
 
@@ -87,6 +88,47 @@ FBox2d FDaylonSpriteAtlas::GetUVsForCel(int32 CelX, int32 CelY) const
 // --------------------------------------------------------------------------------------
 
 
+const FBox2d FDaylonSharedSpriteAtlas::EmptyUVs = FBox2d(FVector2D(0), FVector2D(0));
+
+
+TSharedRef<const FDaylonSharedSpriteAtlas> FDaylonSharedSpriteAtlas::Create(const FDaylonSpriteAtlas& InAtlas, UObject* PackedResource, const TArray<FBox2d>* PackedCelUVs)
+{
+	auto SharedAtlas = MakeShared<FDaylonSharedSpriteAtlas>();
+
+	static_cast<FDaylonSpriteAtlas&>(SharedAtlas.Get()) = InAtlas;
+
+	SharedAtlas->InitCache();
+	SharedAtlas->PaintBrush = SharedAtlas->AtlasBrush;
+
+	if(PackedResource != nullptr)
+	{
+		if(PackedCelUVs == nullptr || PackedCelUVs->Num() != SharedAtlas->NumCels)
+		{
+			UE_LOG(LogDaylon, Error, TEXT("FDaylonSharedSpriteAtlas::Create: packed atlas needs %d cel UVs"), SharedAtlas->NumCels);
+		}
+		else
+		{
+			SharedAtlas->PaintBrush.SetResourceObject(PackedResource);
+			SharedAtlas->CelUVs = *PackedCelUVs;
+
+			return SharedAtlas;
+		}
+	}
+
+	SharedAtlas->CelUVs.Reserve(SharedAtlas->NumCels);
+
+	for(int32 Index = 0; Index < SharedAtlas->NumCels; Index++)
+	{
+		SharedAtlas->CelUVs.Add(SharedAtlas->FDaylonSpriteAtlas::GetUVsForCel(Index));
+	}
+
+	return SharedAtlas;
+}
+
+
+// --------------------------------------------------------------------------------------
+
+
 void SDaylonSprite::Construct(const FArguments& InArgs)
 {
 	Size = InArgs._Size.Get();
@@ -101,17 +143,36 @@ FVector2D SDaylonSprite::ComputeDesiredSize(float) const
 
 void SDaylonSprite::SetSize(const FVector2D& InSize)
 {
-	Size = InSize; 
+	if(Size != InSize)
+	{
+		Size = InSize; 
+		Invalidate(EInvalidateWidgetReason::Layout);
+	}
+}
+
+
+void SDaylonSprite::SetTint(const FLinearColor& Color)
+{
+	if(Tint != Color)
+	{
+		Tint = Color;
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
 }
 
 
-void SDaylonSprite::SetAtlas(const FDaylonSpriteAtlas& InAtlas) 
+void SDaylonSprite::SetAtlas(const FDaylonSpriteAtlasHandle& InAtlas) 
 {
 	Atlas = InAtlas;
 
-	Atlas.InitCache();
-
 	Reset();
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+
+void SDaylonSprite::SetAtlas(const FDaylonSpriteAtlas& InAtlas) 
+{
+	SetAtlas(FDaylonSharedSpriteAtlas::Create(InAtlas));
 }
 
 
@@ -125,36 +186,44 @@ void SDaylonSprite::Reset()
 
 void SDaylonSprite::SetCurrentCel(int32 Index)
 {
-	if(!Atlas.IsValidCelIndex(Index))
+	if(!Atlas.IsValid() || !Atlas->IsValidCelIndex(Index) || Index == CurrentCelIndex)
 	{
 		return;
 	}
 
 	CurrentCelIndex = Index;
+
+	// Sprites are animated by Update(), which can run in a worker frame job.
+	Daylon::InvalidateWidget(*this, EInvalidateWidgetReason::Paint);
 }
 
 
 void SDaylonSprite::SetCurrentCel(int32 CelX, int32 CelY)
 {
-	return SetCurrentCel(Atlas.CalcCelIndex(CelX, CelY));
+	if(!Atlas.IsValid())
+	{
+		return;
+	}
+
+	return SetCurrentCel(Atlas->CalcCelIndex(CelX, CelY));
 }
 
 
 void SDaylonSprite::Update(float DeltaTime)
 {
-	if(IsStatic)
+	if(IsStatic || !Atlas.IsValid())
 	{
 		return;
 	}
 
 	// See if we need to change the current cel.
 
-	const int32 NumLogicalCels  = Atlas.LogToPhysCelIndices.Num();
-	const float SecondsPerFrame = (1.0f / Atlas.FrameRate); 
+	const int32 NumLogicalCels  = Atlas->LogToPhysCelIndices.Num();
+	const float SecondsPerFrame = (1.0f / Atlas->FrameRate); 
 	
 	// Determine the next absolute cel index as if we were always going forwards.
 	const int32 NextLogicalCelIndex = (FMath::RoundToInt(CurrentAge / SecondsPerFrame)) % NumLogicalCels;
-	SetCurrentCel(Atlas.LogToPhysCelIndices[NextLogicalCelIndex]);
+	SetCurrentCel(Atlas->LogToPhysCelIndices[NextLogicalCelIndex]);
 
 	CurrentAge += DeltaTime;
 
@@ -164,7 +233,7 @@ void SDaylonSprite::Update(float DeltaTime)
 
 	while(CurrentAge > AnimDuration)
 	{
-		CurrentAge -= NumLogicalCels / Atlas.FrameRate;
+		CurrentAge -= NumLogicalCels / Atlas->FrameRate;
 	}
 
 	//UE_LOG(LogSlate, Log, TEXT("sprite widget::update: currentage = %.3f, currentcelindex = %d"), CurrentAge, CurrentCelIndex);
@@ -182,12 +251,12 @@ int32 SDaylonSprite::OnPaint
 	bool                       bParentEnabled
 ) const
 {
-	if(!IsValid(Atlas.AtlasBrush.GetResourceObject()))
+	if(!Atlas.IsValid() || !IsValid(Atlas->PaintBrush.GetResourceObject()))
 	{
 		return LayerId;
 	}
 
-	FBox2D uvRegion = Atlas.GetUVsForCel(CurrentCelIndex);
+	FBox2D uvRegion = Atlas->GetUVsForCel(CurrentCelIndex);
 
 	if(FlipHorizontal)
 	{
@@ -198,7 +267,7 @@ int32 SDaylonSprite::OnPaint
 		Swap(uvRegion.Min.Y, uvRegion.Max.Y);
 	}
 
-	Atlas.AtlasBrush.SetUVRegion(uvRegion);
+	Atlas->PaintBrush.SetUVRegion(uvRegion);
 
 	if(AllottedGeometry.HasRenderTransform())
 	{
@@ -206,9 +275,9 @@ int32 SDaylonSprite::OnPaint
 			OutDrawElements,
 			LayerId,
 			AllottedGeometry.ToPaintGeometry(),
-			&Atlas.AtlasBrush,
+			&Atlas->PaintBrush,
 			ESlateDrawEffect::None,
-			Atlas.AtlasBrush.TintColor.GetSpecifiedColor() * Tint * RenderOpacity * InWidgetStyle.GetColorAndOpacityTint().A);
+			Atlas->PaintBrush.TintColor.GetSpecifiedColor() * Tint * RenderOpacity * InWidgetStyle.GetColorAndOpacityTint().A);
 	}
 	else
 	{
@@ -219,9 +288,9 @@ int32 SDaylonSprite::OnPaint
 			OutDrawElements,
 			LayerId,
 			PaintGeometry,
-			&Atlas.AtlasBrush,
+			&Atlas->PaintBrush,
 			ESlateDrawEffect::None,
-			Atlas.AtlasBrush.TintColor.GetSpecifiedColor() * Tint * RenderOpacity * InWidgetStyle.GetColorAndOpacityTint().A);
+			Atlas->PaintBrush.TintColor.GetSpecifiedColor() * Tint * RenderOpacity * InWidgetStyle.GetColorAndOpacityTint().A);
 	}
 
 #if 0
@@ -233,7 +302,7 @@ int32 SDaylonSprite::OnPaint
 			OutDrawElements,
 			LayerId,
 			PaintGeometry2,
-			&Atlas.AtlasBrush,
+			&Atlas->PaintBrush,
 			ESlateDrawEffect::None,
 			Red * RenderOpacity * InWidgetStyle.GetColorAndOpacityTint().A);
 	}
@@ -267,7 +336,11 @@ FVector2D SDaylonPolyShield::ComputeDesiredSize(float) const
 
 void SDaylonPolyShield::SetSize(const FVector2D& InSize)
 {
-	Size = InSize; 
+	if(Size != InSize)
+	{
+		Size = InSize; 
+		Invalidate(EInvalidateWidgetReason::Layout);
+	}
 }
 
 
@@ -284,6 +357,8 @@ void SDaylonPolyShield::Reset()
 		Health = 1.0f;
 		//Health = (1.0f / NumSides) * N++;
 	}
+
+	Invalidate(EInvalidateWidgetReason::Paint);
 }
 
 
@@ -295,6 +370,13 @@ void SDaylonPolyShield::Update(float DeltaTime)
 	{
 		CurrentAge -= 1000.f;
 	}
+
+	// Age only shows as spin.
+
+	if(SpinSpeed != 0.0f)
+	{
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
 }
 
 
@@ -357,12 +439,13 @@ void SDaylonPolyShield::SetSegmentHealth(int32 Index, float Health)
 {
 	// UE_LOG(LogDaylon, Log, TEXT("SetSegmentHealth: Index = %d"), Index);
 
-	if(!SegmentHealth.IsValidIndex(Index))
+	if(!SegmentHealth.IsValidIndex(Index) || SegmentHealth[Index] == Health)
 	{
 		return;
 	}
 
 	SegmentHealth[Index] = Health;
+	Invalidate(EInvalidateWidgetReason::Paint);
 }
 
 
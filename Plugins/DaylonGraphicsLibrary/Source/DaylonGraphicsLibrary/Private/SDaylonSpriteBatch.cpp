@@ -0,0 +1,102 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+#include "SDaylonSpriteBatch.h"
+#include "DaylonGeometry.h"
+
+
+#define DEBUG_MODULE      0
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", off)
+#endif
+
+
+void SDaylonSpriteBatch::Construct(const FArguments& InArgs)
+{
+	Size = InArgs._Size.Get();
+}
+
+
+FVector2D SDaylonSpriteBatch::ComputeDesiredSize(float) const 
+{
+	return Size; 
+}
+
+
+void SDaylonSpriteBatch::SetSize(const FVector2D& InSize)
+{
+	Size = InSize; 
+}
+
+
+void SDaylonSpriteBatch::Commit()
+{
+	if(Instances == PaintedInstances)
+	{
+		return;
+	}
+
+	// Trade arrays instead of copying; Reset() empties the old one for reuse.
+
+	Swap(Instances, PaintedInstances);
+
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+
+int32 SDaylonSpriteBatch::OnPaint
+(
+	const FPaintArgs&          Args,
+	const FGeometry&           AllottedGeometry,
+	const FSlateRect&          MyCullingRect,
+	FSlateWindowElementList&   OutDrawElements,
+	int32                      LayerId,
+	const FWidgetStyle&        InWidgetStyle,
+	bool                       bParentEnabled
+) const
+{
+	if(PaintedInstances.IsEmpty() || !Atlas.IsValid() || !IsValid(Atlas->PaintBrush.GetResourceObject()))
+	{
+		return LayerId;
+	}
+
+	// MakeBox copies the brush's UV region into each element, so one brush serves every instance.
+
+	const FLinearColor BatchTint = Atlas->PaintBrush.TintColor.GetSpecifiedColor() * RenderOpacity * InWidgetStyle.GetColorAndOpacityTint().A;
+
+	for(const auto& Instance : PaintedInstances)
+	{
+		FBox2D uvRegion = Atlas->GetUVsForCel(Instance.Cel);
+
+		if(Instance.FlipHorizontal)
+		{
+			Swap(uvRegion.Min.X, uvRegion.Max.X);
+		}
+		if(Instance.FlipVertical)
+		{
+			Swap(uvRegion.Min.Y, uvRegion.Max.Y);
+		}
+
+		Atlas->PaintBrush.SetUVRegion(uvRegion);
+
+		const FSlateLayoutTransform  Placement (Instance.Position - Instance.Size / 2);
+		const FSlateRenderTransform  Rotation  (FQuat2D(FMath::DegreesToRadians(Instance.Angle)));
+
+		FSlateDrawElement::MakeBox(
+			OutDrawElements,
+			LayerId,
+			AllottedGeometry.MakeChild(Instance.Size, Placement, Rotation, FVector2D(0.5f)).ToPaintGeometry(),
+			&Atlas->PaintBrush,
+			ESlateDrawEffect::None,
+			BatchTint * Instance.Tint);
+	}
+
+	return LayerId;
+}
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", on)
+#endif
+
+#undef DEBUG_MODULE
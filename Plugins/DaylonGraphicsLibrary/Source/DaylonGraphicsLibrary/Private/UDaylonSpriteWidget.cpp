@@ -1,6 +1,29 @@
 // Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
 
 #include "UDaylonSpriteWidget.h"
+#include "DaylonLogging.h"
+#include "Engine/Texture2D.h"
+
+
+void UDaylonSpriteWidgetAtlas::Build()
+{
+	Atlas.InitCache();
+
+	if(PackedTexture != nullptr)
+	{
+		if(PackedCelUVs.Num() == Atlas.NumCels)
+		{
+			Handle = FDaylonSharedSpriteAtlas::Create(Atlas, PackedTexture, &PackedCelUVs);
+			return;
+		}
+
+		// The atlas was edited since it was packed; draw from its own texture until it's packed again.
+
+		UE_LOG(LogDaylon, Warning, TEXT("%s: packing is out of date (%d cel UVs for %d cels), not using it"), *GetName(), PackedCelUVs.Num(), Atlas.NumCels);
+	}
+
+	Handle = FDaylonSharedSpriteAtlas::Create(Atlas);
+}
 
 #if WITH_EDITOR
 const FText UDaylonSpriteWidget::GetPaletteCategory()
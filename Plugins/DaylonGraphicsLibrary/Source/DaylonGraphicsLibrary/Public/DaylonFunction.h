@@ -0,0 +1,187 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <type_traits>
+
+
+namespace Daylon
+{
+	class DAYLONGRAPHICSLIBRARY_API FCaptureBlockPool
+	{
+		// Fixed-size blocks for callables too big for a TInlineFunction's inline storage.
+		// Freed blocks go on a free list and get handed out again, so once the pool has grown
+		// to the most oversized callables alive at once it stops allocating.
+		// Blocks are never returned to the system. Safe to use from any thread.
+
+		public:
+
+			static constexpr SIZE_T  BlockSize      = 512;
+			static constexpr SIZE_T  BlockAlignment = 16;
+
+			static void*  Allocate      ();
+			static void   Free          (void* Block);
+			static int32  GetNumBlocks  ();   // Handed out plus free
+	};
+
+	// ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+	template <typename Signature, SIZE_T InlineSize = 96>
+	class TInlineFunction;
+
+
+	template <typename ReturnType, typename... ArgTypes, SIZE_T InlineSize>
+	class TInlineFunction<ReturnType(ArgTypes...), InlineSize>
+	{
+		// A move-only stand-in for TFunction that keeps the callable inside itself instead of
+		// on the heap. Callables bigger than InlineSize bytes go in a FCaptureBlockPool block;
+		// ones bigger than a block don't compile. To make sure a callable never leaves inline
+		// storage, static_assert on FitsInline<decltype(Lambda)>().
+		//
+		// Nothing points into the object itself, so it can be moved around bitwise by TArray.
+
+		public:
+
+			template <typename FunctorType>
+			static constexpr bool FitsInline() { return (sizeof(FunctorType) <= InlineSize && alignof(FunctorType) <= Alignment); }
+
+
+			TInlineFunction() {}
+			TInlineFunction(TYPE_OF_NULLPTR) {}
+
+			template <typename FunctorType, typename = std::enable_if_t<!std::is_same_v<std::decay_t<FunctorType>, TInlineFunction>>>
+			TInlineFunction(FunctorType&& Functor)
+			{
+				typedef std::decay_t<FunctorType> FStoredType;
+
+				static_assert(sizeof(FStoredType)  <= FCaptureBlockPool::BlockSize,      "Callable is too big for a TInlineFunction; capture less, or capture a pointer to the data");
+				static_assert(alignof(FStoredType) <= FCaptureBlockPool::BlockAlignment, "Callable is overaligned for a TInlineFunction");
+
+				bInline = FitsInline<FStoredType>();
+
+				if(!bInline)
+				{
+					Storage.Block = FCaptureBlockPool::Allocate();
+				}
+
+				new (GetObject()) FStoredType(Forward<FunctorType>(Functor));
+
+				Ops = &TOps<FStoredType>::Table;
+			}
+
+			TInlineFunction(TInlineFunction&& Other) { MoveFrom(Other); }
+
+			TInlineFunction(const TInlineFunction&) = delete;
+			TInlineFunction& operator = (const TInlineFunction&) = delete;
+
+			~TInlineFunction() { Reset(); }
+
+
+			TInlineFunction& operator = (TInlineFunction&& Other)
+			{
+				if(&Other != this)
+				{
+					Reset();
+					MoveFrom(Other);
+				}
+
+				return *this;
+			}
+
+			template <typename FunctorType, typename = std::enable_if_t<!std::is_same_v<std::decay_t<FunctorType>, TInlineFunction>>>
+			TInlineFunction& operator = (FunctorType&& Functor)
+			{
+				return (*this = TInlineFunction(Forward<FunctorType>(Functor)));
+			}
+
+
+			ReturnType operator () (ArgTypes... Args) const
+			{
+				check(Ops != nullptr);
+
+				return Ops->Invoke(const_cast<TInlineFunction*>(this)->GetObject(), Forward<ArgTypes>(Args)...);
+			}
+
+			explicit operator bool () const { return (Ops != nullptr); }
+
+			bool IsInline() const { return bInline; }
+
+
+			void Reset()
+			{
+				if(Ops == nullptr)
+				{
+					return;
+				}
+
+				Ops->Destroy(GetObject());
+
+				if(!bInline)
+				{
+					FCaptureBlockPool::Free(Storage.Block);
+				}
+
+				Ops     = nullptr;
+				bInline = true;
+			}
+
+
+		protected:
+
+			static constexpr SIZE_T Alignment = 16;
+
+			struct FOps
+			{
+				ReturnType  (*Invoke)  (void* Object, ArgTypes&&... Args);
+				void        (*Move)    (void* Dest, void* Source);   // Also destroys Source
+				void        (*Destroy) (void* Object);
+			};
+
+			template <typename FunctorType>
+			struct TOps
+			{
+				static ReturnType Invoke  (void* Object, ArgTypes&&... Args) { return (*(FunctorType*)Object)(Forward<ArgTypes>(Args)...); }
+				static void       Move    (void* Dest, void* Source)         { new (Dest) FunctorType(MoveTemp(*(FunctorType*)Source)); ((FunctorType*)Source)->~FunctorType(); }
+				static void       Destroy (void* Object)                     { ((FunctorType*)Object)->~FunctorType(); }
+
+				static constexpr FOps Table = { &Invoke, &Move, &Destroy };
+			};
+
+			union alignas(Alignment) FStorage
+			{
+				uint8  Bytes[InlineSize];
+				void*  Block;
+			};
+
+			FStorage     Storage;
+			const FOps*  Ops     = nullptr;
+			bool         bInline = true;
+
+
+			void* GetObject() { return (bInline ? (void*)Storage.Bytes : Storage.Block); }
+
+			void MoveFrom(TInlineFunction& Other)
+			{
+				if(Other.Ops == nullptr)
+				{
+					return;
+				}
+
+				if(Other.bInline)
+				{
+					Other.Ops->Move(Storage.Bytes, Other.Storage.Bytes);
+				}
+				else
+				{
+					Storage.Block = Other.Storage.Block;
+				}
+
+				Ops     = Other.Ops;
+				bInline = Other.bInline;
+
+				Other.Ops     = nullptr;
+				Other.bInline = true;
+			}
+	};
+}
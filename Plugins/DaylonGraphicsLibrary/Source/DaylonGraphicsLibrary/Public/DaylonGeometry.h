@@ -8,6 +8,8 @@
 
 namespace Daylon
 {
+	class FRng;
+
 	extern const double Epsilon;
 
 	DAYLONGRAPHICSLIBRARY_API FORCEINLINE double Square (double x) { return x * x; }
@@ -20,12 +22,97 @@ namespace Daylon
 	DAYLONGRAPHICSLIBRARY_API float         WrapAngle                         (float Angle);
 	DAYLONGRAPHICSLIBRARY_API float         Normalize                         (float N, float Min, float Max);
 
+	// The intersection tests keep no state and can be called from worker threads.
 	DAYLONGRAPHICSLIBRARY_API bool          DoesPointIntersectCircle          (const FVector2D& P, const FVector2D& CP, double R);
 	DAYLONGRAPHICSLIBRARY_API bool          DoesLineSegmentIntersectCircle    (const FVector2D& P1, const FVector2D& P2, const FVector2D& CP, double R);
 	DAYLONGRAPHICSLIBRARY_API bool          DoesLineSegmentIntersectTriangle  (const FVector2D& P1, const FVector2D& P2, const FVector2D Triangle[3]);
 	DAYLONGRAPHICSLIBRARY_API bool          DoTrianglesIntersect              (const FVector2D TriA[3], const FVector2D TriB[3]);
 	DAYLONGRAPHICSLIBRARY_API bool          DoCirclesIntersect                (const FVector2D& C1, float R1, const FVector2D& C2, float R2);
+	DAYLONGRAPHICSLIBRARY_API bool          DoesLineSegmentIntersectCircleFast(const FVector2D& P1, const FVector2D& P2, const FVector2D& CP, double R);
 	DAYLONGRAPHICSLIBRARY_API FVector2D     RandomPtWithinBox                 (const FBox2d& Box);
 	DAYLONGRAPHICSLIBRARY_API FVector2D     ComputeFiringSolution             (const FVector2D& LaunchP, float TorpedoSpeed, const FVector2D& TargetP, const FVector2D& TargetInertia);
 	DAYLONGRAPHICSLIBRARY_API void          ComputeCollisionInertia           (float Mass1, float Mass2, float Restitution,	const FVector2D& P1, const FVector2D& P2, FVector2D& Inertia1, FVector2D& Inertia2);
+
+	// The random routines above draw from Daylon::Rng; these draw from the given stream instead.
+	DAYLONGRAPHICSLIBRARY_API FVector2D     RandVector2D                      (FRng& Rng);
+	DAYLONGRAPHICSLIBRARY_API FVector2D     DeviateVector                     (FRng& Rng, const FVector2D& VectorOld, float MinDeviation, float MaxDeviation);
+	DAYLONGRAPHICSLIBRARY_API FVector2D     RandomPtWithinBox                 (FRng& Rng, const FBox2d& Box);
+	DAYLONGRAPHICSLIBRARY_API FVector2D     ComputeFiringSolution             (FRng& Rng, const FVector2D& LaunchP, float TorpedoSpeed, const FVector2D& TargetP, const FVector2D& TargetInertia);
+
+
+	// Circles stored as a structure of arrays, for testing many circles in one pass.
+	struct FCircleArray
+	{
+		TArray<double> X;
+		TArray<double> Y;
+		TArray<double> Radius;
+
+		int32 Num   () const { return X.Num(); }
+		void  Reset () { X.Reset(); Y.Reset(); Radius.Reset(); }
+		void  Add   (const FVector2D& P, double R) { X.Add(P.X); Y.Add(P.Y); Radius.Add(R); }
+	};
+
+	// Tests one line segment against every circle using SIMD, four circles at a time.
+	// Sets bit N of OutHitMask if the segment touches circle N and returns the number of hits.
+	// No square roots are needed. Touching counts: a tangent or an endpoint exactly on the circle
+	// is a hit, as in DoesLineSegmentIntersectCircle, but a zero-length segment has to be strictly
+	// inside, as in DoesPointIntersectCircle. Results match DoesLineSegmentIntersectCircle whenever
+	// an endpoint is inside the circle. When neither is, its root test's tolerance is too tight for
+	// playfield coordinates, and it can miss crossings and touches that this (and
+	// DoesLineSegmentIntersectCircleFast) reports.
+	DAYLONGRAPHICSLIBRARY_API int32         DoesLineSegmentIntersectCircles   (const FVector2D& P1, const FVector2D& P2, const FCircleArray& Circles, TBitArray<>& OutHitMask);
+
+
+	// Wraparound playfields span (0,0) to WrapSize, and an object whose bounds poke past an edge
+	// also shows up on the opposite side(s) as a "ghost". GetWrapGhostDirections returns how many
+	// ghosts there are (0 to 3) and, for each, which way it is displaced in units of WrapSize.
+	// GetWrapOffsets returns the translations to add to a target object so it can be tested
+	// against another object across the wrap seams; the first one is always zero, and others
+	// only exist if either object is in the edge band.
+
+	const int32 MaxWrapGhosts  = 3;
+	const int32 MaxWrapOffsets = (MaxWrapGhosts + 1) * (MaxWrapGhosts + 1);
+
+	DAYLONGRAPHICSLIBRARY_API int32         GetWrapGhostDirections            (const FBox2d& Bounds, const FVector2D& WrapSize, FIntPoint OutDirections[MaxWrapGhosts]);
+	DAYLONGRAPHICSLIBRARY_API int32         GetWrapOffsets                    (const FBox2d& TargetBounds, const FBox2d& OtherBounds, const FVector2D& WrapSize, FVector2D OutOffsets[MaxWrapOffsets]);
+
+
+	// Wraps a coordinate into 0..Size with a floor instead of FMath::Wrap's compare-and-add loops,
+	// so there are no branches and an object any number of playfields away lands in one step.
+	FORCEINLINE double     WrapCoord    (double V, double Size)                         { return V - Size * FMath::FloorToDouble(V / Size); }
+	FORCEINLINE FVector2D  WrapPosition (const FVector2D& P, const FVector2D& WrapSize) { return FVector2D(WrapCoord(P.X, WrapSize.X), WrapCoord(P.Y, WrapSize.Y)); }
+
+
+	// Wrap policies for PlayObject2D::Move. Each maps an object's unwrapped new position to
+	// the position it should take. Move is templated on the policy, so the call is inlined
+	// into movement loops instead of going through a TFunction per object.
+
+	struct FToroidalWrap
+	{
+		// Leaving one edge of a (0,0) to WrapSize playfield comes back in on the opposite edge.
+
+		FVector2D WrapSize;
+
+		explicit FToroidalWrap(const FVector2D& InWrapSize) : WrapSize(InWrapSize) {}
+
+		FVector2D operator () (const FVector2D& P) const { return WrapPosition(P, WrapSize); }
+	};
+
+
+	struct FClampWrap
+	{
+		// Objects stop at the edges of a (0,0) to Size playfield.
+
+		FVector2D Size;
+
+		explicit FClampWrap(const FVector2D& InSize) : Size(InSize) {}
+
+		FVector2D operator () (const FVector2D& P) const { return FVector2D(FMath::Clamp(P.X, 0.0, Size.X), FMath::Clamp(P.Y, 0.0, Size.Y)); }
+	};
+
+
+	struct FNoWrap
+	{
+		FVector2D operator () (const FVector2D& P) const { return P; }
+	};
 }
@@ -0,0 +1,78 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/InvalidateWidgetReason.h"
+#include "DaylonFunction.h"
+
+
+class SWidget;
+
+
+namespace Daylon
+{
+	// One bit per piece of data that frame jobs read or write. The game decides what the bits mean.
+	typedef uint32 FJobDataMask;
+
+
+	class DAYLONGRAPHICSLIBRARY_API FJobGraph
+	{
+		// Runs a handful of jobs, some on the game thread and the rest on task graph workers,
+		// with the same result as running them one after another in the order they were added.
+		//
+		// Each job declares the data it reads and writes. A job waits for every earlier job that
+		// writes something it reads or writes, or reads something it writes; jobs whose data
+		// doesn't overlap run at the same time. Game thread jobs run inside Run(), in order,
+		// as soon as their prerequisites finish, while the worker jobs that don't wait on them
+		// are already going. Run() returns when every job is done.
+		//
+		// Worker jobs mustn't touch Slate. Play objects they move are queued for SyncPlayObjects()
+		// as usual, and widgets they change should be invalidated with Daylon::InvalidateWidget().
+
+		public:
+
+			typedef TInlineFunction<void()> FJobFunction;
+
+			// Jobs hold move-only callables, so an exported (and thus fully
+			// instantiated) copy constructor wouldn't compile.
+			FJobGraph() {}
+			FJobGraph(const FJobGraph&) = delete;
+			FJobGraph& operator = (const FJobGraph&) = delete;
+			FJobGraph(FJobGraph&&) = default;
+			FJobGraph& operator = (FJobGraph&&) = default;
+
+			void   Reset   () { Jobs.Reset(); }
+
+			void   Add     (const TCHAR* Name, FJobDataMask Reads, FJobDataMask Writes, bool bGameThread, FJobFunction&& Work);
+
+			// With bParallel false, runs every job on the calling thread in the order added.
+			void   Run     (bool bParallel = true);
+
+			int32  Num     () const { return Jobs.Num(); }
+
+
+		protected:
+
+			struct FJob
+			{
+				const TCHAR*  Name        = nullptr;
+				FJobDataMask  Reads       = 0;
+				FJobDataMask  Writes      = 0;
+				bool          bGameThread = false;
+				FJobFunction  Work;
+			};
+
+			TArray<FJob>  Jobs;
+
+			bool DependsOn(int32 Job, int32 EarlierJob) const;
+	};
+
+
+	// Invalidates the widget right away on the game thread. From other threads (e.g. worker frame jobs),
+	// which can't touch Slate, the invalidation is queued until the next SyncPlayObjects().
+	DAYLONGRAPHICSLIBRARY_API void InvalidateWidget(SWidget& Widget, EInvalidateWidgetReason Reason);
+
+	// Applies queued invalidations. SyncPlayObjects() calls this.
+	DAYLONGRAPHICSLIBRARY_API void FlushDeferredInvalidations();
+}
@@ -0,0 +1,45 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+namespace Daylon
+{
+	// SIMD kernels for particles stored as a structure of arrays (one float array per field).
+	// They work four particles at a time, with a scalar loop for any leftovers.
+
+	// Moves particles along their inertias and counts down their lifetimes.
+	DAYLONGRAPHICSLIBRARY_API void   IntegrateParticles   (float* X, float* Y, const float* InertiaX, const float* InertiaY, float* LifeRemaining, int32 Count, float DeltaTime);
+
+	// Same, but also sets bit N of OutLiveMask if particle N still has life remaining, and returns how many do.
+	DAYLONGRAPHICSLIBRARY_API int32  IntegrateParticles   (float* X, float* Y, const float* InertiaX, const float* InertiaY, float* LifeRemaining, int32 Count, float DeltaTime, TBitArray<>& OutLiveMask);
+
+	// Angle += Spin * DeltaTime.
+	DAYLONGRAPHICSLIBRARY_API void   AdvanceAngles        (float* Angle, const float* Spin, int32 Count, float DeltaTime);
+
+
+	template <typename T>
+	void CompactByMask(TArray<T>& Array, const TBitArray<>& LiveMask, int32 NumLive)
+	{
+		// Slides the elements whose mask bits are set down over the others, keeping their order,
+		// and trims the array to NumLive. Do the same to every field array to drop dead particles.
+
+		int32 Dest = 0;
+
+		for(TConstSetBitIterator<> It(LiveMask); It; ++It)
+		{
+			if(It.GetIndex() != Dest)
+			{
+				Array[Dest] = Array[It.GetIndex()];
+			}
+
+			Dest++;
+		}
+
+		check(Dest == NumLive);
+
+		Array.SetNum(NumLive, false);
+	}
+}
@@ -11,6 +11,7 @@
 #include "DaylonWidgetUtils.h"
 #include "DaylonGeometry.h"
 #include "SDaylonSprite.h"
+#include "DaylonPlayObjectStore.h"
 
 
 namespace Daylon
@@ -22,29 +23,108 @@ namespace Daylon
 	// not call Move(), etc.
 
 
-	template <class SWidgetT>
-	class PlayObject2D : public SWidgetT
+	// Writes every changed play object's transform into its canvas slot and render transform.
+	DAYLONGRAPHICSLIBRARY_API void SyncPlayObjects();
+
+
+	class DAYLONGRAPHICSLIBRARY_API FPlayObjectSyncable
 	{
-		// Stuff common to visible game entities like ships, player, bullets, etc.
+		// Play objects keep their own position, size and angle, and only push them to Slate
+		// when SyncPlayObjects() is called (normally once per frame, after everything has moved).
+		// Objects whose transforms changed queue themselves for that pass; ones changed by
+		// worker frame jobs (see FJobGraph) are held aside and join it at the next sync.
+
+		public:
+
+		virtual ~FPlayObjectSyncable();
+
+		// Returns true if the object should be synced again next frame even if it doesn't change,
+		// e.g. because it's drawn between simulation steps.
+		virtual bool SyncToWidget() = 0;
+
+		void MarkSlotDirty            () { bSlotDirty            = true; MarkTransformDirty(); }
+		void MarkRenderTransformDirty () { bRenderTransformDirty = true; MarkTransformDirty(); }
+
+		bool IsDrawnByBatch           () const { return bDrawnByBatch; }
+
 
 		protected:
 
-		SConstraintCanvas::FSlot* Slot = nullptr; // We need this because we cannot get a slot directly from an SWidget.
+		bool bSlotDirty            = false;
+		bool bRenderTransformDirty = false;
+		bool bDrawnByBatch         = false; // Drawn by an SDaylonSpriteBatch, so there's nothing to sync
+
+		void MarkTransformDirty();
 
-		FWidgetTransform RenderTransform; // Easy way to support GetAngle/SetAngle.
 
+		private:
+
+		bool bSyncPending = false;
+
+		friend void SyncPlayObjects();
+	};
+
+
+	class DAYLONGRAPHICSLIBRARY_API FPlayObjectEntity : public FPlayObjectSyncable
+	{
+		// A play object's handle to its components in an FPlayObjectStore.
+		// References to components are only good until their store next adopts or releases something.
 
 		public:
 
-		FVector2D Inertia; // Direction and velocity, px/sec
-		FVector2D OldPosition;
-		FVector2D UnwrappedNewPosition;
+		FPlayObjectEntity();
+		virtual ~FPlayObjectEntity();
+
+		FPlayObjectEntity(const FPlayObjectEntity&) = delete;
+		FPlayObjectEntity& operator = (const FPlayObjectEntity&) = delete;
+
+		FPlayObjectStore&           GetStore       () const { return *Store; }
+		int32                       GetEntityIndex () const { return EntityIndex; }
+
+		FMotionComponent&           GetMotion      ()       { return Store->Motion   [EntityIndex]; }
+		const FMotionComponent&     GetMotion      () const { return Store->Motion   [EntityIndex]; }
+		FCollisionComponent&        GetCollision   ()       { return Store->Collision[EntityIndex]; }
+		const FCollisionComponent&  GetCollision   () const { return Store->Collision[EntityIndex]; }
+		FLifetimeComponent&         GetLifetime    ()       { return Store->Lifetime [EntityIndex]; }
+		const FLifetimeComponent&   GetLifetime    () const { return Store->Lifetime [EntityIndex]; }
+
+		FVector2D  GetInertia              () const { return GetMotion().Inertia; }
+		void       SetInertia              (const FVector2D& InInertia) { GetMotion().Inertia = InInertia; }
+		FVector2D  GetOldPosition          () const { return GetMotion().OldPosition; }
+		FVector2D  GetUnwrappedNewPosition () const { return GetMotion().UnwrappedNewPosition; }
+		float      GetSpinSpeed            () const { return GetMotion().SpinSpeed; }
+		void       SetSpinSpeed            (float InSpinSpeed) { GetMotion().SpinSpeed = InSpinSpeed; }
+		float      GetRadiusFactor         () const { return GetCollision().RadiusFactor; }
+		void       SetRadiusFactor         (float InRadiusFactor) { GetCollision().RadiusFactor = InRadiusFactor; }
+		float      GetLifeRemaining        () const { return GetLifetime().LifeRemaining; }
+		void       SetLifeRemaining        (float InLifeRemaining) { GetLifetime().LifeRemaining = InLifeRemaining; }
+		int32      GetValue                () const { return Store->Values[EntityIndex].Value; }
+		void       SetValue                (int32 InValue) { Store->Values[EntityIndex].Value = InValue; }
+
 
-		float LifeRemaining = 0.0f;
-		float RadiusFactor  = 0.5f;
-		float SpinSpeed     = 0.0f; // degrees/second
-		int32 Value         = 0;
+		private:
 
+		FPlayObjectStore* Store       = nullptr;
+		int32             EntityIndex = INDEX_NONE;
+
+		friend class FPlayObjectStore;
+	};
+
+
+	template <class SWidgetT>
+	class PlayObject2D : public SWidgetT, public FPlayObjectEntity
+	{
+		// Stuff common to visible game entities like ships, player, bullets, etc.
+		// The model (position, inertia, size, angle, etc.) lives in the entity's components;
+		// the slot and render transform only mirror it after a sync.
+
+		protected:
+
+		SConstraintCanvas::FSlot* Slot   = nullptr; // We need this because we cannot get a slot directly from an SWidget.
+		bool                      bShown = true;    // Visibility of objects drawn by a batch
+
+
+		public:
 
 		virtual ~PlayObject2D() {}
 
@@ -53,15 +133,36 @@ namespace Daylon
 
 		virtual void Update    (float DeltaTime) {}
 
-		void SetSlot   (SConstraintCanvas::FSlot* InSlot) { check(Slot == nullptr); Slot = InSlot; }
+		void SetSlot   (SConstraintCanvas::FSlot* InSlot) 
+		{
+			check(Slot == nullptr);
+			Slot = InSlot;
+
+			const auto Margin = Slot->GetOffset();
+
+			GetMotion().Position = FVector2D(Margin.Left,  Margin.Top);
+			GetCollision().Size  = FVector2D(Margin.Right, Margin.Bottom);
+		}
+
 		void ClearSlot () { check(Slot != nullptr); Slot = nullptr; }
-		bool IsValid   () const { return ((Slot != nullptr) && (Value >= 0)); }
-		bool IsAlive   () const { return (LifeRemaining > 0.0f); }
+		bool IsValid   () const { return ((Slot != nullptr) && (GetValue() >= 0)); }
+		bool IsAlive   () const { return GetLifetime().IsAlive(); }
 		bool IsDead    () const { return !IsAlive(); }
-		bool IsVisible () const { return (IsValid() ? (GetVisibility() != EVisibility::Collapsed && GetVisibility() != EVisibility::Hidden) : false); }
-		void Show      (bool Visible = true) { Daylon::Show(this, Visible); }
+		bool IsVisible () const { return (IsValid() ? (bDrawnByBatch ? bShown : (GetVisibility() != EVisibility::Collapsed && GetVisibility() != EVisibility::Hidden)) : false); }
+		void Show      (bool Visible = true) { bShown = Visible; if(!bDrawnByBatch) { Daylon::Show(this, Visible); } }
 		void Hide      () { Show(false); }
-		void Kill      () { LifeRemaining = 0.0f; Hide(); }
+		void Kill      () { SetLifeRemaining(0.0f); Hide(); }
+
+
+		void SetDrawnByBatch()
+		{
+			// Hands drawing over to an SDaylonSpriteBatch which the caller fills from this object's components.
+			// The widget stays installed but collapsed, Show() and Hide() only record visibility,
+			// and the slot and render transform are no longer kept up to date.
+
+			bDrawnByBatch = true;
+			Daylon::Show(this, false);
+		}
 
 
 		void UpdateWidgetSize() 
@@ -77,7 +178,7 @@ namespace Daylon
 	
 		float GetRadius() const
 		{
-			return GetSize().X * RadiusFactor;
+			return GetSize().X * GetRadiusFactor();
 		}
 
 
@@ -88,30 +189,50 @@ namespace Daylon
 				return FVector2D(0);
 			}
 
-			const auto Margin = Slot->GetOffset();
-
-			return FVector2D(Margin.Left, Margin.Top);
+			return GetMotion().Position;
 		}
 
 
 		void SetPosition(const FVector2D& P)
 		{
+			// Places the object without moving it; it won't be drawn between steps.
+
+			if(!IsValid())
+			{
+				return;
+			}
+
+			auto& Motion = GetMotion();
+
+			Motion.Position = P;
+			Motion.MoveStep = 0;
+			MarkSlotDirty();
+		}
+
+
+		void SetPositionRelativeTo(const FPlayObjectEntity& Leader, const FVector2D& Offset = FVector2D(0))
+		{
+			// For objects attached to another one (shields, etc.); they're drawn moving along with it.
+
 			if(!IsValid())
 			{
 				return;
 			}
 
-			auto Margin = Slot->GetOffset();
-			Margin.Left = P.X;
-			Margin.Top  = P.Y;
+			const auto& LeaderMotion = Leader.GetMotion();
+
+			auto& Motion = GetMotion();
 
-			Slot->SetOffset(Margin);
+			Motion.Position   = LeaderMotion.Position + Offset;
+			Motion.StepMotion = LeaderMotion.StepMotion;
+			Motion.MoveStep   = LeaderMotion.MoveStep;
+			MarkSlotDirty();
 		}
 
 
 		FVector2D GetNextPosition(float DeltaTime) const
 		{
-			return GetPosition() + (Inertia * DeltaTime);
+			return GetPosition() + (GetInertia() * DeltaTime);
 		}
 
 
@@ -122,9 +243,7 @@ namespace Daylon
 				return FVector2D(0);
 			}
 
-			const auto Margin = Slot->GetOffset();
-
-			return FVector2D(Margin.Right, Margin.Bottom);
+			return GetCollision().Size;
 		}
 
 
@@ -135,24 +254,20 @@ namespace Daylon
 				return;
 			}
 
-			auto Margin = Slot->GetOffset();
-
-			Margin.Right  = S.X;
-			Margin.Bottom = S.Y;
-
-			Slot->SetOffset(Margin);
+			GetCollision().Size = S;
+			MarkSlotDirty();
 		}
 
 
 		float GetSpeed() const
 		{
-			return Inertia.Length();
+			return GetInertia().Length();
 		}
 
 
 		float GetAngle() const
 		{
-			return RenderTransform.Angle;
+			return GetMotion().Angle;
 		}
 
 
@@ -163,8 +278,8 @@ namespace Daylon
 				return;
 			}
 
-			RenderTransform.Angle = Angle;
-			SetRenderTransform(RenderTransform.ToSlateRenderTransform());
+			GetMotion().Angle = Angle;
+			MarkRenderTransformDirty();
 		}
 
 
@@ -179,14 +294,24 @@ namespace Daylon
 		}
 
 
-		void Move(float DeltaTime, const TFunction<FVector2D(const FVector2D&)>& WrapFunction)
+		template <typename TWrapPolicy>
+		void Move(float DeltaTime, const TWrapPolicy& Wrap)
 		{
+			// TWrapPolicy is e.g. FToroidalWrap, FClampWrap or FNoWrap.
+
 			const auto P = GetPosition();
 
-			OldPosition          = P;
-			UnwrappedNewPosition = P + Inertia * DeltaTime;
+			auto& Motion = GetMotion();
 
-			SetPosition(WrapFunction(UnwrappedNewPosition));
+			Motion.OldPosition          = P;
+			Motion.UnwrappedNewPosition = P + Motion.Inertia * DeltaTime;
+
+			if(IsValid())
+			{
+				Motion.Position = Wrap(Motion.UnwrappedNewPosition);
+				Motion.AddStepMotion(Motion.Inertia * DeltaTime);
+				MarkSlotDirty();
+			}
 		}
 
 
@@ -198,15 +323,52 @@ namespace Daylon
 				return;
 			}
 
-			OldPosition          =
-			UnwrappedNewPosition = P;
-			Inertia              = InInertia;
-			LifeRemaining        = InLifeRemaining;
+			auto& Motion = GetMotion();
 
+			Motion.OldPosition          =
+			Motion.UnwrappedNewPosition = P;
+			Motion.Inertia              = InInertia;
+
+			SetLifeRemaining(InLifeRemaining);
 			SetPosition(P);
 			Show();
 		}
 
+
+		virtual bool SyncToWidget() override
+		{
+			if(Slot == nullptr)
+			{
+				// Uninstalled since it was marked; nothing to write to.
+				bSlotDirty = bRenderTransformDirty = false;
+				return false;
+			}
+
+			if(bSlotDirty)
+			{
+				const auto& Motion = GetMotion();
+
+				const auto P = GetRenderPosition(Motion);
+				const auto& S = GetCollision().Size;
+
+				Slot->SetOffset(FMargin(P.X, P.Y, S.X, S.Y));
+
+				// Keep drawing it further along the step until it stops moving.
+				bSlotDirty = Motion.IsMovingThisStep();
+			}
+
+			if(bRenderTransformDirty)
+			{
+				FWidgetTransform RenderTransform;
+				RenderTransform.Angle = GetAngle();
+
+				this->SetRenderTransform(RenderTransform.ToSlateRenderTransform());
+				bRenderTransformDirty = false;
+			}
+
+			return bSlotDirty;
+		}
+
 	};
 
 
@@ -256,7 +418,7 @@ namespace Daylon
 		SlotArgs.AutoSize(true);
 		SlotArgs.Alignment(FVector2D(0.5));
 
-		Widget->RadiusFactor = InRadiusFactor;
+		Widget->SetRadiusFactor(InRadiusFactor);
 	}
 
 
@@ -265,6 +427,10 @@ namespace Daylon
 
 	DAYLONGRAPHICSLIBRARY_API void UninstallImpl(TSharedPtr<SWidget> Widget);
 
+	// Adds a widget to the root canvas spanning (0,0) to Size, for widgets like SDaylonSpriteBatch
+	// that draw many objects positioned in canvas space. Uninstall with UninstallImpl().
+	DAYLONGRAPHICSLIBRARY_API void InstallCanvasOverlay(TSharedRef<SWidget> Widget, const FVector2D& Size);
+
 	DAYLONGRAPHICSLIBRARY_API void Uninstall(TSharedPtr<ImagePlayObject2D> Widget);
 	DAYLONGRAPHICSLIBRARY_API void Uninstall(TSharedPtr<SpritePlayObject2D> Widget);
 
@@ -278,8 +444,8 @@ namespace Daylon
 
 			const UE::Geometry::FAxisAlignedBox2d ObjectBox
 			(
-				PlayObject->UnwrappedNewPosition - ObjectHalfSize,
-				PlayObject->UnwrappedNewPosition + ObjectHalfSize
+				PlayObject->GetUnwrappedNewPosition() - ObjectHalfSize,
+				PlayObject->GetUnwrappedNewPosition() + ObjectHalfSize
 			);
 
 			if(ObjectBox.Intersects(Box))
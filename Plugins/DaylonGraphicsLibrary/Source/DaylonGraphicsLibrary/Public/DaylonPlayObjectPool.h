@@ -0,0 +1,131 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DaylonPlayObject2D.h"
+
+
+namespace Daylon
+{
+	template <class T>
+	class TPlayObjectPool
+	{
+		// Keeps installed but hidden play objects on hand so that spawning and killing them
+		// doesn't create widgets or add and remove canvas slots.
+		//
+		// Acquire() hands out a hidden object ready for Start(); Release() kills it and takes it back.
+		// Objects are made by the create function given to Init(), which must return an installed
+		// play object. Nothing is made until the first Acquire() (the root canvas may not exist yet
+		// when Init() is called), which makes InitialSize objects; after that, a dry pool grows by
+		// ChunkSize objects at a time. GetHighWaterMark() reports the most objects ever out at once,
+		// so InitialSize can be tuned until gameplay never has to grow the pool.
+		//
+		// Acquired objects come back with default motion, lifetime and value components, but keep
+		// their widget state (atlas, size, cel, etc.) from their last use.
+
+		public:
+
+			typedef TFunction<TSharedPtr<T>()> FCreateFunc;
+
+
+			void Init(FCreateFunc InCreateFunc, int32 InInitialSize, int32 InChunkSize)
+			{
+				check(InInitialSize > 0 && InChunkSize > 0);
+
+				CreateFunc  = InCreateFunc;
+				InitialSize = InInitialSize;
+				ChunkSize   = InChunkSize;
+			}
+
+
+			TSharedPtr<T> Acquire()
+			{
+				if(Free.IsEmpty())
+				{
+					Grow(NumCreated == 0 ? InitialSize : ChunkSize);
+				}
+
+				auto Object = Free.Pop(false);
+
+				Object->GetMotion()   = FMotionComponent();
+				Object->GetLifetime() = FLifetimeComponent();
+				Object->SetValue(0);
+				Object->MarkRenderTransformDirty();
+
+				HighWaterMark = FMath::Max(HighWaterMark, NumInUse());
+
+				return Object;
+			}
+
+
+			void Release(TSharedPtr<T> Object)
+			{
+				if(!ensure(Object.IsValid()))
+				{
+					return;
+				}
+
+				checkSlow(!Free.Contains(Object));
+
+				Object->Kill();
+				Free.Push(Object);
+			}
+
+
+			// Uninstalls the free objects. Objects still out are left alone; don't release them afterward.
+			void Empty()
+			{
+				for(auto& Object : Free)
+				{
+					Object->ClearSlot();
+					UninstallImpl(StaticCastSharedPtr<SWidget>(Object));
+				}
+
+				Free.Empty();
+				NumCreated    = 0;
+				HighWaterMark = 0;
+			}
+
+
+			int32  NumFree          () const { return Free.Num(); }
+			int32  NumInUse         () const { return NumCreated - Free.Num(); }
+			int32  GetCapacity      () const { return NumCreated; }
+			int32  GetHighWaterMark () const { return HighWaterMark; }
+			int32  GetNumGrowths    () const { return NumGrowths; }
+
+
+		protected:
+
+			FCreateFunc                CreateFunc;
+			TArray<TSharedPtr<T>>      Free;
+			int32                      InitialSize   = 1;
+			int32                      ChunkSize     = 1;
+			int32                      NumCreated    = 0;
+			int32                      HighWaterMark = 0;
+			int32                      NumGrowths    = 0;   // After the initial fill
+
+
+			void Grow(int32 Count)
+			{
+				check(CreateFunc);
+
+				if(NumCreated > 0)
+				{
+					NumGrowths++;
+				}
+
+				Free.Reserve(Free.Num() + Count);
+
+				for(int32 Index = 0; Index < Count; Index++)
+				{
+					auto Object = CreateFunc();
+
+					Object->Kill();
+					Free.Push(Object);
+				}
+
+				NumCreated += Count;
+			}
+	};
+}
@@ -0,0 +1,128 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+namespace Daylon
+{
+	class FPlayObjectEntity;
+	struct FMotionComponent;
+
+
+	// Fixed-timestep rendering. A game that simulates in fixed steps calls BeginSimulationStep()
+	// before each step, and SetRenderInterpolation() with how far it is into the next step
+	// (0 to 1) before SyncPlayObjects(). Objects that moved during the latest step are then drawn
+	// that far along it, so motion looks smooth at any frame rate. Objects that didn't move,
+	// or were placed with SetPosition(), are drawn where they are.
+
+	DAYLONGRAPHICSLIBRARY_API void       BeginSimulationStep    ();
+	DAYLONGRAPHICSLIBRARY_API uint32     GetSimulationStep      ();
+	DAYLONGRAPHICSLIBRARY_API void       SetRenderInterpolation (float Alpha);
+	DAYLONGRAPHICSLIBRARY_API FVector2D  GetRenderPosition      (const FMotionComponent& Motion);
+
+
+	// Play object components. Each kind lives in its own dense array in an FPlayObjectStore.
+
+	struct FMotionComponent
+	{
+		FVector2D  Position             = FVector2D(0);
+		FVector2D  Inertia              = FVector2D(0); // Direction and velocity, px/sec
+		FVector2D  OldPosition          = FVector2D(0);
+		FVector2D  UnwrappedNewPosition = FVector2D(0);
+		FVector2D  StepMotion           = FVector2D(0); // Distance moved during simulation step MoveStep
+		uint32     MoveStep             = 0;            // Zero if not moving
+		float      Angle                = 0.0f;
+		float      SpinSpeed            = 0.0f;         // degrees/second
+
+		// Call when moving the object other than by PlayObject2D::Move().
+		void AddStepMotion(const FVector2D& Delta)
+		{
+			const uint32 Step = GetSimulationStep();
+
+			if(MoveStep != Step)
+			{
+				MoveStep   = Step;
+				StepMotion = FVector2D(0);
+			}
+
+			StepMotion += Delta;
+		}
+
+		bool IsMovingThisStep() const { return (MoveStep != 0 && MoveStep == GetSimulationStep()); }
+	};
+
+
+	struct FCollisionComponent
+	{
+		FVector2D  Size         = FVector2D(0);         // Also the size of the widget in its canvas slot
+		float      RadiusFactor = 0.5f;
+
+		float GetRadius() const { return Size.X * RadiusFactor; }
+	};
+
+
+	struct FLifetimeComponent
+	{
+		float      LifeRemaining = 0.0f;
+
+		bool IsAlive() const { return (LifeRemaining > 0.0f); }
+	};
+
+
+	struct FValueComponent
+	{
+		int32      Value = 0;                           // Score value, kind, etc. Negative means invalid.
+	};
+
+
+	class DAYLONGRAPHICSLIBRARY_API FPlayObjectStore
+	{
+		// Dense storage for play object components. Entity N's components are element N
+		// of each array, and Sprites[N] is the play object (widget) that owns them, so loops
+		// over a kind of object can walk e.g. Motion directly instead of hopping from widget to widget.
+		//
+		// Every entity lives in exactly one store. New play objects start in the default store;
+		// a collection adopts them into its own store and releases them back when done.
+		// Adopt() appends and Release() mirrors TArray::RemoveAtSwap (or TArray::RemoveAt if bKeepOrder
+		// is set), so a collection doing the same to its TArray of play objects stays index-for-index in step.
+
+		public:
+
+			TArray<FMotionComponent>     Motion;
+			TArray<FCollisionComponent>  Collision;
+			TArray<FLifetimeComponent>   Lifetime;
+			TArray<FValueComponent>      Values;
+			TArray<FPlayObjectEntity*>   Sprites;
+
+
+			FPlayObjectStore() {}
+			~FPlayObjectStore();
+
+			FPlayObjectStore(const FPlayObjectStore&) = delete;
+			FPlayObjectStore& operator = (const FPlayObjectStore&) = delete;
+
+			int32  Num         () const { return Sprites.Num(); }
+			bool   IsEmpty     () const { return Sprites.IsEmpty(); }
+			void   Reserve     (int32 Number);
+
+			// Moves an entity and its components from its current store to the end of this one. Returns its new index.
+			int32  Adopt       (FPlayObjectEntity& Entity);
+
+			// Hands the entity at Index back to the default store.
+			void   Release     (int32 Index, bool bKeepOrder = false);
+			void   ReleaseAll  ();
+
+			static FPlayObjectStore& GetDefault();
+
+
+		protected:
+
+			void   Add         (FPlayObjectEntity& Entity);
+			void   Remove      (int32 Index, bool bKeepOrder);
+			void   Transfer    (int32 Index, FPlayObjectStore& Dest, bool bKeepOrder);
+
+			friend class FPlayObjectEntity;
+	};
+}
@@ -0,0 +1,49 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rendering/RenderingCommon.h"
+#include "Rendering/DrawElements.h"
+
+
+namespace Daylon
+{
+	class DAYLONGRAPHICSLIBRARY_API FQuadBatch
+	{
+		// Collects tinted quads during an OnPaint and emits them as a single MakeCustomVerts
+		// element (per MaxQuadsPerElement quads) instead of one draw element per quad.
+		//
+		// Call Begin() with OnPaint's arguments, add quads in the widget's local space, then call End(). Quads lying wholly outside the culling rect are dropped.
+		// With a brush, each quad shows the brush's whole texture; without one, quads are solid.
+		// Widgets keep one of these as a mutable member so the vertex arrays are reused.
+
+		public:
+
+			static const int32 MaxQuadsPerElement = 16384; // Keeps vertex indices within 16 bits
+
+			void   Begin    (const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FSlateBrush* Brush = nullptr);
+			void   AddBox   (const FVector2f& TopLeft, const FVector2f& Size, const FLinearColor& Color);
+			void   AddLine  (const FVector2f& P1, const FVector2f& P2, float Thickness, const FLinearColor& Color);
+			void   End      ();
+
+			int32  GetNumCulled () const { return NumCulled; }  // Since Begin()
+
+
+		protected:
+
+			TArray<FSlateVertex>      Vertices;
+			TArray<SlateIndex>        Indices;
+
+			FSlateRenderTransform     RenderTransform;
+			FSlateRect                LocalCullingRect;
+			FSlateResourceHandle      ResourceHandle;
+			FSlateWindowElementList*  ElementList = nullptr;
+			int32                     Layer       = 0;
+			int32                     NumCulled   = 0;
+
+			bool   IsCulled (const FVector2f& Min, const FVector2f& Max) const;
+			void   AddQuad  (const FVector2f Corners[4], const FColor& Color);
+			void   Flush    ();
+	};
+}
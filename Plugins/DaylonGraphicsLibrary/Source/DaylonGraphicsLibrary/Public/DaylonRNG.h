@@ -238,9 +238,119 @@ namespace Daylon
 	}
 
 
-	// Mimic UE's FMath RNG APIs.
+	class FRng
+	{
+		// A small, fast, seedable random number stream (xoshiro128** by David Blackman and
+		// Sebastiano Vigna, seeded with SplitMix64). It keeps 16 bytes of state where MTRand keeps 2.5K.
+		//
+		// Streams aren't thread-safe. Give each subsystem its own, so what one draws doesn't change
+		// what another gets, and give each parallel work item (not each thread) a Split() of its
+		// subsystem's stream, so results don't depend on how the work was spread over threads.
+
+		public:
+
+			FRng() { Seed(0); }
+
+			explicit FRng(uint64 InSeed, uint64 Stream = 0) { Seed(InSeed, Stream); }
+
+			// Streams with the same seed but different stream numbers are unrelated.
+			void Seed(uint64 InSeed, uint64 Stream = 0)
+			{
+				uint64 X = Mix64(InSeed) ^ Mix64(~Stream);
+
+				const uint64 A = SplitMix64(X);
+				const uint64 B = SplitMix64(X);
+
+				S[0] = (uint32)A;
+				S[1] = (uint32)(A >> 32);
+				S[2] = (uint32)B;
+				S[3] = (uint32)(B >> 32);
+
+				if((S[0] | S[1] | S[2] | S[3]) == 0)
+				{
+					S[0] = 1; // All zeros would only ever produce zeros
+				}
+			}
+
+			// A new stream for work item Index, e.g. one per ParallelFor chunk. Children of the same state
+			// are unrelated to each other and to this stream. Splitting doesn't advance this stream,
+			// so draw from it (or call Next()) before splitting off the next batch of children.
+			FRng Split(uint64 Index) const
+			{
+				return FRng(((uint64)S[1] << 32) | S[0], (((uint64)S[3] << 32) | S[2]) ^ Mix64(Index));
+			}
+
+			uint32 Next()
+			{
+				const uint32 Result = Rotl(S[1] * 5, 7) * 9;
+				const uint32 T      = S[1] << 9;
+
+				S[2] ^= S[0];
+				S[3] ^= S[1];
+				S[1] ^= S[2];
+				S[0] ^= S[3];
+				S[2] ^= T;
+				S[3]  = Rotl(S[3], 11);
+
+				return Result;
+			}
+
+			double FRand      ()                       { return double(Next()) * (1.0 / 4294967295.0); } // [0,1] like MTRand::rand
+			double FRandRange (double Min, double Max) { return Min + FRand() * (Max - Min); }
+			bool   RandBool   ()                       { return ((Next() >> 31) != 0); }
+
+			int32 RandRange(int32 Min, int32 Max)
+			{
+				// Integer in [Min,Max], without modulo bias (Lemire's multiply and reject).
+
+				if(Max <= Min)
+				{
+					return Min;
+				}
 
-	extern MTRand Rng;
+				const uint32 Range = (uint32)Max - (uint32)Min + 1;
+
+				if(Range == 0)
+				{
+					return (int32)Next(); // Whole int32 range
+				}
+
+				uint64 M = (uint64)Next() * Range;
+
+				if((uint32)M < Range)
+				{
+					const uint32 Threshold = (0u - Range) % Range;
+
+					while((uint32)M < Threshold)
+					{
+						M = (uint64)Next() * Range;
+					}
+				}
+
+				return (int32)((uint32)Min + (uint32)(M >> 32));
+			}
+
+
+		protected:
+
+			uint32 S[4];
+
+			static uint32 Rotl       (uint32 X, int32 K) { return (X << K) | (X >> (32 - K)); }
+			static uint64 SplitMix64 (uint64& X)         { return Mix64(X += 0x9E3779B97F4A7C15ull); }
+
+			static uint64 Mix64(uint64 Z)
+			{
+				Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+				return Z ^ (Z >> 31);
+			}
+	};
+
+
+	// Mimic UE's FMath RNG APIs. The versions without a stream draw from Rng,
+	// which is seeded from the clock at startup. Only use it from the game thread.
+
+	DAYLONGRAPHICSLIBRARY_API extern FRng Rng;
 
 	DAYLONGRAPHICSLIBRARY_API double FRand      ();
 	DAYLONGRAPHICSLIBRARY_API double FRandRange (double Min, double Max);
@@ -249,6 +359,11 @@ namespace Daylon
 
 	DAYLONGRAPHICSLIBRARY_API int32  RandRange  (MTRand& R, int32 Min, int32 Max);
 
+	inline double FRand      (FRng& R)                         { return R.FRand(); }
+	inline double FRandRange (FRng& R, double Min, double Max) { return R.FRandRange(Min, Max); }
+	inline int32  RandRange  (FRng& R, int32 Min, int32 Max)   { return R.RandRange(Min, Max); }
+	inline bool   RandBool   (FRng& R)                         { return R.RandBool(); }
+
 
 	inline float FRandRange(const FRange<float>& Range)
 	{
@@ -0,0 +1,86 @@
+// Copyright 2023 Daylon Graphics Ltd. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+namespace Daylon
+{
+	class DAYLONGRAPHICSLIBRARY_API FUniformGrid2D
+	{
+		// A broadphase for 2D collision tests. Objects are identified by their index
+		// into some caller-owned array, and are registered in every cell their bounding box touches.
+		// Queries return the indices of objects whose cells overlap a given box, sorted ascending
+		// so that callers visiting candidates in order see them in the same order a brute-force
+		// loop over the array would.
+		//
+		// Ids must be dense (0..Num-1) and mirror the caller's array: Add() appends, and
+		// RemoveAtSwap() behaves like TArray::RemoveAtSwap so indices stay in sync.
+		// An id can own more than one box (e.g. wrapped copies of an object straddling
+		// a playfield edge); each box carries a caller-defined tag that is handed back by queries.
+		//
+		// Boxes outside the grid's extent are clamped to the border cells, so objects
+		// drifting past the edges (e.g. unwrapped positions) are still found.
+
+		public:
+
+			struct FEntry
+			{
+				int32 Id;
+				int32 Tag;
+
+				bool operator == (const FEntry& Other) const { return (Id == Other.Id && Tag == Other.Tag); }
+				bool operator <  (const FEntry& Other) const { return (Id < Other.Id || (Id == Other.Id && Tag < Other.Tag)); }
+			};
+
+
+			void   Init          (const FBox2d& InExtent, double InCellSize);
+			void   Reset         ();
+
+			int32  Num           () const { return Boxes.Num(); }
+			bool   IsEmpty       () const { return Boxes.IsEmpty(); }
+
+			// Id must be Num() to register a new object, or Num() - 1 to give the newest object another box.
+			void   Add           (int32 Id, const FBox2d& Bounds, int32 Tag = 0);
+			void   RemoveAtSwap  (int32 Id);
+
+			// Queries are read-only and can be called from multiple threads at once.
+
+			// Visits every entry in the cells overlapping Bounds. An entry spanning several cells is visited once per cell.
+			void   ForEachEntry  (const FBox2d& Bounds, TFunctionRef<void(const FEntry&)> Visitor) const;
+
+			// Returns the entries overlapping Bounds without duplicates, sorted by id then tag.
+			void   Query         (const FBox2d& Bounds, TArray<FEntry>& OutEntries) const;
+
+
+		protected:
+
+			struct FCellRange
+			{
+				int32 MinX, MinY, MaxX, MaxY;
+			};
+
+			struct FCellBox
+			{
+				FCellRange Range;
+				int32      Tag;
+			};
+
+			FBox2d                                         Extent;
+			double                                         CellSize    = 1.0;
+			double                                         InvCellSize = 1.0;
+			int32                                          CellsAcross = 0;
+			int32                                          CellsDown   = 0;
+
+			TArray<TArray<FEntry>>                         Cells;
+			TArray<TArray<FCellBox, TInlineAllocator<4>>>  Boxes; // Indexed by id
+
+			FCellRange  ComputeCellRange  (const FBox2d& Bounds) const;
+			void        RemoveFromCells   (int32 Id);
+			void        RenameInCells     (int32 OldId, int32 NewId);
+
+			TArray<FEntry>&        GetCell (int32 X, int32 Y)       { return Cells[Y * CellsAcross + X]; }
+			const TArray<FEntry>&  GetCell (int32 X, int32 Y) const { return Cells[Y * CellsAcross + X]; }
+	};
+}
@@ -3,20 +3,28 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "DaylonFunction.h"
 
 
 namespace Daylon
 {
+	// Task functions keep captures of up to 96 bytes inline, so scheduling one doesn't touch the heap.
+	// Tasks are move-only as a result.
+
+	typedef TInlineFunction<void()>       FTaskFunction;
+	typedef TInlineFunction<void(float)>  FTaskTickFunction;
+
+
 	struct DAYLONGRAPHICSLIBRARY_API FScheduledTask
 	{
-		// A TFunction that runs a specified number of seconds after the task is created.
+		// A function that runs a specified number of seconds after the task is created.
 		// You'll normally want to specify What as a lambda that captures a TWeakObjPtr<UObject-derived class>
 		// e.g. This=this, so that you can test the weak pointer before running the lambda.
 
 
 		float  When = 0.0f;   // Number of seconds into the future.
 
-		TFunction<void()> What;
+		FTaskFunction What;
 
 		bool Tick(float DeltaTime)
 		{
@@ -44,15 +52,15 @@ namespace Daylon
 
 	struct DAYLONGRAPHICSLIBRARY_API FDurationTask
 	{
-		// A TFunction that runs every time Tick() is called until the task duration reaches zero, 
-		// at which point its completion TFunction will be called.
+		// A function that runs every time Tick() is called until the task duration reaches zero, 
+		// at which point its completion function will be called.
 		// See FScheduledTask for more comments.
 
 
 		float  Duration = 0.0f;   // number of seconds to run the task for.
 
-		TFunction<void(float)> What;
-		TFunction<void()>      Completion;
+		FTaskTickFunction  What;
+		FTaskFunction      Completion;
 
 		bool Tick(float DeltaTime)
 		{
@@ -84,4 +92,109 @@ namespace Daylon
 
 			float Elapsed = 0.0f;
 	};
+
+	// ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+	typedef uint64 FScheduledTaskId;
+
+	constexpr FScheduledTaskId InvalidScheduledTaskId = 0;
+
+
+	class DAYLONGRAPHICSLIBRARY_API FTaskScheduler
+	{
+		// Runs scheduled tasks when they come due, and duration tasks every tick until they finish.
+		//
+		// The scheduler keeps its own clock, advanced by Tick(). Scheduled tasks wait in a min-heap
+		// ordered by the clock time they're due at, so a tick only touches the tasks that fire;
+		// pending tasks cost nothing until then. Tasks due at the same time run in the order they
+		// were added. A task added while tasks are running waits for at least the next tick.
+		//
+		// FCountdowns read the same clock, for timers that are polled instead of calling back.
+
+		public:
+
+			// Pending tasks hold move-only callables, so an exported (and thus fully
+			// instantiated) copy constructor wouldn't compile.
+			FTaskScheduler() {}
+			FTaskScheduler(const FTaskScheduler&) = delete;
+			FTaskScheduler& operator = (const FTaskScheduler&) = delete;
+			FTaskScheduler(FTaskScheduler&&) = default;
+			FTaskScheduler& operator = (FTaskScheduler&&) = default;
+
+			void              Tick           (float DeltaTime);
+
+			// Returns an ID that can be passed to Cancel().
+			FScheduledTaskId  Add            (FScheduledTask&& Task) { return Schedule(Task.When, MoveTemp(Task.What)); }
+			FScheduledTaskId  Schedule       (float When, FTaskFunction&& What);
+
+			// Returns false if the task already ran or was cancelled.
+			bool              Cancel         (FScheduledTaskId Id);
+
+			void              Add            (FDurationTask&& Task) { DurationTasks.Add(MoveTemp(Task)); }
+
+			// Room for this many pending tasks before the heap has to grow.
+			void              Reserve        (int32 NumTasks) { Pending.Reserve(NumTasks); }
+
+			void              RemoveAll      ();
+
+			double            GetTime        () const { return Now; }
+			int32             NumPending     () const { return Pending.Num(); }
+			int32             NumRunning     () const { return DurationTasks.Num(); }
+
+
+		protected:
+
+			struct FPendingTask
+			{
+				double             Due = 0.0;
+				FScheduledTaskId   Id  = InvalidScheduledTaskId;
+				FTaskFunction      What;
+			};
+
+			struct FPendingTaskOrder
+			{
+				bool operator()(const FPendingTask& A, const FPendingTask& B) const
+				{
+					return (A.Due < B.Due || (A.Due == B.Due && A.Id < B.Id));
+				}
+			};
+
+			TArray<FPendingTask>   Pending;        // Heap ordered by FPendingTaskOrder
+			TArray<FDurationTask>  DurationTasks;
+			double                 Now    = 0.0;   // Seconds
+			FScheduledTaskId       NextId = 1;
+	};
+
+	// ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+	class DAYLONGRAPHICSLIBRARY_API FCountdown
+	{
+		// Time left until something happens, kept as a deadline on an FTaskScheduler's clock
+		// instead of a float that has to be decremented every frame. Good for timers that
+		// get checked, adjusted or displayed rather than just firing a callback.
+		//
+		// A paused countdown keeps its time left until it's resumed.
+
+		public:
+
+			void   Init          (const FTaskScheduler& InScheduler) { Scheduler = &InScheduler; }
+
+			void   Set           (float Seconds);
+			float  Adjust        (float Amount);   // Returns the new time left
+			float  GetRemaining  () const;
+			bool   IsDue         () const { return (GetRemaining() <= 0.0f); }
+
+			void   SetPaused     (bool bPause);
+			bool   IsPaused      () const { return bPaused; }
+
+
+		protected:
+
+			const FTaskScheduler*  Scheduler       = nullptr;
+			double                 Due             = 0.0;
+			float                  PausedRemaining = 0.0f;
+			bool                   bPaused         = false;
+
+			double GetNow() const { check(Scheduler != nullptr); return Scheduler->GetTime(); }
+	};
 }
@@ -5,7 +5,9 @@
 #include "CoreMinimal.h"
 #include "DaylonWidgetUtils.h"
 #include "DaylonGeometry.h"
+#include "DaylonSpatialGrid.h"
 #include "DaylonTask.h"
+#include "DaylonJobGraph.h"
 #include "DaylonHighscore.h"
 #include "DaylonBindableValue.h"
 #include "DaylonMessageMediator.h"
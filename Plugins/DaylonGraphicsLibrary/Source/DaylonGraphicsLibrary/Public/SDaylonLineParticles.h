@@ -3,19 +3,21 @@
 #pragma once
 
 #include "SlateCore/Public/Widgets/SLeafWidget.h"
+#include "DaylonQuadBatch.h"
+#include "DaylonRNG.h"
 
 
 
 // SDaylonLineParticles - a Slate widget with a custom Paint event.
 // Used to draw e.g. disentegrating polyshields in Stellar Mayhem.
 // After instancing, call Set() with a FDaylonLineParticlesParams object
-// which holds all the initial line segment data.
+// which holds all the initial line segment data. The widget copies it into
+// a structure of arrays updated with the SIMD kernels in DaylonParticleKernels.h.
 
 
 struct DAYLONGRAPHICSLIBRARY_API FDaylonLineParticle
 {
-	// A single line particle.
-	// The widget maintains an array of these.
+	// A single line particle, as handed to the widget.
 
 	FVector2D     P          = FVector2D(0); // Line centerpoint
 	FVector2D     Inertia    = FVector2D(0);
@@ -83,8 +85,8 @@ class DAYLONGRAPHICSLIBRARY_API SDaylonLineParticles : public SLeafWidget
 
 			void Construct(const FArguments& InArgs);
 
-			void Set                      (const FDaylonLineParticlesParams& Params);
-			void SetParticles             (const TArray<FDaylonLineParticle>& InParticles);
+			void Set                      (const FDaylonLineParticlesParams& Params, Daylon::FRng& Rng = Daylon::Rng);
+			void SetParticles             (const TArray<FDaylonLineParticle>& InParticles, Daylon::FRng& Rng = Daylon::Rng);
 			void SetSize                  (const FVector2D& InSize);
 			void SetMinParticleVelocity   (float Velocity);
 			void SetMaxParticleVelocity   (float Velocity);
@@ -113,7 +115,20 @@ class DAYLONGRAPHICSLIBRARY_API SDaylonLineParticles : public SLeafWidget
 
 		protected:
 
-			TArray<FDaylonLineParticle> Particles;
+			// Particles, one element each. Only the live ones are kept.
+			TArray<float>               PositionX;
+			TArray<float>               PositionY;
+			TArray<float>               InertiaX;
+			TArray<float>               InertiaY;
+			TArray<float>               Lengths;
+			TArray<float>               Angles;
+			TArray<float>               Spins;
+			TArray<FLinearColor>        Colors;
+			TArray<float>               LifeRemaining;
+			TArray<float>               StartingLifeRemaining;
+			TBitArray<>                 LiveMask;         // Update() scratch
+			mutable Daylon::FQuadBatch  QuadBatch;        // OnPaint() scratch
+
 			FVector2D                   Size;
 			float                       LineThickness;
 			float                       MinParticleVelocity;
@@ -122,8 +137,6 @@ class DAYLONGRAPHICSLIBRARY_API SDaylonLineParticles : public SLeafWidget
 			float                       MaxParticleLifetime;
 			float                       FinalOpacity;
 
-			virtual bool ComputeVolatility() const override { return true; }
-
 		private:
 
 			float                       StartingLifetime;
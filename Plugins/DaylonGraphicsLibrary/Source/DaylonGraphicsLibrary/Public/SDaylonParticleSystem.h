@@ -0,0 +1,127 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "SlateCore/Public/Widgets/SLeafWidget.h"
+#include "SDaylonParticles.h"
+#include "DaylonQuadBatch.h"
+#include "DaylonRNG.h"
+
+
+// SDaylonParticleSystem - a single widget that draws every particle burst (e.g. all of a game's explosions).
+//
+// Particles live in a fixed-capacity ring of parallel arrays allocated once by SetCapacity().
+// SpawnBurst() appends a burst's particles after the newest ones; if the ring (or the list of bursts)
+// is full, the oldest bursts are dropped to make room. Update() integrates the occupied part of the ring
+// in one pass no matter how many bursts it holds, and retires bursts from the oldest end once they burn out.
+//
+// A burst's particles are positioned relative to its origin, which drifts with the burst's inertia.
+// Give the widget a canvas slot covering the playfield; origins are in its local space.
+// The widget isn't volatile; it invalidates its paint when bursts are spawned, move or are removed.
+
+class DAYLONGRAPHICSLIBRARY_API SDaylonParticleSystem : public SLeafWidget
+{
+	public:
+		SLATE_BEGIN_ARGS(SDaylonParticleSystem)
+			: 
+			  _Size                (FVector2D(16))
+			{
+				_Clipping = EWidgetClipping::OnDemand;
+			}
+
+			SLATE_ATTRIBUTE(FVector2D, Size)
+
+			SLATE_END_ARGS()
+
+			SDaylonParticleSystem() {}
+
+			~SDaylonParticleSystem() {}
+
+			void Construct(const FArguments& InArgs);
+
+
+			void   SetSize            (const FVector2D& InSize);
+			void   SetParticleBrush   (const FSlateBrush& InBrush);
+			void   SetCapacity        (int32 InMaxParticles, int32 InMaxBursts); // Also removes all bursts
+
+			void   SpawnBurst         (const FVector2D& Origin, const FVector2D& Inertia, const FDaylonParticlesParams& Params, Daylon::FRng& Rng = Daylon::Rng);
+			void   RemoveAll          ();
+
+			int32  NumParticles       () const { return NumUsed; }        // Including burnt-out ones not yet retired
+			int32  NumBursts          () const { return NumBurstsUsed; }
+			int32  GetNumDropped      () const { return NumDropped; }     // Bursts dropped early to make room
+
+
+			template <typename TWrapPolicy>
+			void Update(float DeltaTime, const TWrapPolicy& Wrap)
+			{
+				// TWrapPolicy is e.g. FToroidalWrap, FClampWrap or FNoWrap, and moves burst origins.
+
+				for(int32 Age = 0; Age < NumBurstsUsed; Age++)
+				{
+					auto& Burst = GetBurst(Age);
+
+					Burst.Origin         = Wrap(Burst.Origin + Burst.Inertia * DeltaTime);
+					Burst.LifeRemaining -= DeltaTime;
+				}
+
+				UpdateParticles(DeltaTime);
+			}
+
+
+			virtual int32 OnPaint
+			(
+				const FPaintArgs&          Args,
+				const FGeometry&           AllottedGeometry,
+				const FSlateRect&          MyCullingRect,
+				FSlateWindowElementList&   OutDrawElements,
+				int32                      LayerId,
+				const FWidgetStyle&        InWidgetStyle,
+				bool                       bParentEnabled
+			) const override;
+
+			virtual FVector2D ComputeDesiredSize(float) const override;
+
+
+		protected:
+
+			struct FBurst
+			{
+				FVector2D  Origin;
+				FVector2D  Inertia;
+				int32      First;          // Ring index of its first particle
+				int32      Count;
+				float      FinalOpacity;
+				float      LifeRemaining;  // Of its longest-lived particle
+			};
+
+			FVector2D       Size;
+			FSlateBrush     ParticleBrush;
+
+			// Particles, one element each. Positions are relative to their burst's origin.
+			TArray<float>   PositionX;
+			TArray<float>   PositionY;
+			TArray<float>   InertiaX;
+			TArray<float>   InertiaY;
+			TArray<float>   ParticleSizes;
+			TArray<float>   LifeRemaining;
+			TArray<float>   StartingLifeRemaining;
+
+			int32           MaxParticles  = 0;
+			int32           Head          = 0;   // Ring index of the oldest particle
+			int32           NumUsed       = 0;
+
+			TArray<FBurst>  Bursts;              // Also a ring, oldest first
+			int32           BurstHead     = 0;
+			int32           NumBurstsUsed = 0;
+			int32           NumDropped    = 0;
+
+			mutable Daylon::FQuadBatch  QuadBatch;   // OnPaint() scratch
+
+			FBurst&         GetBurst         (int32 Age)       { return Bursts[(BurstHead + Age) % Bursts.Num()]; }
+			const FBurst&   GetBurst         (int32 Age) const { return Bursts[(BurstHead + Age) % Bursts.Num()]; }
+
+			void            UpdateParticles  (float DeltaTime);
+			void            IntegrateSpan    (int32 First, int32 Count, float DeltaTime);
+			void            RemoveOldestBurst();
+};
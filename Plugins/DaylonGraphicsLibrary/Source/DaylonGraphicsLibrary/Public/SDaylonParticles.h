@@ -3,6 +3,7 @@
 #pragma once
 
 #include "SlateCore/Public/Widgets/SLeafWidget.h"
+#include "DaylonQuadBatch.h"
 
 
 struct DAYLONGRAPHICSLIBRARY_API FDaylonParticlesParams
@@ -19,9 +20,14 @@ struct DAYLONGRAPHICSLIBRARY_API FDaylonParticlesParams
 
 
 // SDaylonParticles - a Slate widget with a custom Paint event.
+// Its particles are kept as a structure of arrays and updated with the SIMD kernels
+// in DaylonParticleKernels.h; particles that burn out are compacted away.
+// The widget isn't volatile; Update() invalidates its paint while it has particles.
 
 struct DAYLONGRAPHICSLIBRARY_API FDaylonParticle
 {
+	// One particle as a plain struct, updated one at a time. The widgets no longer use it.
+
 	FVector2D P             = FVector2D(0);
 	FVector2D Inertia       = FVector2D(0);
 	float     Size          = 1.0f;
@@ -115,11 +121,20 @@ class DAYLONGRAPHICSLIBRARY_API SDaylonParticles : public SLeafWidget
 			float      MaxParticleLifetime;
 			float      FinalOpacity;
 
-			virtual bool ComputeVolatility() const override { return true; }
-
 		private:
 
-			TArray<FDaylonParticle>   Particles;
+			// Particles, one element each, relative to the widget's center. Only the live ones are kept.
+			TArray<float>             PositionX;
+			TArray<float>             PositionY;
+			TArray<float>             InertiaX;
+			TArray<float>             InertiaY;
+			TArray<float>             ParticleSizes;
+			TArray<float>             LifeRemaining;
+			TArray<float>             StartingLifeRemaining;
+			TBitArray<>               LiveMask;           // Update() scratch
+			mutable Daylon::FQuadBatch QuadBatch;         // OnPaint() scratch
+
+			int32                     NumParticles = 0;   // How many Reset() makes
 			FSlateBrush               ParticleBrush;
 			float                     StartingLifetime;
 };
@@ -10,6 +10,11 @@
 // SDaylonSpriteWidget - a drawing widget with a custom Paint event.
 // If your sprite is animated, call Update().
 // If you just want to switch amongst cels, call SetCurrentCel().
+//
+// These widgets aren't volatile: they invalidate their own paint when something they draw changes
+// (a new cel, tint, atlas, spin, etc.), so under an invalidation root (e.g. Slate global invalidation)
+// a sprite that isn't changing isn't repainted. Moving one via its slot or render transform
+// is handled by Slate.
 
 
 USTRUCT(BlueprintType)
@@ -70,6 +75,30 @@ struct DAYLONGRAPHICSLIBRARY_API FDaylonSpriteAtlas
 };
 
 
+// An atlas built once and shared by every sprite drawn from it. The cache and a UV box
+// per cel are worked out up front, so sprites hold only a handle instead of their own copy
+// of the brush and cel tables, and handing a sprite a new atlas is just a pointer copy.
+// Treat it as immutable; only PaintBrush, a scratch brush whose UV region is set right
+// before each draw, changes after Create().
+
+struct DAYLONGRAPHICSLIBRARY_API FDaylonSharedSpriteAtlas : public FDaylonSpriteAtlas
+{
+	TArray<FBox2d>        CelUVs;       // Indexed by physical cel
+	mutable FSlateBrush   PaintBrush;
+
+	// If PackedResource is given, cels are drawn from it (e.g. a page made by an offline atlas packer)
+	// using PackedCelUVs, one per cel, instead of from InAtlas's own texture. Sizes still come from InAtlas.
+	static TSharedRef<const FDaylonSharedSpriteAtlas> Create(const FDaylonSpriteAtlas& InAtlas, UObject* PackedResource = nullptr, const TArray<FBox2d>* PackedCelUVs = nullptr);
+
+	// Table lookups; out of range cels get an empty box.
+	const FBox2d& GetUVsForCel(int32 Index) const { return CelUVs.IsValidIndex(Index) ? CelUVs[Index] : EmptyUVs; }
+
+	static const FBox2d EmptyUVs;
+};
+
+typedef TSharedPtr<const FDaylonSharedSpriteAtlas> FDaylonSpriteAtlasHandle;
+
+
 class DAYLONGRAPHICSLIBRARY_API SDaylonSprite : public SLeafWidget
 {
 	public:
@@ -93,11 +122,14 @@ class DAYLONGRAPHICSLIBRARY_API SDaylonSprite : public SLeafWidget
 
 			const FVector2D&  GetSize       () const { return Size; }
 			void              SetSize       (const FVector2D& InSize);
-			void              SetTint       (const FLinearColor& Color) { Tint = Color; }
-			void              SetAtlas      (const FDaylonSpriteAtlas& InAtlas);
+			void              SetTint       (const FLinearColor& Color);
+			void              SetAtlas      (const FDaylonSpriteAtlasHandle& InAtlas);
+			void              SetAtlas      (const FDaylonSpriteAtlas& InAtlas); // Builds a private shared atlas; prefer a handle when many sprites use the same atlas
+			const FDaylonSpriteAtlasHandle& GetAtlas () const { return Atlas; }
 
 			void              SetCurrentCel (int32 Index);                      // Useful only in static mode
 			void              SetCurrentCel (int32 CelX, int32 CelY);
+			int32             GetCurrentCel () const { return CurrentCelIndex; }
 			void              SetCurrentAge (float Age) { CurrentAge = Age; }   // Useful in dynamic mode
 			void              Update        (float DeltaTime);
 			void              Reset         ();
@@ -116,6 +148,7 @@ class DAYLONGRAPHICSLIBRARY_API SDaylonSprite : public SLeafWidget
 
 			virtual FVector2D ComputeDesiredSize(float) const override;
 
+			// If you change the flips on a visible sprite, call Invalidate(EInvalidateWidgetReason::Paint).
 			bool      IsStatic       = false; // Set to true to use current cel regardless of updating
 			bool      FlipHorizontal = false;
 			bool      FlipVertical   = false;
@@ -125,13 +158,10 @@ class DAYLONGRAPHICSLIBRARY_API SDaylonSprite : public SLeafWidget
 
 			FLinearColor                 Tint = FLinearColor::White;
 			FVector2D                    Size;
-			mutable FDaylonSpriteAtlas   Atlas;
+			FDaylonSpriteAtlasHandle     Atlas;
 
 			float                        CurrentAge      = 0.0f;
 			int32                        CurrentCelIndex = 0;
-
-			virtual bool ComputeVolatility() const override { return true; }
-
 };
 
 
@@ -203,7 +233,4 @@ class DAYLONGRAPHICSLIBRARY_API SDaylonPolyShield : public SLeafWidget
 			TArray<float>                SegmentHealth;
 
 			float                        CurrentAge      = 0.0f;
-
-			virtual bool ComputeVolatility() const override { return true; }
-
 };
@@ -0,0 +1,85 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+#pragma once
+
+#include "SlateCore/Public/Widgets/SLeafWidget.h"
+#include "SDaylonSprite.h"
+
+
+// SDaylonSpriteBatch - paints any number of sprites sharing one atlas in a single OnPaint.
+// Fill the instance array every frame (Reset(), Add() each sprite, then Commit()) and Slate only has
+// one widget to prepass, arrange and paint no matter how many sprites there are.
+// Give the widget a canvas slot covering the playfield; instance positions are in its local space.
+// Commit() only invalidates the widget's paint if the instances differ from the ones last painted.
+
+struct DAYLONGRAPHICSLIBRARY_API FDaylonSpriteInstance
+{
+	FVector2D     Position       = FVector2D(0);    // Center of the sprite
+	FVector2D     Size           = FVector2D(0);
+	float         Angle          = 0.0f;             // Degrees, about the center
+	int32         Cel            = 0;                // Physical cel index
+	FLinearColor  Tint           = FLinearColor::White;
+	bool          FlipHorizontal = false;
+	bool          FlipVertical   = false;
+
+	bool operator == (const FDaylonSpriteInstance& Other) const
+	{
+		return (Position == Other.Position && Size == Other.Size && Angle == Other.Angle && Cel == Other.Cel 
+			&& Tint == Other.Tint && FlipHorizontal == Other.FlipHorizontal && FlipVertical == Other.FlipVertical);
+	}
+};
+
+
+class DAYLONGRAPHICSLIBRARY_API SDaylonSpriteBatch : public SLeafWidget
+{
+	public:
+		SLATE_BEGIN_ARGS(SDaylonSpriteBatch)
+			: 
+			  _Size                (FVector2D(16))
+			{
+				_Clipping = EWidgetClipping::OnDemand;
+			}
+
+			SLATE_ATTRIBUTE(FVector2D, Size)
+
+			SLATE_END_ARGS()
+
+			SDaylonSpriteBatch() {}
+
+			~SDaylonSpriteBatch() {}
+
+			void Construct(const FArguments& InArgs);
+
+
+			void                                   SetSize       (const FVector2D& InSize);
+			void                                   SetAtlas      (const FDaylonSpriteAtlasHandle& InAtlas) { Atlas = InAtlas; }
+			const FDaylonSpriteAtlasHandle&        GetAtlas      () const { return Atlas; }
+
+			void                                   Reset         () { Instances.Reset(); } // Keeps the array's allocation
+			FDaylonSpriteInstance&                 Add           () { return Instances.AddDefaulted_GetRef(); }
+			void                                   Commit        ();                                // Shows what was added since Reset()
+			int32                                  Num           () const { return Instances.Num(); }
+			const TArray<FDaylonSpriteInstance>&   GetInstances  () const { return Instances; }   // Those added since Reset(), until Commit()
+
+
+			virtual int32 OnPaint
+			(
+				const FPaintArgs&          Args,
+				const FGeometry&           AllottedGeometry,
+				const FSlateRect&          MyCullingRect,
+				FSlateWindowElementList&   OutDrawElements,
+				int32                      LayerId,
+				const FWidgetStyle&        InWidgetStyle,
+				bool                       bParentEnabled
+			) const override;
+
+			virtual FVector2D ComputeDesiredSize(float) const override;
+
+
+		protected:
+
+			FVector2D                         Size;
+			FDaylonSpriteAtlasHandle          Atlas;
+			TArray<FDaylonSpriteInstance>     Instances;
+			TArray<FDaylonSpriteInstance>     PaintedInstances;   // As of the last Commit() that changed anything
+};
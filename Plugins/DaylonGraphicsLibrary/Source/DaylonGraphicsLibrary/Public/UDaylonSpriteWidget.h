@@ -9,6 +9,8 @@
 #include "SDaylonSprite.h"
 #include "UDaylonSpriteWidget.generated.h"
 
+class UTexture2D;
+
 // Warning: do NOT use this widget at design time.
 
 UCLASS(BluePrintType)
@@ -21,6 +23,25 @@ class DAYLONGRAPHICSLIBRARY_API UDaylonSpriteWidgetAtlas : public UDataAsset
 		// The texture holding the sprite cels.
 		UPROPERTY(EditAnywhere, BlueprintReadOnly)
 		FDaylonSpriteAtlas Atlas;
+
+		// Filled in by an offline packer that copies this atlas's cels into a page texture shared
+		// with other atlases, so sprites from different atlases can be drawn in the same batch.
+		// When set, Build() makes the shared atlas draw from PackedTexture using PackedCelUVs
+		// (one per cel) instead of from Atlas.AtlasBrush's texture. Clear both to unpack.
+		UPROPERTY(VisibleAnywhere, Category = "Packing")
+		TObjectPtr<UTexture2D> PackedTexture;
+
+		UPROPERTY(VisibleAnywhere, Category = "Packing")
+		TArray<FBox2D> PackedCelUVs;
+
+		// Builds the shared form of Atlas (and initializes Atlas's own cache). Call once after
+		// any changes to Atlas, then hand GetHandle() to every sprite using this asset.
+		void                             Build      ();
+		const FDaylonSpriteAtlasHandle&  GetHandle  () const { return Handle; }
+
+	protected:
+
+		FDaylonSpriteAtlasHandle Handle;
 };
 
 
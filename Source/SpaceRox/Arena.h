@@ -20,18 +20,35 @@ class FTorpedo;
 class FPlayerShip;
 struct FDaylonParticlesParams;
 
-namespace Daylon { struct FScheduledTask; struct FLoopedSound; }
+namespace Daylon { struct FScheduledTask; struct FLoopedSound; class FCountdown; class FRng; }
+
+
+// Each subsystem draws random numbers from its own stream, so e.g. an extra explosion
+// doesn't change how the next rock splits.
+
+enum class ERngStream : uint8
+{
+	Asteroids = 0,  // Wave rocks, splits and cels
+	Explosions,     // Particle bursts, including the intro's
+	Enemies,        // Enemy ship, boss and scavenger spawning and AI
+	Powerups,
+
+	Count
+};
+
+
+// The wrap policy for anything moving around the playfield. It's a plain Daylon::FToroidalWrap,
+// so PlayObject2D::Move and the component loops inline it.
+inline Daylon::FToroidalWrap GetViewportWrap() { return Daylon::FToroidalWrap(ViewportSize); }
 
 
 class IArena
 {
 	public:
 
-	    virtual TFunction<FVector2D(const FVector2D&)> GetWrapPositionFunction() const = 0;
-
 		virtual FVector2D                     WrapPosition                 (const FVector2D& P) = 0;
 																		   
-		virtual void                          AddScheduledTask             (Daylon::FScheduledTask&) = 0;
+		virtual void                          AddScheduledTask             (Daylon::FScheduledTask&&) = 0;
 		virtual void                          ScheduleExplosion            (float When, const FVector2D& P, const FVector2D& Inertia, const FDaylonParticlesParams& Params) = 0;
 																		   
 		virtual Daylon::FLoopedSound&         GetBigEnemySoundLoop         () = 0;
@@ -39,19 +56,21 @@ class IArena
 										      							   
 		virtual bool                          CanExplosionOccur            () const = 0;
 																		   
-		virtual const FDaylonSpriteAtlas&     GetBigEnemyAtlas             () const = 0;
-		virtual const FDaylonSpriteAtlas&     GetSmallEnemyAtlas           () const = 0;
-		virtual const FDaylonSpriteAtlas&     GetMiniboss1Atlas            () const = 0;
-		virtual const FDaylonSpriteAtlas&     GetMiniboss2Atlas            () const = 0;
-		virtual const FDaylonSpriteAtlas&     GetScavengerAtlas            () const = 0;
-		virtual const FDaylonSpriteAtlas&     GetMediumAsteroidAtlas       () const = 0;
-		virtual const FDaylonSpriteAtlas&     GetSmallAsteroidAtlas        () const = 0;
-		virtual const FDaylonSpriteAtlas&     GetDefensesAtlas             () const = 0;
+		virtual const FDaylonSpriteAtlasHandle& GetBigEnemyAtlas           () const = 0;
+		virtual const FDaylonSpriteAtlasHandle& GetSmallEnemyAtlas         () const = 0;
+		virtual const FDaylonSpriteAtlasHandle& GetMiniboss1Atlas          () const = 0;
+		virtual const FDaylonSpriteAtlasHandle& GetMiniboss2Atlas          () const = 0;
+		virtual const FDaylonSpriteAtlasHandle& GetScavengerAtlas          () const = 0;
+		virtual const FDaylonSpriteAtlasHandle& GetMediumAsteroidAtlas     () const = 0;
+		virtual const FDaylonSpriteAtlasHandle& GetSmallAsteroidAtlas      () const = 0;
+		virtual const FDaylonSpriteAtlasHandle& GetDefensesAtlas           () const = 0;
 																		   
 		virtual FAsteroids&                   GetAsteroids                 () = 0;
 		virtual FExplosions&                  GetExplosions                () = 0;
 		virtual FShieldExplosions&            GetShieldExplosions          () = 0;
-		virtual TArray<TSharedPtr<FPowerup>>& GetPowerups                  () = 0;
+		virtual const TArray<TSharedPtr<FPowerup>>& GetPowerups            () const = 0;
+		virtual int32                         AddPowerup                   (TSharedPtr<FPowerup> PowerupPtr) = 0;
+		virtual Daylon::TPlayObjectPool<FPowerup>& GetPowerupPool          () = 0;
 		virtual FSlateBrush&                  GetExplosionParticleBrush    () = 0;
 		virtual USoundBase*                   GetExplosionSound            (int32 Index) = 0;
 		virtual USoundBase*                   GetTorpedoSound              () = 0;
@@ -71,15 +90,10 @@ class IArena
 		virtual Daylon::FLoopedSound&         GetPlayerShipThrustSoundLoop () = 0;
 		virtual void                          IncreasePlayerScoreBy        (int32 Amount) = 0;
 
-		virtual float                         AdjustTimeUntilNextEnemyShip (float Amount) = 0;
-		virtual float                         GetTimeUntilNextEnemyShip    () const = 0;
-		virtual void                          SetTimeUntilNextEnemyShip    (float Value) = 0;
-
-		virtual float                         AdjustTimeUntilNextScavenger (float Amount) = 0;
-		virtual float                         GetTimeUntilNextScavenger    () const = 0;
-		virtual void                          SetTimeUntilNextScavenger    (float Value) = 0;
+		// Time until the next spawn of each kind of enemy. These run on the arena's task clock.
+		virtual Daylon::FCountdown&           GetEnemyShipCountdown        () = 0;
+		virtual Daylon::FCountdown&           GetScavengerCountdown        () = 0;
+		virtual Daylon::FCountdown&           GetBossCountdown             () = 0;
 
-		virtual float                         AdjustTimeUntilNextBoss      (float Amount) = 0;
-		virtual float                         GetTimeUntilNextBoss         () const = 0;
-		virtual void                          SetTimeUntilNextBoss         (float Value) = 0;
+		virtual Daylon::FRng&                 GetRng                       (ERngStream Stream) = 0;
 };
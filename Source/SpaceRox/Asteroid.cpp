@@ -2,22 +2,35 @@
 #include "Constants.h"
 #include "Arena.h"
 #include "DaylonRNG.h"
+#include "GameRules.h"
 
 
-TSharedPtr<FAsteroid> FAsteroid::Spawn(IArena* InArena, const FDaylonSpriteAtlas& Atlas)
+TSharedPtr<FAsteroid> FAsteroid::CreateWidget()
 {
-	check(InArena);
-
 	auto Widget = SNew(FAsteroid);
 
-	Daylon::Install<SDaylonSprite>(Widget, 0.5f);
+	Daylon::Install<SDaylonSprite>(Widget, AsteroidRadiusFactor);
+
+	Widget->SetDrawnByBatch();
+
+	return Widget;
+}
+
+
+TSharedPtr<FAsteroid> FAsteroid::Spawn(IArena* InArena, const FDaylonSpriteAtlasHandle& Atlas)
+{
+	check(InArena);
+
+	auto Widget = InArena->GetAsteroids().Pool.Acquire();
 
 	Widget->Arena = InArena;
+	Widget->Age   = 0.0f;
+	Widget->Powerup.Reset();
 	Widget->SetAtlas(Atlas);
-	// We use 4K textures so halve that image size for the sprite widget size in our HD Slate space
-	Widget->SetSize(Atlas.AtlasBrush.GetImageSize() / 2);
+	Widget->SetSize(GetSize(*Atlas));
 	Widget->UpdateWidgetSize();
-	Widget->SetCurrentCel(Daylon::RandRange(0, Atlas.NumCels - 1));
+	Widget->SetCurrentCel(InArena->GetRng(ERngStream::Asteroids).RandRange(0, Atlas->NumCels - 1));
+	Widget->Show();
 
 	return Widget;
 }
@@ -29,6 +42,25 @@ bool FAsteroid::HasPowerup() const
 }
 
 
+FVector2D FAsteroid::GetSize(const FDaylonSpriteAtlas& Atlas)
+{
+	// We use 4K textures so halve that image size for the sprite widget size in our HD Slate space
+	return Atlas.AtlasBrush.GetImageSize() / 2;
+}
+
+
+FBox2d FAsteroid::GetCollisionBounds(const Daylon::FMotionComponent& Motion, float Radius)
+{
+	FBox2d Bounds(ForceInit);
+
+	Bounds += Motion.Position;
+	Bounds += Motion.OldPosition;
+	Bounds += Motion.UnwrappedNewPosition;
+
+	return Bounds.ExpandBy(Radius + CollisionGridPadding);
+}
+
+
 TSharedPtr<FAsteroid> FAsteroid::Split()
 {
 	// Apparently we always split into two children.
@@ -36,54 +68,52 @@ TSharedPtr<FAsteroid> FAsteroid::Split()
 	// For the new inertias, we want the kids to generally be faster but 
 	// once in a while, one of the kids can be slower.
 
-	const FDaylonSpriteAtlas* NewAsteroidAtlasPtr = nullptr;
+	const FDaylonSpriteAtlasHandle* NewAsteroidAtlasPtr = nullptr;
+
+	SetValue(GetAsteroidSplitValue(GetValue()));
 
-	switch(Value)
+	switch(GetValue())
 	{
-		case ValueBigAsteroid:
+		case ValueMediumAsteroid:
 			NewAsteroidAtlasPtr = &Arena->GetMediumAsteroidAtlas();
-			Value = ValueMediumAsteroid;
 			break;
 
-		case ValueMediumAsteroid:
+		case ValueSmallAsteroid:
 			NewAsteroidAtlasPtr = &Arena->GetSmallAsteroidAtlas();
-			Value = ValueSmallAsteroid;
 			break;
 	}
 
 	check(NewAsteroidAtlasPtr);
 	SetAtlas(*NewAsteroidAtlasPtr);
 
-	SetSize(NewAsteroidAtlasPtr->GetCelPixelSize());
+	SetSize((*NewAsteroidAtlasPtr)->GetCelPixelSize());
 	UpdateWidgetSize();
 
-	SetCurrentCel(Daylon::RandRange(0, NewAsteroidAtlasPtr->NumCels - 1));
+	auto& Rng = Arena->GetRng(ERngStream::Asteroids);
+
+	SetCurrentCel(Rng.RandRange(0, (*NewAsteroidAtlasPtr)->NumCels - 1));
 
 
 	auto NewAsteroidPtr = FAsteroid::Spawn(Arena, *NewAsteroidAtlasPtr);
 	auto& NewAsteroid   = *NewAsteroidPtr.Get();
 
-	NewAsteroid.Value = Value;
-
-
-	const bool BothKidsFast = Daylon::RandRange(0, 10) < 9;
+	NewAsteroid.SetValue(GetValue());
 
-	NewAsteroid.Inertia = Daylon::DeviateVector(Inertia, MinAsteroidSplitAngle, MaxAsteroidSplitAngle);
-	NewAsteroid.Inertia *= Daylon::FRandRange(1.2f, 3.0f);
+	auto& Motion    = GetMotion();
+	auto& NewMotion = NewAsteroid.GetMotion();
 
-	NewAsteroid.LifeRemaining = 1.0f;
-	NewAsteroid.SpinSpeed     = SpinSpeed * AsteroidSpinScale;// Daylon::FRandRange(MinAsteroidSpinSpeed, MaxAsteroidSpinSpeed);
+	ComputeAsteroidSplitInertias(Rng, Motion.Inertia, Motion.Inertia, NewMotion.Inertia);
 
-	Inertia = Daylon::DeviateVector(Inertia, -MinAsteroidSplitAngle, -MaxAsteroidSplitAngle);
-	Inertia *= (BothKidsFast ? Daylon::FRandRange(1.2f, 3.0f) : Daylon::FRandRange(0.25f, 1.0f));
+	NewAsteroid.SetLifeRemaining(1.0f);
+	NewMotion.SpinSpeed = Motion.SpinSpeed * AsteroidSpinScale;// Daylon::FRandRange(MinAsteroidSpinSpeed, MaxAsteroidSpinSpeed);
 
-	SpinSpeed *= AsteroidSpinScale;
+	Motion.SpinSpeed *= AsteroidSpinScale;
 
 	NewAsteroid.Show();
 
-	NewAsteroid.OldPosition = 
-	NewAsteroid.UnwrappedNewPosition = UnwrappedNewPosition;
-	NewAsteroid.SetPosition(NewAsteroid.UnwrappedNewPosition);
+	NewMotion.OldPosition = 
+	NewMotion.UnwrappedNewPosition = Motion.UnwrappedNewPosition;
+	NewAsteroid.SetPosition(NewMotion.UnwrappedNewPosition);
 
 	return NewAsteroidPtr;
 }
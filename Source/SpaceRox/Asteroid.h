@@ -23,11 +23,23 @@ class FAsteroid : public FPlayObject
 
 		TSharedPtr<FPowerup> Powerup;
 
-		bool                   HasPowerup  () const;
-		TSharedPtr<FAsteroid>  Split       ();
+		bool                   HasPowerup         () const;
+		TSharedPtr<FAsteroid>  Split              ();
 
+		// Box enclosing everything the collision tests look at this frame:
+		// the displayed position plus the swept path, each grown by the radius.
+		FBox2d                 GetCollisionBounds () const { return GetCollisionBounds(GetMotion(), GetRadius()); }
 
-		static TSharedPtr<FAsteroid> Spawn(IArena* InArena, const FDaylonSpriteAtlas& Atlas);
+
+		// Takes a rock from the arena's pool; CreateWidget makes the pool's rocks.
+		static TSharedPtr<FAsteroid> Spawn        (IArena* InArena, const FDaylonSpriteAtlasHandle& Atlas);
+		static TSharedPtr<FAsteroid> CreateWidget ();
+
+		// The size Spawn gives a rock drawn from Atlas.
+		static FVector2D       GetSize            (const FDaylonSpriteAtlas& Atlas);
+
+		// Same as the member, for a rock known only by its components (e.g. in FSimWorld).
+		static FBox2d          GetCollisionBounds (const Daylon::FMotionComponent& Motion, float Radius);
 	
 
 
@@ -37,7 +49,7 @@ class FAsteroid : public FPlayObject
 			// Make asteroid fade in after being created.
 			//FPlayObject::Update(DeltaTime); // don't animate any cels
 
-			if(Age < 1.0f && Value == ValueBigAsteroid)
+			if(Age < 1.0f && GetValue() == ValueBigAsteroid)
 			{
 				Age += DeltaTime;
 
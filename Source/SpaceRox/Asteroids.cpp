@@ -4,6 +4,20 @@
 #define FEATURE_SPINNING_ASTEROIDS  1
 
 
+void FAsteroids::Add(TSharedPtr<FAsteroid> AsteroidPtr)
+{
+	Asteroids.Add(AsteroidPtr);
+	Components.Adopt(*AsteroidPtr.Get());
+
+	checkSlow(AsteroidPtr->GetEntityIndex() == Asteroids.Num() - 1);
+
+	if(bGridIsCurrent)
+	{
+		AddToGrid(Asteroids.Num() - 1);
+	}
+}
+
+
 void FAsteroids::Remove(int32 Index)
 {
 	if(!Asteroids.IsValidIndex(Index))
@@ -14,14 +28,21 @@ void FAsteroids::Remove(int32 Index)
 
 	auto& Asteroid = *Asteroids[Index].Get();
 
-	if(Asteroid.HasPowerup())
+	if(Asteroid.Powerup)
 	{
-		Daylon::Uninstall(Asteroid.Powerup);
+		Arena->GetPowerupPool().Release(Asteroid.Powerup);
+		Asteroid.Powerup.Reset();
 	}
 
-	Daylon::Uninstall(Asteroids[Index]);
+	Pool.Release(Asteroids[Index]);
 
+	Components.Release(Index);
 	Asteroids.RemoveAtSwap(Index);
+
+	if(bGridIsCurrent)
+	{
+		Grid.RemoveAtSwap(Index);
+	}
 }
 
 
@@ -38,27 +59,253 @@ void FAsteroids::Update(float DeltaTime)
 {
 	check(Arena);
 
-	for (auto& Elem : Asteroids)
-	{
-		auto& Asteroid = *Elem.Get();
+	// Rocks are about to move, so the grid no longer describes them.
+	bGridIsCurrent = false;
+
+	// Move the rocks straight through their components; the widgets only hear about it at sync time.
+
+	const auto Wrap = GetViewportWrap();
 
-		if (Asteroid.LifeRemaining > 0.0f)
+	for(int32 Index = 0; Index < Components.Num(); Index++)
+	{
+		if(!Components.Lifetime[Index].IsAlive())
 		{
-			Asteroid.Move(DeltaTime, Arena->GetWrapPositionFunction());
+			continue;
+		}
+
+		auto& Motion = Components.Motion[Index];
+
+		Motion.OldPosition          = Motion.Position;
+		Motion.UnwrappedNewPosition = Motion.Position + Motion.Inertia * DeltaTime;
+		Motion.Position             = Wrap(Motion.UnwrappedNewPosition);
+
+		Motion.AddStepMotion(Motion.Inertia * DeltaTime);
+
+		Components.Sprites[Index]->MarkSlotDirty();
+
+#if(FEATURE_SPINNING_ASTEROIDS == 1)
+		Motion.Angle = Daylon::WrapAngle(Motion.Angle + Motion.SpinSpeed * DeltaTime);
+
+		Components.Sprites[Index]->MarkRenderTransformDirty();
+#endif
+
+		auto& Asteroid = Get(Index);
 
 #if(FEATURE_ASTEROID_FADE_IN == 1)
-			Asteroid.Update(DeltaTime);
+		Asteroid.Update(DeltaTime);
 #endif
-			if(Asteroid.HasPowerup())
+		if(Asteroid.HasPowerup())
+		{
+			Asteroid.Powerup->SetPositionRelativeTo(Asteroid);
+			Asteroid.Powerup->Update(DeltaTime);
+		}
+	}
+
+	if(bCollideWithEachOther)
+	{
+		CollideWithEachOther();
+	}
+}
+
+
+float FAsteroids::GetMass(int32 Value)
+{
+	switch(Value)
+	{
+		case ValueBigAsteroid:    return BigAsteroidMass;
+		case ValueMediumAsteroid: return MediumAsteroidMass;
+		default:                  return SmallAsteroidMass;
+	}
+}
+
+
+void FAsteroids::CollideWithEachOther()
+{
+	// The new inertias take effect when the rocks next move; this frame's
+	// swept positions (which the other collision tests use) are left alone.
+
+	Bodies.Reset();
+
+	for(int32 Index = 0; Index < Components.Num(); Index++)
+	{
+		const auto& Motion = Components.Motion[Index];
+
+		Bodies.Add(Motion.Position, Motion.Inertia, Components.Collision[Index].GetRadius(), GetMass(Components.Values[Index].Value));
+	}
+
+	CollideBodies(Bodies, BodyGrid, BodyNeighbors);
+
+	for(int32 Index = 0; Index < Components.Num(); Index++)
+	{
+		Components.Motion[Index].Inertia = Bodies.Inertias[Index];
+	}
+}
+
+
+int32 FAsteroids::CollideBodies(FAsteroidBodies& Bodies, Daylon::FUniformGrid2D& BodyGrid, TArray<Daylon::FUniformGrid2D::FEntry>& Neighbors)
+{
+	BodyGrid.Reset();
+
+	for(int32 Index = 0; Index < Bodies.Num(); Index++)
+	{
+		const FBox2d Bounds = FBox2d(Bodies.Positions[Index], Bodies.Positions[Index]).ExpandBy(Bodies.Radii[Index] + CollisionGridPadding);
+
+		BodyGrid.Add(Index, Bounds, WrapDirectionToTag(FIntPoint(0, 0)));
+
+		FIntPoint Directions[Daylon::MaxWrapGhosts];
+
+		const int32 NumGhosts = Daylon::GetWrapGhostDirections(Bounds, ViewportSize, Directions);
+
+		for(int32 GhostIndex = 0; GhostIndex < NumGhosts; GhostIndex++)
+		{
+			BodyGrid.Add(Index, Bounds.ShiftBy(FVector2D(Directions[GhostIndex]) * ViewportSize), WrapDirectionToTag(Directions[GhostIndex]));
+		}
+	}
+
+	// Look each body up where it is; its neighbors' wrapped copies are in the grid,
+	// so a pair straddling a seam is found once, from the lower index.
+
+	int32 NumBounces = 0;
+
+	for(int32 Index = 0; Index < Bodies.Num(); Index++)
+	{
+		const FVector2D P      = Bodies.Positions[Index];
+		const float     Radius = Bodies.Radii[Index];
+
+		BodyGrid.Query(FBox2d(P, P).ExpandBy(Radius + CollisionGridPadding), Neighbors);
+
+		for(const auto& Neighbor : Neighbors)
+		{
+			if(Neighbor.Id <= Index)
 			{
-				Asteroid.Powerup->SetPosition(Asteroid.GetPosition());
-				Asteroid.Powerup->Update(DeltaTime);
+				continue;
 			}
-#if(FEATURE_SPINNING_ASTEROIDS == 1)
-			Asteroid.SetAngle(Daylon::WrapAngle(Asteroid.GetAngle() + Asteroid.SpinSpeed * DeltaTime));
-#endif
+
+			const FVector2D OtherP      = Bodies.Positions[Neighbor.Id] + FVector2D(TagToWrapDirection(Neighbor.Tag)) * ViewportSize;
+			const float     MinDistance = Radius + Bodies.Radii[Neighbor.Id];
+
+			if(FVector2D::DistSquared(P, OtherP) >= FMath::Square(MinDistance))
+			{
+				continue;
+			}
+
+			// Rocks already moving apart (e.g. the two halves of a split rock) are left alone.
+
+			const FVector2D OldInertia = Bodies.Inertias[Index];
+
+			Daylon::ComputeCollisionInertia(Bodies.Masses[Index], Bodies.Masses[Neighbor.Id], AsteroidRestitution, P, OtherP, Bodies.Inertias[Index], Bodies.Inertias[Neighbor.Id]);
+
+			if(Bodies.Inertias[Index] != OldInertia)
+			{
+				NumBounces++;
+			}
+		}
+	}
+
+	return NumBounces;
+}
+
+
+void FAsteroids::RebuildGrid()
+{
+	Grid.Reset();
+
+	for(int32 Index = 0; Index < Asteroids.Num(); Index++)
+	{
+		AddToGrid(Index);
+	}
+
+	bGridIsCurrent = true;
+}
+
+
+void FAsteroids::AddToGrid(Daylon::FUniformGrid2D& InGrid, int32 Index, const FBox2d& Bounds)
+{
+	InGrid.Add(Index, Bounds, WrapDirectionToTag(FIntPoint(0, 0)));
+
+	// Only rocks in the edge band get extra boxes.
+
+	FIntPoint Directions[Daylon::MaxWrapGhosts];
+
+	const int32 NumGhosts = Daylon::GetWrapGhostDirections(Bounds, ViewportSize, Directions);
+
+	for(int32 GhostIndex = 0; GhostIndex < NumGhosts; GhostIndex++)
+	{
+		InGrid.Add(Index, Bounds.ShiftBy(FVector2D(Directions[GhostIndex]) * ViewportSize), WrapDirectionToTag(Directions[GhostIndex]));
+	}
+}
+
+
+void FAsteroids::GetCollisionCandidates(const FBox2d& Bounds, bool bUseGrid, TArray<FAsteroidCandidate>& OutCandidates) const
+{
+	if(bUseGrid)
+	{
+		check(bGridIsCurrent);
+
+		QueryGrid(Grid, Bounds, OutCandidates);
+		return;
+	}
+
+	OutCandidates.Reset();
+
+	for(int32 Index = 0; Index < Asteroids.Num(); Index++)
+	{
+		FVector2D Offsets[Daylon::MaxWrapOffsets];
+
+		const int32 NumOffsets = Daylon::GetWrapOffsets(Asteroids[Index]->GetCollisionBounds(), Bounds, ViewportSize, Offsets);
+
+		for(int32 OffsetIndex = 0; OffsetIndex < NumOffsets; OffsetIndex++)
+		{
+			OutCandidates.Add({ Index, Offsets[OffsetIndex] });
+		}
+	}
+
+	SortCandidates(OutCandidates);
+}
+
+
+void FAsteroids::QueryGrid(const Daylon::FUniformGrid2D& InGrid, const FBox2d& Bounds, TArray<FAsteroidCandidate>& OutCandidates)
+{
+	OutCandidates.Reset();
+
+	// Look up the object itself and, if it's in the edge band, its wrapped copies.
+
+	FIntPoint OtherDirections[Daylon::MaxWrapGhosts + 1] = { FIntPoint(0, 0) };
+
+	const int32 NumOtherDirections = 1 + Daylon::GetWrapGhostDirections(Bounds, ViewportSize, &OtherDirections[1]);
+
+	for(int32 DirectionIndex = 0; DirectionIndex < NumOtherDirections; DirectionIndex++)
+	{
+		const FIntPoint OtherDirection = OtherDirections[DirectionIndex];
+
+		InGrid.ForEachEntry(Bounds.ShiftBy(FVector2D(OtherDirection) * ViewportSize), [&OutCandidates, &OtherDirection](const Daylon::FUniformGrid2D::FEntry& Entry)
+		{
+			OutCandidates.Add({ Entry.Id, FVector2D(TagToWrapDirection(Entry.Tag) - OtherDirection) * ViewportSize });
+		});
+	}
+
+	SortCandidates(OutCandidates);
+}
+
+
+void FAsteroids::SortCandidates(TArray<FAsteroidCandidate>& Candidates)
+{
+	// Order by index so the grid and brute force paths visit rocks in the same order, and drop duplicates
+	// (rocks spanning several cells are found more than once).
+
+	Candidates.Sort();
+
+	int32 NumUnique = 0;
+
+	for(int32 Index = 0; Index < Candidates.Num(); Index++)
+	{
+		if(NumUnique == 0 || !(Candidates[Index] == Candidates[NumUnique - 1]))
+		{
+			Candidates[NumUnique++] = Candidates[Index];
 		}
 	}
+
+	Candidates.SetNum(NumUnique, false);
 }
 
 
@@ -76,18 +323,18 @@ void FAsteroids::Kill(int32 AsteroidIndex, bool KilledByPlayer)
 
 	if(KilledByPlayer)
 	{
-		Arena->IncreasePlayerScoreBy(Asteroid.Value);
+		Arena->IncreasePlayerScoreBy(Asteroid.GetValue());
 	}
 
-	Arena->GetExplosions().SpawnOne(Asteroid.UnwrappedNewPosition, Asteroid.Inertia);
+	Arena->GetExplosions().SpawnOne(Asteroid.GetUnwrappedNewPosition(), Asteroid.GetInertia());
 
 	int32 SoundIndex = 0;
 	
-	if(Asteroid.Value == ValueMediumAsteroid)
+	if(Asteroid.GetValue() == ValueMediumAsteroid)
 	{
 		SoundIndex = 1;
 	}
-	else if(Asteroid.Value == ValueSmallAsteroid)
+	else if(Asteroid.GetValue() == ValueSmallAsteroid)
 	{
 		SoundIndex = 2;
 	}
@@ -96,18 +343,18 @@ void FAsteroids::Kill(int32 AsteroidIndex, bool KilledByPlayer)
 
 
 	// If asteroid was small, just delete it.
-	if(Asteroid.Value == ValueSmallAsteroid)
+	if(Asteroid.GetValue() == ValueSmallAsteroid)
 	{
 		// Release any powerup the asteroid was holding.
 
 		if(Asteroid.HasPowerup())
 		{
-			auto PowerupIndex = Arena->GetPowerups().Add(Asteroid.Powerup);
+			auto PowerupIndex = Arena->AddPowerup(Asteroid.Powerup);
 			Asteroid.Powerup.Reset();
 
 			if(PowerupsCanMove)
 			{
-				Arena->GetPowerups()[PowerupIndex]->Inertia = Asteroid.Inertia;
+				Arena->GetPowerups()[PowerupIndex]->SetInertia(Asteroid.GetInertia());
 			}
 		}
 
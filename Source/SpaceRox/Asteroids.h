@@ -8,12 +8,74 @@
 #include "CoreMinimal.h"
 #include "Asteroid.h"
 #include "Constants.h"
+#include "DaylonSpatialGrid.h"
+#include "DaylonPlayObjectStore.h"
+#include "DaylonPlayObjectPool.h"
 
 
 class UPlayViewBase;
 class IArena;
 
 
+// Grid tags record which way a rock's box was displaced by wrapping; the unwrapped rock is (0, 0).
+
+inline int32 WrapDirectionToTag(const FIntPoint& Direction)
+{
+	return (Direction.X + 1) + 3 * (Direction.Y + 1);
+}
+
+
+inline FIntPoint TagToWrapDirection(int32 Tag)
+{
+	return FIntPoint(Tag % 3 - 1, Tag / 3 - 1);
+}
+
+
+struct FAsteroidCandidate
+{
+	// An asteroid that may be touching something, and the translation to add to its positions
+	// to test it where it appears across a viewport wrap seam (zero if it doesn't need wrapping).
+
+	int32     Index;
+	FVector2D Offset;
+
+	bool operator == (const FAsteroidCandidate& Other) const { return (Index == Other.Index && Offset == Other.Offset); }
+
+	bool operator < (const FAsteroidCandidate& Other) const
+	{
+		if(Index != Other.Index)
+		{
+			return (Index < Other.Index);
+		}
+
+		return (Offset.X < Other.Offset.X || (Offset.X == Other.Offset.X && Offset.Y < Other.Offset.Y));
+	}
+};
+
+
+struct FAsteroidBodies
+{
+	// What rock-vs-rock collisions need from each rock, copied out of the rocks
+	// so the solver doesn't touch their widgets (and can be benchmarked without any).
+
+	TArray<FVector2D>  Positions;
+	TArray<FVector2D>  Inertias;
+	TArray<float>      Radii;
+	TArray<float>      Masses;
+
+	int32 Num   () const { return Positions.Num(); }
+	void  Reset ()       { Positions.Reset(); Inertias.Reset(); Radii.Reset(); Masses.Reset(); }
+
+	void Add(const FVector2D& P, const FVector2D& Inertia, float Radius, float Mass)
+	{
+		Positions.Add(P);
+		Inertias .Add(Inertia);
+		Radii    .Add(Radius);
+		Masses   .Add(Mass);
+	}
+};
+
+
 class FAsteroids
 {
 	public:
@@ -22,21 +84,74 @@ class FAsteroids
 
 		TArray<TSharedPtr<FAsteroid>>     Asteroids;
 
+		// Where FAsteroid::Spawn gets rocks from; Remove puts them back.
+		Daylon::TPlayObjectPool<FAsteroid> Pool;
+
+		// Opt-in: the original game lets rocks pass through each other.
+		bool                              bCollideWithEachOther = false;
+
 		FAsteroids()
 		{
-			Asteroids.Reserve(MaxInitialAsteroids * 4);
+			Asteroids .Reserve(MaxInitialAsteroids * 4);
+			Components.Reserve(MaxInitialAsteroids * 4);
+			Grid    .Init(FBox2d(FVector2D(0), ViewportSize), CollisionGridCellSize);
+			BodyGrid.Init(FBox2d(FVector2D(0), ViewportSize), CollisionGridCellSize);
 		}
 
-		void              Add        (TSharedPtr<FAsteroid> AsteroidPtr) { Asteroids.Add(AsteroidPtr); }
+		void              Add        (TSharedPtr<FAsteroid> AsteroidPtr);
 		bool              IsEmpty    () const { return Asteroids.IsEmpty(); }
 		int32             Num        () const { return Asteroids.Num(); }
 
 		FAsteroid&        Get        (int32 Index) { return *Asteroids[Index].Get(); }
 		const FAsteroid&  Get        (int32 Index) const { return *Asteroids[Index].Get(); }
 
+		// The rocks' components, indexed like Asteroids.
+		const Daylon::FPlayObjectStore&  GetComponents () const { return Components; }
+
 		void              Remove     (int32 Index);
 		void              RemoveAll  ();
 
 		void              Update     (float DeltaTime);
 		void              Kill       (int32 Index, bool KilledByPlayer);
+
+		// Collision broadphase. RebuildGrid() should be called once per frame after the rocks have moved.
+		// Until the next Update(), Add/Remove/Kill keep the grid in step with the array, so indices 
+		// returned by GetCollisionCandidates() are always valid asteroid indices.
+		// Rocks poking past a viewport edge are also registered where their wrapped copies appear.
+		void              RebuildGrid            ();
+
+		// Returns the asteroids that might touch an object occupying Bounds, sorted by index.
+		// Without the grid every asteroid is returned, along with any wrap offsets it needs.
+		void              GetCollisionCandidates (const FBox2d& Bounds, bool bUseGrid, TArray<FAsteroidCandidate>& OutCandidates) const;
+
+		static float      GetMass                (int32 Value);
+
+		// The grid half of the broadphase, for callers keeping rocks outside an FAsteroids (e.g. FSimWorld).
+		// AddToGrid registers Bounds and its wrapped copies under Index; QueryGrid returns what
+		// GetCollisionCandidates() does with bUseGrid set.
+		static void       AddToGrid              (Daylon::FUniformGrid2D& InGrid, int32 Index, const FBox2d& Bounds);
+		static void       QueryGrid              (const Daylon::FUniformGrid2D& InGrid, const FBox2d& Bounds, TArray<FAsteroidCandidate>& OutCandidates);
+
+		// Bounces touching rocks off each other, rebuilding BodyGrid from the bodies to find them.
+		// Each touching pair is visited once, in index order, so results don't vary between runs.
+		// Rocks touching across a viewport wrap seam count too. Returns the number of bounces.
+		static int32      CollideBodies          (FAsteroidBodies& Bodies, Daylon::FUniformGrid2D& BodyGrid, TArray<Daylon::FUniformGrid2D::FEntry>& Neighbors);
+
+
+	protected:
+
+		Daylon::FPlayObjectStore  Components;
+
+		Daylon::FUniformGrid2D  Grid;
+		bool                    bGridIsCurrent = false;
+
+		// Rock-vs-rock scratch, see CollideWithEachOther().
+		Daylon::FUniformGrid2D                  BodyGrid;
+		FAsteroidBodies                         Bodies;
+		TArray<Daylon::FUniformGrid2D::FEntry>  BodyNeighbors;
+
+		void              AddToGrid              (int32 Index) { AddToGrid(Grid, Index, Asteroids[Index]->GetCollisionBounds()); }
+		void              CollideWithEachOther   ();
+
+		static void       SortCandidates         (TArray<FAsteroidCandidate>& Candidates);
 };
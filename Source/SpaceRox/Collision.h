@@ -0,0 +1,333 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+// SpaceRox - an Atari Asteroids clone developed with Unreal Engine.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DaylonGeometry.h"
+#include "Asteroids.h"
+
+
+// Collisions are handled in two phases. Detection only reads the play objects and
+// records what touched what as contacts; resolution then walks the contacts in order
+// and applies their kills, score changes, sounds, shield damage, etc.
+//
+// Contacts are listed grouped by the object doing the hitting, in the order the checks
+// used to run in: torpedos first, then scavengers vs. powerups, then the player ship,
+// then enemies vs. rocks. An object hit by one contact is consumed, and later contacts
+// involving it are skipped. Like the old "break" out of each loop, a subject only
+// resolves its first valid contact of a given kind.
+//
+// Detection is split into work items (each torpedo, the player ship, each enemy vs. rocks, etc.)
+// which can run on several threads. Each thread handles a contiguous run of items into its own
+// list, and the lists are appended in item order, so the contacts come out the same
+// regardless of how many threads were used.
+//
+// Objects are named by their array indices at detection time. Nothing is removed from
+// (or split into) those arrays until every contact has been resolved, so the indices
+// stay valid throughout.
+
+enum class ECollisionKind : uint8
+{
+	TorpedoAsteroid = 0,
+	TorpedoPlayerShip,
+	TorpedoEnemyShip,
+	TorpedoScavenger,
+	TorpedoBoss,
+	ScavengerPowerup,
+	PlayerShipAsteroid,
+	PlayerShipEnemyShip,
+	PlayerShipScavenger,
+	PlayerShipBoss,
+	PlayerShipPowerup,
+	EnemyShipAsteroid,
+	ScavengerAsteroid,
+	BossAsteroid,
+
+	Count
+};
+
+
+struct FCollisionContact
+{
+	ECollisionKind Kind;
+	int32          Subject;                         // Index of the object doing the hitting, INDEX_NONE for the player ship
+	int32          Other;                           // Index of the object being hit, INDEX_NONE for the player ship
+	FVector2D      Offset;                          // Wrap offset the other object (or the boss) was tested at
+
+	// Boss contacts only.
+	int32          Part               = INDEX_NONE; // 0 = boss body, otherwise a shield
+	int32          ShieldSegmentIndex = INDEX_NONE;
+	FVector2D      HitPt              = FVector2D(0);
+};
+
+
+inline FCollisionContact& AddCollisionContact(TArray<FCollisionContact>& Contacts, ECollisionKind Kind, int32 Subject, int32 Other, const FVector2D& Offset = FVector2D(0))
+{
+	auto& Contact = Contacts.AddDefaulted_GetRef();
+
+	Contact.Kind    = Kind;
+	Contact.Subject = Subject;
+	Contact.Other   = Other;
+	Contact.Offset  = Offset;
+
+	return Contact;
+}
+
+
+inline FBox2d MakeSweptBounds(const FVector2D& P1, const FVector2D& P2, double Radius)
+{
+	// Box enclosing a circle of Radius moving from P1 to P2.
+
+	FBox2d Bounds(ForceInit);
+
+	Bounds += P1;
+	Bounds += P2;
+
+	return Bounds.ExpandBy(Radius + CollisionGridPadding);
+}
+
+
+inline const TCHAR* GetCollisionKindName(ECollisionKind Kind)
+{
+	static const TCHAR* Names[] =
+	{
+		TEXT("Torpedo vs. rock"),
+		TEXT("Torpedo vs. player ship"),
+		TEXT("Torpedo vs. enemy ship"),
+		TEXT("Torpedo vs. scavenger"),
+		TEXT("Torpedo vs. boss"),
+		TEXT("Scavenger vs. powerup"),
+		TEXT("Player ship vs. rock"),
+		TEXT("Player ship vs. enemy ship"),
+		TEXT("Player ship vs. scavenger"),
+		TEXT("Player ship vs. boss"),
+		TEXT("Player ship vs. powerup"),
+		TEXT("Enemy ship vs. rock"),
+		TEXT("Scavenger vs. rock"),
+		TEXT("Boss vs. rock")
+	};
+
+	static_assert(UE_ARRAY_COUNT(Names) == (int32)ECollisionKind::Count, "Collision kind names out of sync");
+
+	return Names[(int32)Kind];
+}
+
+
+struct FCollisionStats
+{
+	// Per-frame pair test counts, hits and time for each kind of collision.
+	// Times add up the cycles spent on every thread.
+
+	int32   Tests  [(int32)ECollisionKind::Count];
+	int32   Hits   [(int32)ECollisionKind::Count];
+	uint64  Cycles [(int32)ECollisionKind::Count];
+
+	FCollisionStats() { Reset(); }
+
+	void Reset()
+	{
+		FMemory::Memzero(Tests);
+		FMemory::Memzero(Hits);
+		FMemory::Memzero(Cycles);
+	}
+
+	void CountTests(ECollisionKind Kind, int32 Count = 1) { Tests[(int32)Kind] += Count; }
+
+	void Accumulate(const FCollisionStats& Other)
+	{
+		for(int32 Index = 0; Index < (int32)ECollisionKind::Count; Index++)
+		{
+			Tests [Index] += Other.Tests [Index];
+			Hits  [Index] += Other.Hits  [Index];
+			Cycles[Index] += Other.Cycles[Index];
+		}
+	}
+};
+
+
+struct FCollisionStatScope
+{
+	// Adds the time spent in a scope to a collision kind's total.
+
+	FCollisionStats& Stats;
+	ECollisionKind   Kind;
+	uint64           StartCycles;
+
+	FCollisionStatScope(FCollisionStats& InStats, ECollisionKind InKind) : Stats(InStats), Kind(InKind), StartCycles(FPlatformTime::Cycles64()) {}
+	~FCollisionStatScope() { Stats.Cycles[(int32)Kind] += FPlatformTime::Cycles64() - StartCycles; }
+};
+
+
+struct FCollisionDebugShape
+{
+	// A shape tested during detection, for the collision overlay.
+	// A zero radius means a line from P1 to P2, otherwise a circle centered on P1.
+
+	FVector2D  P1;
+	FVector2D  P2;
+	double     Radius;
+	bool       Hit;
+};
+
+
+struct FPlayerShipCollisionShape
+{
+	// The player ship as the detection phase sees it.
+
+	bool       IsPresent = false;
+	FVector2D  Triangle[3];      // tip, LR corner, LL corner.
+	FVector2D  LineStart;
+	FVector2D  LineEnd;
+	float      Radius    = 0.0f;
+	FBox2d     Bounds    = FBox2d(ForceInit);
+};
+
+
+inline FPlayerShipCollisionShape MakePlayerShipCollisionShape(const Daylon::FMotionComponent& Motion, const Daylon::FCollisionComponent& Collision)
+{
+	FPlayerShipCollisionShape Shape;
+
+	Shape.IsPresent = true;
+
+	// Build a triangle representing the player ship.
+
+	float PlayerShipH = Collision.Size.Y;
+	float PlayerShipW = PlayerShipH * (73.0f / 95.0f);
+
+	Shape.Triangle[0].Set(0.0f,            -PlayerShipH / 2);
+	Shape.Triangle[1].Set( PlayerShipW / 2, PlayerShipH / 2);
+	Shape.Triangle[2].Set(-PlayerShipW / 2, PlayerShipH / 2);
+
+	// Triangle is pointing up, vertices relative to its center. We need to rotate it for its current angle.
+	// Rotate and translate the triangle to match its current display space.
+
+	for(auto& Triangle : Shape.Triangle)
+	{
+		Triangle = Daylon::Rotate(Triangle, Motion.Angle);
+
+		// Use the ship's old position because the current position can cause unwanted self-intersections.
+		Triangle += Motion.OldPosition;
+	}
+
+	// Get the line segment for the player ship.
+	// Line segments are used to better detect collisions involving fast-moving objects.
+
+	Shape.LineStart = Motion.OldPosition;
+	Shape.LineEnd   = Motion.UnwrappedNewPosition;
+	Shape.Radius    = Collision.GetRadius();
+
+	Shape.Bounds = MakeSweptBounds(Shape.LineStart, Shape.LineEnd, Shape.Radius);
+
+	for(const auto& Vertex : Shape.Triangle)
+	{
+		Shape.Bounds += Vertex;
+	}
+
+	return Shape;
+}
+
+
+inline bool DoesPlayerShipHitAsteroid(const FPlayerShipCollisionShape& PlayerShipShape, const Daylon::FMotionComponent& Asteroid, float AsteroidRadius, const FVector2D& Offset)
+{
+	// The ship's path against the rock grown by the ship's radius, or the rock's path against the ship's triangle.
+	// Offset is the rock's wrap offset, see FAsteroidCandidate.
+
+	return (Daylon::DoesLineSegmentIntersectCircle(PlayerShipShape.LineStart, PlayerShipShape.LineEnd, Asteroid.Position + Offset, AsteroidRadius + PlayerShipShape.Radius)
+		|| Daylon::DoesLineSegmentIntersectTriangle(Asteroid.OldPosition + Offset, Asteroid.UnwrappedNewPosition + Offset, PlayerShipShape.Triangle));
+}
+
+
+struct FCollisionScratch
+{
+	// Per-worker buffers for the detection phase.
+
+	TArray<FAsteroidCandidate>  AsteroidCandidates;
+	Daylon::FCircleArray        AsteroidCircles;
+	TBitArray<>                 AsteroidHits;
+	TArray<FCollisionContact>   Contacts;
+	FCollisionStats             Stats;
+
+	// Only filled in while the collision overlay is on.
+
+	bool                          RecordShapes = false;
+	TArray<FCollisionDebugShape>  Shapes;
+
+
+	void AddDebugLine(const FVector2D& P1, const FVector2D& P2, bool Hit)
+	{
+		if(RecordShapes)
+		{
+			Shapes.Add({ P1, P2, 0.0, Hit });
+		}
+	}
+
+
+	void AddDebugCircle(const FVector2D& Center, double Radius, bool Hit)
+	{
+		if(RecordShapes)
+		{
+			Shapes.Add({ Center, Center, Radius, Hit });
+		}
+	}
+};
+
+
+inline void DetectTorpedoAsteroidHits(const FVector2D& OldP, const FVector2D& CurrentP, const TArray<Daylon::FMotionComponent>& AsteroidMotion, const TArray<Daylon::FCollisionComponent>& AsteroidCollision, FCollisionScratch& Scratch)
+{
+	// Tests a torpedo's path against Scratch.AsteroidCandidates, setting Scratch.AsteroidHits[N] if it hit candidate N.
+	// The path is tested against every candidate rock in one batch first; rocks it misses
+	// are then checked for having run over the torpedo.
+
+	Scratch.AsteroidCircles.Reset();
+
+	for(const auto& Candidate : Scratch.AsteroidCandidates)
+	{
+		Scratch.AsteroidCircles.Add(AsteroidMotion[Candidate.Index].Position + Candidate.Offset, AsteroidCollision[Candidate.Index].GetRadius());
+	}
+
+	Daylon::DoesLineSegmentIntersectCircles(OldP, CurrentP, Scratch.AsteroidCircles, Scratch.AsteroidHits);
+
+	for(int32 CandidateIndex = 0; CandidateIndex < Scratch.AsteroidCandidates.Num(); CandidateIndex++)
+	{
+		const auto& Candidate = Scratch.AsteroidCandidates[CandidateIndex];
+		const auto& Asteroid  = AsteroidMotion[Candidate.Index];
+
+		if(!Scratch.AsteroidHits[CandidateIndex]
+			&& Daylon::DoesLineSegmentIntersectCircle(Asteroid.OldPosition + Candidate.Offset, Asteroid.UnwrappedNewPosition + Candidate.Offset, OldP, AsteroidCollision[Candidate.Index].GetRadius()))
+		{
+			Scratch.AsteroidHits[CandidateIndex] = true;
+		}
+	}
+}
+
+
+struct FCollisionContacts
+{
+	TArray<FCollisionContact>  Contacts;
+
+	// Filled in during resolution. Bits are indexed like the arrays at detection time.
+
+	TBitArray<>  AsteroidsHit;
+	TBitArray<>  AsteroidsKilledByPlayer;
+	TBitArray<>  EnemyShipsHit;
+	TBitArray<>  ScavengersHit;
+	TBitArray<>  BossesHit;
+	TBitArray<>  PowerupsTaken;
+	TBitArray<>  PowerupsTakenByScavenger;
+
+
+	void Reset(int32 NumAsteroids, int32 NumEnemyShips, int32 NumScavengers, int32 NumBosses, int32 NumPowerups)
+	{
+		Contacts.Reset();
+
+		AsteroidsHit            .Init(false, NumAsteroids);
+		AsteroidsKilledByPlayer .Init(false, NumAsteroids);
+		EnemyShipsHit           .Init(false, NumEnemyShips);
+		ScavengersHit           .Init(false, NumScavengers);
+		BossesHit               .Init(false, NumBosses);
+		PowerupsTaken           .Init(false, NumPowerups);
+		PowerupsTakenByScavenger.Init(false, NumPowerups);
+	}
+};
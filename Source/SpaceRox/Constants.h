@@ -23,6 +23,8 @@ const int32 PlayerShipBonusAt              = 10000;
 const int32 MaxPlayerShipsDisplayable      = 10;      // We don't want the player ships readout to be impractically wide.
 const float MaxTimeUntilNextPlayerShip     =  4.0f;   // Actual time may be longer because of asteroid intersection avoidance.
 							           
+const FVector2D PlayerShipSize             = FVector2D(32);
+const float PlayerShipRadiusFactor         = 0.4f;    // Collision radius as a fraction of the ship's width; its triangle is in MakePlayerShipCollisionShape()
 const float MaxPlayerShipSpeed             = 1000.0f; // px/sec
 const float PlayerThrustForce              = 650.0f;
 const float PlayerRotationSpeed            = 300.0f;  // degrees per second
@@ -32,6 +34,18 @@ const float MaxTorpedoLifeTime             =   1.5f;  // seconds
 const int32 TorpedoCount                   =  30;     // make room for player and enemy torpedos which are in the same array
 								           
 const int32 MaxInitialAsteroids            =  24;
+
+// Play object pools start with this many installed widgets and grow by the chunk size when they run dry.
+const int32 AsteroidPoolSize               = MaxInitialAsteroids * 4; // A big rock ends up as four small ones
+const int32 AsteroidPoolChunkSize          =  16;
+const int32 EnemyShipPoolSize              =   4;
+const int32 ScavengerPoolSize              =   2;
+const int32 PowerupPoolSize                =  16;
+const int32 SmallPoolChunkSize             =   2;
+
+// All explosions share one ring of particles; when it's full, the oldest explosions are dropped.
+const int32 MaxExplosionParticles          = 8192;    // The intro alone can have about 6000 going
+const int32 MaxExplosionBursts             = 256;
 const float MinAsteroidSpeed               =  50.0f;  // px per second
 const float MaxAsteroidSpeed               = 100.0f;  // px per second
 const float MinAsteroidSpinSpeed           = -20.0f;  // degrees per second
@@ -41,6 +55,7 @@ const float MinAsteroidSplitAngle          =  5.0f;   // Children of rock death
 const float MaxAsteroidSplitAngle          = 35.0f;   // Ditto, but this is the max angular deviation, in degrees.
 const float MinAsteroidSplitInertia        =  0.1f;   // Child rock could have as little as this much of parent's inertia.
 const float MaxAsteroidSplitInertia        =  3.0f;   // Ditto, max as much as this.
+const float AsteroidRadiusFactor           =  0.5f;   // A rock's collision radius as a fraction of its width.
 
 // Asteroid masses and inertial impart are used to alter player ship inertia during non-fatal collisions.
 // If you don't like the player ship to bounce around, leave AsteroidInertiaImpart at zero.
@@ -49,6 +64,7 @@ const float MediumAsteroidMass             =  0.3f;
 const float SmallAsteroidMass              =  0.1f;
 const float PlayerShipMass                 = SmallAsteroidMass;
 const float AsteroidInertiaImpart          =  0.25f;   // How much inertia to impart to shielded player ship when hit by asteroid.
+const float AsteroidRestitution            =  1.0f;    // When rocks bounce off each other; 1 = perfectly elastic.
 								           
 const int32 ValueBigAsteroid               =    20;
 const int32 ValueMediumAsteroid            =    50;
@@ -123,6 +139,10 @@ const float BossShieldSpinSpeed            = 100.0f; // degrees/sec
 
 const float PlayerShipSecondExplosionDelay = 0.66f;
 
+const float CollisionGridCellSize          = 128.0f; // px; roughly a big rock's diameter so most rocks touch only a few cells.
+const float CollisionGridPadding           =   1.0f; // px added to broadphase boxes so float rounding can't drop a touching pair.
+const int32 MinCollisionWorkItemsPerThread =   4;    // Collision detection only spreads across threads when each gets at least this many objects.
+
 const FDaylonParticlesParams IntroExplosionParams =
 {
 	4.5f,   // MinParticleSize
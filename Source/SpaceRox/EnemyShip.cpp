@@ -21,37 +21,48 @@
 #endif
 
 
-static FVector2D GetFiringAngle(float TorpedoSpeed, const FVector2D& P, const FVector2D& TargetP, const FVector2D& TargetInertia, float Quality)
+static FVector2D GetFiringAngle(Daylon::FRng& Rng, float TorpedoSpeed, const FVector2D& P, const FVector2D& TargetP, const FVector2D& TargetInertia, float Quality)
 {
 	auto DirectionToTarget = TargetP - P;
 	DirectionToTarget.Normalize();
 
 	// The random direction has to be away from us. It can vary by -90 to +90 degrees from DirectionToTarget.
 	const auto AngleToTarget = Daylon::Vector2DToAngle(DirectionToTarget);
-	const auto RandomAngle   = AngleToTarget + Daylon::FRandRange(-90.0f, 90.0f);
+	const auto RandomAngle   = AngleToTarget + Rng.FRandRange(-90.0f, 90.0f);
 
-	const auto PerfectDirection = Daylon::ComputeFiringSolution(P, TorpedoSpeed, TargetP, TargetInertia);
+	const auto PerfectDirection = Daylon::ComputeFiringSolution(Rng, P, TorpedoSpeed, TargetP, TargetInertia);
 	const auto PerfectAngle     = Daylon::Vector2DToAngle(PerfectDirection);
 
 	return Daylon::AngleToVector2D(FMath::Lerp(RandomAngle, PerfectAngle, Quality));
 }
 
 
-TSharedPtr<FEnemyShip> FEnemyShip::Spawn(IArena* InArena, const FDaylonSpriteAtlas& Atlas, int Value, float RadiusFactor)
+TSharedPtr<FEnemyShip> FEnemyShip::CreateWidget()
+{
+	auto Widget = SNew(FEnemyShip);
+
+	Daylon::Install<SDaylonSprite>(Widget, 0.5f);
+
+	return Widget;
+}
+
+
+TSharedPtr<FEnemyShip> FEnemyShip::Spawn(Daylon::TPlayObjectPool<FEnemyShip>& Pool, IArena* InArena, const FDaylonSpriteAtlasHandle& Atlas, int Value, float RadiusFactor)
 {
 	check(InArena);
 
-	auto Widget = SNew(FEnemyShip);
+	auto Widget = Pool.Acquire();
 
-	Daylon::Install<SDaylonSprite>(Widget, RadiusFactor);
+	Widget->ResetForSpawn();
+	Widget->SetRadiusFactor(RadiusFactor);
 
 	Widget->Arena = InArena;
 	Widget->SetAtlas(Atlas);
 	Widget->SetCurrentCel(0);
-	Widget->SetSize(Atlas.GetCelPixelSize());
+	Widget->SetSize(Atlas->GetCelPixelSize());
 	Widget->UpdateWidgetSize();
 
-	Widget->Value = Value;
+	Widget->SetValue(Value);
 
 	return Widget;
 }
@@ -59,8 +70,15 @@ TSharedPtr<FEnemyShip> FEnemyShip::Spawn(IArena* InArena, const FDaylonSpriteAtl
 
 FEnemyShip::FEnemyShip()
 {
-	TimeRemainingToNextShot = (Value == ValueBigEnemy ? BigEnemyReloadTime : SmallEnemyReloadTime);
+	ResetForSpawn();
+}
+
+
+void FEnemyShip::ResetForSpawn()
+{
+	TimeRemainingToNextShot = (GetValue() == ValueBigEnemy ? BigEnemyReloadTime : SmallEnemyReloadTime);
 	TimeRemainingToNextMove = 3.0f;
+	bShootAtPlayer          = false;
 }
 
 
@@ -68,9 +86,9 @@ void FEnemyShip::Perform(float DeltaTime)
 {
 	// Don't call Super::Update(DeltaTime) because we are a static sprite.
 
-	const bool WereBig = (Value == ValueBigEnemy);
+	const bool WereBig = (GetValue() == ValueBigEnemy);
 
-	Move(DeltaTime, Arena->GetWrapPositionFunction());
+	Move(DeltaTime, GetViewportWrap());
 
 
 	// Fire a torpedo if we've finished reloading.
@@ -87,7 +105,7 @@ void FEnemyShip::Perform(float DeltaTime)
 
 	if(TimeRemainingToNextMove <= 0.0f)
 	{
-		TimeRemainingToNextMove = Daylon::FRandRange(MinTimeTilNextEnemyShipMove, MaxTimeTilNextEnemyShipMove);
+		TimeRemainingToNextMove = Arena->GetRng(ERngStream::Enemies).FRandRange(MinTimeTilNextEnemyShipMove, MaxTimeTilNextEnemyShipMove);
 
 		// Change heading (or stay on current heading).
 
@@ -98,10 +116,12 @@ void FEnemyShip::Perform(float DeltaTime)
 			{ 1, -1 }
 		};
 
-		FVector2D NewHeading = Headings[FMath::RandRange(0, 2)];
+		FVector2D NewHeading = Headings[Arena->GetRng(ERngStream::Enemies).RandRange(0, 2)];
 
 		NewHeading.Normalize();
 
+		auto& Inertia = GetMotion().Inertia;
+
 		const auto Facing = FMath::Sign(Inertia.X);
 		Inertia = NewHeading * Inertia.Length();
 		Inertia.X *= Facing;
@@ -134,9 +154,9 @@ void FEnemyShip::Shoot()
 	float     Speed;
 
 	// Position torpedo a little outside the ship.
-	auto LaunchP = OldPosition;
+	auto LaunchP = GetOldPosition();
 
-	const bool WereBig = (Value == ValueBigEnemy);
+	const bool WereBig = (GetValue() == ValueBigEnemy);
 
 	if(WereBig)
 	{
@@ -144,7 +164,7 @@ void FEnemyShip::Shoot()
 
 		const float Aim = FMath::Clamp(Daylon::Normalize(Arena->GetPlayerScore(), ScoreForBigEnemyAimWorst, ScoreForBigEnemyAimPerfect), 0.0f, 1.0f);
 
-		Direction = GetFiringAngle(Speed, LaunchP, Arena->GetPlayerShip().GetPosition(), Arena->GetPlayerShip().Inertia, Aim);
+		Direction = GetFiringAngle(Arena->GetRng(ERngStream::Enemies), Speed, LaunchP, Arena->GetPlayerShip().GetPosition(), Arena->GetPlayerShip().GetInertia(), Aim);
 
 		// Shift the launch point outside the ship. This will screw up perfect aims but they will still be close enough to rattle the player.
 		LaunchP += Direction * (GetSize().X / 2 + 2);
@@ -167,13 +187,15 @@ void FEnemyShip::Shoot()
 		{
 			const float Aim = FMath::Clamp(Daylon::Normalize(Arena->GetPlayerScore(), ScoreForSmallEnemyAimWorst, ScoreForSmallEnemyAimPerfect), 0.0f, 1.0f);
 
-			Direction = GetFiringAngle(Speed, LaunchP, Arena->GetPlayerShip().GetPosition(), Arena->GetPlayerShip().Inertia, Aim);
+			Direction = GetFiringAngle(Arena->GetRng(ERngStream::Enemies), Speed, LaunchP, Arena->GetPlayerShip().GetPosition(), Arena->GetPlayerShip().GetInertia(), Aim);
 		}
 		else
 		{
 			// Shoot at an asteroid.
-			const auto& Asteroid = Arena->GetAsteroids().Get(FMath::RandRange(0, Arena->GetAsteroids().Num() - 1));
-			Direction = Daylon::ComputeFiringSolution(LaunchP, Speed, Asteroid.GetPosition(), Asteroid.Inertia);
+			auto& Rng = Arena->GetRng(ERngStream::Enemies);
+
+			const auto& Asteroid = Arena->GetAsteroids().Get(Rng.RandRange(0, Arena->GetAsteroids().Num() - 1));
+			Direction = Daylon::ComputeFiringSolution(Rng, LaunchP, Speed, Asteroid.GetPosition(), Asteroid.GetInertia());
 		}
 	}
 
@@ -186,7 +208,7 @@ void FEnemyShip::Shoot()
 // ------------------------------------------------------------------------------------------------------------------
 
 
-TSharedPtr<FEnemyBoss> FEnemyBoss::Spawn(IArena* InArena, const FDaylonSpriteAtlas& Atlas, float S, int32 Value, int32 NumShields, float SpinSpeed)
+TSharedPtr<FEnemyBoss> FEnemyBoss::Spawn(IArena* InArena, const FDaylonSpriteAtlasHandle& Atlas, float S, int32 Value, int32 NumShields, float SpinSpeed)
 {
 	check(InArena);
 	check(NumShields > 0);
@@ -195,7 +217,7 @@ TSharedPtr<FEnemyBoss> FEnemyBoss::Spawn(IArena* InArena, const FDaylonSpriteAtl
 	auto Widget = SNew(FEnemyBoss);
 
 	Widget->Arena = InArena;
-	Widget->Value = Value;
+	Widget->SetValue(Value);
 
 	auto SlotSprite = Widget->AddSlot();
 	Widget->SpriteSlot = SlotSprite.GetSlot();
@@ -210,7 +232,7 @@ TSharedPtr<FEnemyBoss> FEnemyBoss::Spawn(IArena* InArena, const FDaylonSpriteAtl
 	Widget->NumShields = NumShields;
 		
 
-	bool ShieldSpinDir = FMath::RandBool();
+	bool ShieldSpinDir = InArena->GetRng(ERngStream::Enemies).RandBool();
 
 	for(int32 Index = 0; Index < NumShields; Index++, ShieldSpinDir = !ShieldSpinDir)
 	{
@@ -338,6 +360,21 @@ int32 FEnemyBoss::CheckCollision(const FVector2D& P1, const FVector2D &P2, float
 }
 
 
+float FEnemyBoss::GetCollisionRadius() const
+{
+	// Radius of a circle enclosing the boss and all of its shields.
+
+	float Radius = FMath::Max(GetRadius(), Sprite->GetSize().X / 2);
+
+	for(const auto& ShieldPtr : Shields)
+	{
+		Radius = FMath::Max(Radius, ShieldPtr->GetSize().X / 2 + ShieldPtr->GetThickness());
+	}
+
+	return Radius;
+}
+
+
 float FEnemyBoss::GetShieldThickness() const
 {
 	check(!Shields.IsEmpty());
@@ -393,23 +430,25 @@ void FEnemyBoss::Perform(float DeltaTime)
 	{
 		// Alter heading by some random vector.
 
-		TimeRemainingToNextMove = Daylon::FRandRange(2.0f, 3.0f);
+		auto& Rng = Arena->GetRng(ERngStream::Enemies);
+
+		TimeRemainingToNextMove = Rng.FRandRange(2.0f, 3.0f);
 
 		// Make new direction not differ so much from current direction.
-		const auto OldAngle = Daylon::Vector2DToAngle(Inertia);
-		const auto NewAngle = OldAngle + Daylon::FRandRange(-70.0f, 70.0f);
+		const auto OldAngle = Daylon::Vector2DToAngle(GetInertia());
+		const auto NewAngle = OldAngle + Rng.FRandRange(-70.0f, 70.0f);
 
-		Inertia = Daylon::AngleToVector2D(NewAngle) * GetSpeed();
+		SetInertia(Daylon::AngleToVector2D(NewAngle) * GetSpeed());
 	}
 
-	Move(DeltaTime, Arena->GetWrapPositionFunction());
+	Move(DeltaTime, GetViewportWrap());
 
 
 	TimeRemainingToNextShot -= DeltaTime;
 
 	if(TimeRemainingToNextShot <= 0.0f)
 	{
-		TimeRemainingToNextShot = Daylon::FRandRange(1.0f, 2.0f);
+		TimeRemainingToNextShot = Arena->GetRng(ERngStream::Enemies).FRandRange(1.0f, 2.0f);
 		Shoot();
 	}
 }
@@ -444,7 +483,7 @@ void FEnemyBoss::Shoot()
 	const auto FiringPoint = Arena->WrapPosition(GetPosition() + DirectionToPlayer * (Shields.Last(0)->GetSize().X / 2 + 10.0f));
 	const float Aim = FMath::Min(1.0f, Daylon::Normalize(Arena->GetPlayerScore(), ScoreForBossSpawn, ScoreForBossAimPerfect));
 
-	const auto Direction = GetFiringAngle(BossTorpedoSpeed, FiringPoint, Arena->GetPlayerShip().GetPosition(), Arena->GetPlayerShip().Inertia, Aim);
+	const auto Direction = GetFiringAngle(Arena->GetRng(ERngStream::Enemies), BossTorpedoSpeed, FiringPoint, Arena->GetPlayerShip().GetPosition(), Arena->GetPlayerShip().GetInertia(), Aim);
 
 	Torpedo.Start(FiringPoint, Direction * BossTorpedoSpeed, MaxTorpedoLifeTime);
 
@@ -23,10 +23,14 @@ class FEnemyShip : public FPlayObject
 	bool  bShootAtPlayer          = false;
 
 
-	static TSharedPtr<FEnemyShip> Spawn(IArena* InArena, const FDaylonSpriteAtlas& Atlas, int Value, float RadiusFactor);
+	static TSharedPtr<FEnemyShip> Spawn        (Daylon::TPlayObjectPool<FEnemyShip>& Pool, IArena* InArena, const FDaylonSpriteAtlasHandle& Atlas, int Value, float RadiusFactor);
+	static TSharedPtr<FEnemyShip> CreateWidget ();
 
 	FEnemyShip();
 
+	// Puts back what the constructor set up, for ships reused from a pool.
+	void  ResetForSpawn ();
+
 	void  Perform  (float DeltaTime);
 	void  Shoot    ();
 };
@@ -50,7 +54,7 @@ class FEnemyBoss : public Daylon::PlayObject2D<SOverlay>
 	TArray<TSharedPtr<SDaylonPolyShield>> Shields;
 	TArray<FOverlaySlot*>                 ShieldSlots;
 
-	static TSharedPtr<FEnemyBoss> Spawn(IArena* InArena, const FDaylonSpriteAtlas& Atlas, float S, int32 Value, int32 NumShields, float SpinSpeed = 100.0f);
+	static TSharedPtr<FEnemyBoss> Spawn(IArena* InArena, const FDaylonSpriteAtlasHandle& Atlas, float S, int32 Value, int32 NumShields, float SpinSpeed = 100.0f);
 
 	void   Update                    (float DeltaTime);
 	int32  CheckCollision            (const FVector2D& P1, const FVector2D &P2, int32& ShieldSegmentIndex) const;
@@ -59,6 +63,7 @@ class FEnemyBoss : public Daylon::PlayObject2D<SOverlay>
 	void   SetShieldSegmentHealth    (int32 ShieldNumber, int32 SegmentIndex, float Health);
 	void   GetShieldSegmentGeometry  (int32 ShieldNumber, int32 SegmentIndex, FVector2D& P1, FVector2D& P2) const;
 	float  GetShieldThickness        () const;
+	float  GetCollisionRadius        () const;
 	void   Perform                   (float DeltaTime);
 	void   Shoot                     ();
 };
@@ -8,6 +8,7 @@
 #include "DaylonGeometry.h"
 #include "DaylonRNG.h"
 #include "DaylonAudio.h"
+#include "DaylonTask.h"
 
 
 #define FEATURE_MULTIPLE_ENEMIES    1
@@ -29,7 +30,7 @@ void FEnemyShips::RemoveShip(int32 Index)
 
 	auto& Ship = *Ships[Index].Get();
 
-	if(Ship.Value == ValueBigEnemy)
+	if(Ship.GetValue() == ValueBigEnemy)
 	{
 		NumBigEnemyShips--;
 	}
@@ -40,8 +41,9 @@ void FEnemyShips::RemoveShip(int32 Index)
 
 	check(NumBigEnemyShips >= 0 && NumSmallEnemyShips >= 0);
 
-	Daylon::Uninstall(Ships[Index]);
+	ShipPool.Release(Ships[Index]);
 
+	ShipComponents.Release(Index);
 	Ships.RemoveAtSwap(Index);
 }
 
@@ -56,6 +58,7 @@ void FEnemyShips::RemoveBoss(int32 Index)
 
 	Daylon::UninstallImpl(Bosses[Index]);
 
+	BossComponents.Release(Index);
 	Bosses.RemoveAtSwap(Index);
 }
 
@@ -72,11 +75,14 @@ void FEnemyShips::RemoveScavenger(int32 Index)
 
 	for(auto PowerupPtr : Scavenger.AcquiredPowerups)
 	{
-		Daylon::Uninstall(PowerupPtr);
+		Arena->GetPowerupPool().Release(PowerupPtr);
 	}
 
-	Daylon::Uninstall(Scavengers[Index]);
+	Scavenger.AcquiredPowerups.Reset();
 
+	ScavengerPool.Release(Scavengers[Index]);
+
+	ScavengerComponents.Release(Index);
 	Scavengers.RemoveAtSwap(Index);
 }
 
@@ -110,8 +116,8 @@ void FEnemyShips::KillShip(int32 Index)
 
 	auto& Ship = *Ships[Index].Get();
 
-	Arena->GetExplosions().SpawnOne(Ship.GetPosition(), EnemyShipExpolosionParams, Ship.Inertia);
-	Arena->PlaySound(Arena->GetExplosionSound(Ship.Value == ValueBigEnemy ? 0 : 1));
+	Arena->GetExplosions().SpawnOne(Ship.GetPosition(), EnemyShipExpolosionParams, Ship.GetInertia());
+	Arena->PlaySound(Arena->GetExplosionSound(Ship.GetValue() == ValueBigEnemy ? 0 : 1));
 	RemoveShip(Index);
 }
 
@@ -128,7 +134,7 @@ void FEnemyShips::KillBoss(int32 Index)
 
 	// Spawn explosion for the ship at the center.
 
-	Arena->GetExplosions().SpawnOne(Boss.GetPosition(), MiniBossExplosionParams, Boss.Inertia);
+	Arena->GetExplosions().SpawnOne(Boss.GetPosition(), MiniBossExplosionParams, Boss.GetInertia());
 
 	Arena->PlaySound(Arena->GetExplosionSound(0)); // todo: use specific sound
 
@@ -141,6 +147,7 @@ void FEnemyShips::KillBoss(int32 Index)
 	FVector2D                   P1, P2;
 	FDaylonLineParticle         Particle;
 	FDaylonLineParticlesParams  Params2;
+	auto&                       ExplosionRng = Arena->GetRng(ERngStream::Explosions);
 
 	for(auto& ShieldPtr : Boss.Shields)
 	{
@@ -157,7 +164,7 @@ void FEnemyShips::KillBoss(int32 Index)
 			Particle.Color = FLinearColor(Health, Health, Health, 1.0f);
 			Particle.Angle = Daylon::Vector2DToAngle(P2 - P1);
 			Particle.P = (P1 + P2) / 2;
-			Particle.Spin = Daylon::RandRange(0, 7) == 0 ? Daylon::FRandRange(-240.0f, 240.0f) : Daylon::FRandRange(-120.0f, 120.0f);
+			Particle.Spin = ExplosionRng.RandRange(0, 7) == 0 ? ExplosionRng.FRandRange(-240.0f, 240.0f) : ExplosionRng.FRandRange(-120.0f, 120.0f);
 			Particle.Length = (P2 - P1).Length();
 
 			Params2.Particles.Add(Particle);
@@ -171,7 +178,7 @@ void FEnemyShips::KillBoss(int32 Index)
 	Params2.MaxParticleLifetime =  2.5f;
 	Params2.FinalOpacity        = 0.25f;
 	
-	Arena->GetShieldExplosions().SpawnOne(Boss.GetPosition(), Params2, Boss.Inertia);
+	Arena->GetShieldExplosions().SpawnOne(Boss.GetPosition(), Params2, Boss.GetInertia());
 
 	RemoveBoss(Index);
 }
@@ -246,7 +253,7 @@ void FEnemyShips::KillScavenger(int32 Index)
 			//DroppedPowerupPtr->SetPosition(Arena.WrapPositionToViewport(Scavenger.GetPosition() + (Direction * DroppedPowerupPtr->GetRadius() * 2.5f * PowerupIndex)));
 			const FVector2D CircleP = Daylon::AngleToVector2D(Placement.Angle) * PowerupDiameter * Placement.CircleRadius;
 			DroppedPowerupPtr->SetPosition(Arena->WrapPosition(Scavenger.GetPosition() + CircleP));
-			Arena->GetPowerups().Add(DroppedPowerupPtr);
+			Arena->AddPowerup(DroppedPowerupPtr);
 		}
 		Scavenger.AcquiredPowerups.Empty();
 	}
@@ -266,7 +273,7 @@ void FEnemyShips::KillScavenger(int32 Index)
 	Params.FinalOpacity        = 0.25f;
 	Params.NumParticles        = FMath::Lerp(60, 120, ExplosionScale);
 
-	Arena->GetExplosions().SpawnOne(Scavenger.GetPosition(), Params, Scavenger.Inertia);
+	Arena->GetExplosions().SpawnOne(Scavenger.GetPosition(), Params, Scavenger.GetInertia());
 
 	// todo: have scavenger explosion sound
 	Arena->PlaySound(Arena->GetExplosionSound(0));
@@ -285,20 +292,22 @@ void FEnemyShips::SpawnShip()
 	float BigEnemyProbability = pow(FMath::Lerp(1.0f, BigEnemyLowestProbability,  FMath::Min(1.0f, ScoreTmp / 65'000.0f)), 2.0f);
 	BigEnemyProbability = FMath::Max(BigEnemyLowestProbability, BigEnemyProbability);
 
-	const bool IsBigEnemy = (Daylon::FRand() <= BigEnemyProbability);
+	auto& Rng = Arena->GetRng(ERngStream::Enemies);
+
+	const bool IsBigEnemy = (Rng.FRand() <= BigEnemyProbability);
 
-	auto EnemyShipPtr = FEnemyShip::Spawn(Arena,
+	auto EnemyShipPtr = FEnemyShip::Spawn(ShipPool, Arena,
 		IsBigEnemy ? Arena->GetBigEnemyAtlas() : Arena->GetSmallEnemyAtlas(), 
 		IsBigEnemy ? ValueBigEnemy             : ValueSmallEnemy,
 		0.375f);
 
 
 	// Choose a random Y-pos to appear at. Leave room to avoid ship appearing clipped.
-	FVector2D P(0.0, Daylon::FRandRange(EnemyShipPtr->GetSize().Y + 2, ViewportSize.Y - (EnemyShipPtr->GetSize().Y + 2)));
+	FVector2D P(0.0, Rng.FRandRange(EnemyShipPtr->GetSize().Y + 2, ViewportSize.Y - (EnemyShipPtr->GetSize().Y + 2)));
 
-	auto Inertia = FVector2D(1, 0) * Daylon::FRandRange(MinEnemyShipSpeed, MaxEnemyShipSpeed);
+	auto Inertia = FVector2D(1, 0) * Rng.FRandRange(MinEnemyShipSpeed, MaxEnemyShipSpeed);
 
-	if(Daylon::RandBool())
+	if(Rng.RandBool())
 	{
 		Inertia.X *= -1; // make enemy ship travel from right to left.
 		P.X = ViewportSize.X - 1.0f; // avoid immediate removal
@@ -307,6 +316,7 @@ void FEnemyShips::SpawnShip()
 	EnemyShipPtr->Start(Arena->WrapPosition(P), Inertia, 0.0f);
 
 	Ships.Add(EnemyShipPtr);
+	ShipComponents.Adopt(*EnemyShipPtr.Get());
 
 	if(IsBigEnemy)
 	{
@@ -353,7 +363,9 @@ void FEnemyShips::SpawnBoss()
 	float DualShieldProbability = pow(FMath::Lerp(1.0f, 0.1f,  FMath::Min(1.0f, (float)ScoreTmp / ScoreForBossToHaveDualShields)), 2.0f);
 	DualShieldProbability = FMath::Max(0.1f, DualShieldProbability);
 
-	const bool IsDualShielded = (Daylon::FRand() > DualShieldProbability);
+	auto& Rng = Arena->GetRng(ERngStream::Enemies);
+
+	const bool IsDualShielded = (Rng.FRand() > DualShieldProbability);
 
 	const int32 NumShields = IsDualShielded ? 2 : 1;
 
@@ -369,19 +381,20 @@ void FEnemyShips::SpawnBoss()
 
 	FVector2D P(0);
 
-	if(Daylon::RandBool())
+	if(Rng.RandBool())
 	{
-		P.X = Daylon::FRandRange(0.0, ViewportSize.X);
+		P.X = Rng.FRandRange(0.0, ViewportSize.X);
 	}
 	else
 	{
-		P.Y = Daylon::FRandRange(0.0, ViewportSize.Y);
+		P.Y = Rng.FRandRange(0.0, ViewportSize.Y);
 	}
 
 	BossShipPtr->SetPosition(P);
-	BossShipPtr->Inertia = Daylon::RandVector2D() * Daylon::FRandRange(MinMinibossSpeed, MaxMinibossSpeed);
+	BossShipPtr->SetInertia(Daylon::RandVector2D(Rng) * Rng.FRandRange(MinMinibossSpeed, MaxMinibossSpeed));
 
 	Bosses.Add(BossShipPtr);
+	BossComponents.Adopt(*BossShipPtr.Get());
 }
 
 
@@ -391,18 +404,16 @@ void FEnemyShips::Update(float DeltaTime)
 
 	for(int32 ShipIndex = Ships.Num() - 1; ShipIndex >= 0; ShipIndex--)
 	{
-		auto& EnemyShip = GetShip(ShipIndex);
-
 		// If we've reached the opposite side of the viewport, remove us.
-		const auto P2 = Arena->WrapPosition(EnemyShip.UnwrappedNewPosition);
+		const auto& UnwrappedP = ShipComponents.Motion[ShipIndex].UnwrappedNewPosition;
 
-		if(P2.X != EnemyShip.UnwrappedNewPosition.X)
+		if(GetViewportWrap()(UnwrappedP).X != UnwrappedP.X)
 		{
 			RemoveShip(ShipIndex);
 			continue;
 		}
 
-		EnemyShip.Perform(DeltaTime);
+		GetShip(ShipIndex).Perform(DeltaTime);
 	}
 
 #if(FEATURE_MULTIPLE_ENEMIES == 0)
@@ -413,12 +424,12 @@ void FEnemyShips::Update(float DeltaTime)
 		// Time between enemy ship spawns depends on asteroid density (no ships if too many rocks)
 		// and while low density, spawn once every ten seconds down to two seconds depending on player score.
 
-		if(Arena->AdjustTimeUntilNextEnemyShip(-DeltaTime) <= 0.0f)
+		if(Arena->GetEnemyShipCountdown().IsDue())
 		{
 			SpawnShip();
 
 			// Reset the timer.
-			Arena->SetTimeUntilNextEnemyShip(FMath::Lerp(MaxTimeUntilEnemyRespawn, MinTimeUntilEnemyRespawn, (float)FMath::Min(ExpertPlayerScore, Arena->GetPlayerScore()) / ExpertPlayerScore));
+			Arena->GetEnemyShipCountdown().Set(FMath::Lerp(MaxTimeUntilEnemyRespawn, MinTimeUntilEnemyRespawn, (float)FMath::Min(ExpertPlayerScore, Arena->GetPlayerScore()) / ExpertPlayerScore));
 			// score = 10'000 --> 9 seconds
 			//         20'000 --> 8 seconds
 			//         50'000 --> 5 seconds
@@ -444,10 +455,10 @@ void FEnemyShips::Update(float DeltaTime)
 		BossPtr->Perform(DeltaTime);
 	}
 
-	if(Arena->AdjustTimeUntilNextBoss(-DeltaTime) <= 0.0f)
+	if(Arena->GetBossCountdown().IsDue())
 	{
 		SpawnBoss();
-		Arena->SetTimeUntilNextBoss(FMath::Lerp(MaxTimeUntilBossRespawn, MinTimeUntilBossRespawn, (float)FMath::Min(ExpertPlayerScore, Arena->GetPlayerScore()) / ExpertPlayerScore));
+		Arena->GetBossCountdown().Set(FMath::Lerp(MaxTimeUntilBossRespawn, MinTimeUntilBossRespawn, (float)FMath::Min(ExpertPlayerScore, Arena->GetPlayerScore()) / ExpertPlayerScore));
 	}
 
 
@@ -462,7 +473,7 @@ void FEnemyShips::Update(float DeltaTime)
 		if(Scavenger.CurrentTarget.IsValid())
 		{
 			// Keep moving toward target.
-			Scavenger.Move(DeltaTime, Arena->GetWrapPositionFunction());
+			Scavenger.Move(DeltaTime, GetViewportWrap());
 		}
 		else
 		{
@@ -493,26 +504,26 @@ void FEnemyShips::Update(float DeltaTime)
 				Scavenger.CurrentTarget = Arena->GetPowerups()[NearestPowerupIndex];
 
 				// Point the scavenger at the powerup.
-				Scavenger.Inertia = (Arena->GetPowerups()[NearestPowerupIndex].Get()->GetPosition() - Scavenger.GetPosition());
-				Scavenger.Inertia.Normalize();
-				Scavenger.Inertia *= MaxScavengerSpeed;
-				Scavenger.SetAngle(Daylon::Vector2DToAngle(Scavenger.Inertia));
+				auto Direction = (Arena->GetPowerups()[NearestPowerupIndex].Get()->GetPosition() - Scavenger.GetPosition());
+				Direction.Normalize();
+				Scavenger.SetInertia(Direction * MaxScavengerSpeed);
+				Scavenger.SetAngle(Daylon::Vector2DToAngle(Scavenger.GetInertia()));
 			}
 			else
 			{
 				// No target exists and none are available. Just move flat towards edge of sector.
-				if(Scavenger.Inertia.Y != 0)
+				if(Scavenger.GetInertia().Y != 0)
 				{
-					Scavenger.Inertia = FVector2D(Scavenger.XDirection, 0) * MaxScavengerSpeed;
-					Scavenger.SetAngle(Daylon::Vector2DToAngle(Scavenger.Inertia));
+					Scavenger.SetInertia(FVector2D(Scavenger.XDirection, 0) * MaxScavengerSpeed);
+					Scavenger.SetAngle(Daylon::Vector2DToAngle(Scavenger.GetInertia()));
 				}
 
-				Scavenger.Move(DeltaTime, Arena->GetWrapPositionFunction());
+				Scavenger.Move(DeltaTime, GetViewportWrap());
 
 				// If we've reached the opposite side of the viewport, remove us.
-				const auto P2 = Arena->WrapPosition(Scavenger.UnwrappedNewPosition);
+				const auto& UnwrappedP = ScavengerComponents.Motion[ScavengerIndex].UnwrappedNewPosition;
 
-				if(P2.X != Scavenger.UnwrappedNewPosition.X)
+				if(GetViewportWrap()(UnwrappedP).X != UnwrappedP.X)
 				{
 					RemoveScavenger(ScavengerIndex);
 				}
@@ -522,24 +533,32 @@ void FEnemyShips::Update(float DeltaTime)
 
 
 	// If there are no scavengers, spawn one if enough time has passed.
+	// The countdown only runs while there are none.
+
+	auto& ScavengerCountdown = Arena->GetScavengerCountdown();
+
+	ScavengerCountdown.SetPaused(!Scavengers.IsEmpty());
 
 	if(Scavengers.IsEmpty())
 	{
-		if(Arena->AdjustTimeUntilNextScavenger(-DeltaTime) <= 0.0f)
+		if(ScavengerCountdown.IsDue())
 		{
-			Arena->SetTimeUntilNextScavenger(MaxTimeUntilNextScavenger);
+			ScavengerCountdown.Set(MaxTimeUntilNextScavenger);
+
+			auto ScavengerPtr = FScavenger::Create(ScavengerPool, Arena->GetScavengerAtlas(), FVector2D(32));
 
-			auto ScavengerPtr = FScavenger::Create(Arena->GetScavengerAtlas(), FVector2D(32));
+			auto& Rng = Arena->GetRng(ERngStream::Enemies);
 
-			ScavengerPtr->XDirection = (Daylon::RandBool() ? 1 : -1);
+			ScavengerPtr->XDirection = (Rng.RandBool() ? 1 : -1);
 
 			float XStart = (ScavengerPtr->XDirection == 1 ? 0 : ViewportSize.X - 1);
 
-			ScavengerPtr->SetPosition(FVector2D(XStart, Daylon::FRandRange(ViewportSize.Y * 0.1, ViewportSize.Y * 0.9)));
-			ScavengerPtr->Inertia.Set(MaxScavengerSpeed * ScavengerPtr->XDirection, 0);
-			ScavengerPtr->SetAngle(Daylon::Vector2DToAngle(ScavengerPtr->Inertia));
+			ScavengerPtr->SetPosition(FVector2D(XStart, Rng.FRandRange(ViewportSize.Y * 0.1, ViewportSize.Y * 0.9)));
+			ScavengerPtr->SetInertia(FVector2D(MaxScavengerSpeed * ScavengerPtr->XDirection, 0));
+			ScavengerPtr->SetAngle(Daylon::Vector2DToAngle(ScavengerPtr->GetInertia()));
 
 			Scavengers.Add(ScavengerPtr);
+			ScavengerComponents.Adopt(*ScavengerPtr.Get());
 		}
 	}
 
@@ -8,6 +8,7 @@
 #include "CoreMinimal.h"
 #include "EnemyShip.h"
 #include "Scavenger.h"
+#include "DaylonPlayObjectStore.h"
 
 
 class IArena;
@@ -20,6 +21,15 @@ struct FEnemyShips
 	TArray<TSharedPtr<FEnemyBoss>> Bosses;
 	TArray<TSharedPtr<FScavenger>> Scavengers;
 
+	// Components of the above, indexed the same way.
+	Daylon::FPlayObjectStore       ShipComponents;
+	Daylon::FPlayObjectStore       BossComponents;
+	Daylon::FPlayObjectStore       ScavengerComponents;
+
+	// Ships and scavengers come from these and go back when removed. Bosses aren't pooled.
+	Daylon::TPlayObjectPool<FEnemyShip> ShipPool;
+	Daylon::TPlayObjectPool<FScavenger> ScavengerPool;
+
 	int32  NumSmallEnemyShips = 0;
 	int32  NumBigEnemyShips   = 0;
 
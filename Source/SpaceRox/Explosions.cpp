@@ -2,34 +2,21 @@
 #include "Arena.h"
 
 
-TSharedPtr<FExplosion> FExplosion::Create
-(
-	FSlateBrush&                  Brush,
-	const FVector2D&              P,
-	const FDaylonParticlesParams& Params,
-	const FVector2D&              Inertia
-)
+void FExplosions::Install()
 {
-	auto Widget = SNew(FExplosion)
-		.MinParticleSize     (Params.MinParticleSize)
-		.MaxParticleSize     (Params.MaxParticleSize)
-		.MinParticleVelocity (Params.MinParticleVelocity)
-		.MaxParticleVelocity (Params.MaxParticleVelocity)
-		.MinParticleLifetime (Params.MinParticleLifetime)
-		.MaxParticleLifetime (Params.MaxParticleLifetime)
-		.FinalOpacity        (Params.FinalOpacity)
-		.NumParticles        (Params.NumParticles);
-
-	Daylon::Install<SDaylonParticles>(Widget, 0.5f);
-
-	Widget->Inertia = Inertia;
-	Daylon::Show(&Widget.Get());
-	//Widget->SetRenderTransformPivot(FVector2D(0.5f));
-	Widget->SetPosition(P);
-	Widget->UpdateWidgetSize();
-	Widget->SetParticleBrush(Brush);
+	if(Particles)
+	{
+		return;
+	}
 
-	return Widget;
+	check(Arena);
+
+	Particles = SNew(SDaylonParticleSystem).Size(ViewportSize);
+
+	Particles->SetParticleBrush(Arena->GetExplosionParticleBrush());
+	Particles->SetCapacity(MaxExplosionParticles, MaxExplosionBursts);
+
+	Daylon::InstallCanvasOverlay(Particles.ToSharedRef(), ViewportSize);
 }
 
 
@@ -43,36 +30,26 @@ void FExplosions::SpawnOne(const FVector2D& P, const FVector2D& Inertia)
 
 void FExplosions::SpawnOne(const FVector2D& P, const FDaylonParticlesParams& Params, const FVector2D& Inertia)
 {
-	auto ExplosionPtr = FExplosion::Create(Arena->GetExplosionParticleBrush(), P, Params, Inertia * InertialFactor);
+	Install();
 
-	Explosions.Add(ExplosionPtr);
+	Particles->SpawnBurst(P, Inertia * InertialFactor, Params, Arena->GetRng(ERngStream::Explosions));
 }
 
 
-void FExplosions::Update(const TFunction<FVector2D(const FVector2D&)>& WrapFunction, float DeltaTime)
+void FExplosions::Update(const Daylon::FToroidalWrap& Wrap, float DeltaTime)
 {
-	for(int32 Index = Explosions.Num() - 1; Index >= 0; Index--)
+	if(Particles)
 	{
-		auto ExplosionPtr = Explosions[Index];
-
-		ExplosionPtr->Move(DeltaTime, WrapFunction);
-
-		auto Widget = StaticCastSharedPtr<SDaylonParticles>(ExplosionPtr);
-		
-		if(!Widget->Update(DeltaTime))
-		{
-			Daylon::UninstallImpl(ExplosionPtr);
-			Explosions.RemoveAtSwap(Index);
-		}
+		Particles->Update(DeltaTime, Wrap);
 	}
 }
 
 
 void FExplosions::RemoveAll()
 {
-	while(!Explosions.IsEmpty())
+	if(Particles)
 	{
-		Daylon::UninstallImpl(Explosions.Pop());
+		Particles->RemoveAll();
 	}
 }
 
@@ -80,6 +57,7 @@ void FExplosions::RemoveAll()
 
 TSharedPtr<FShieldExplosion> FShieldExplosion::Create
 (
+	Daylon::FRng&                      Rng,
 	const FVector2D&                   P,
 	const FDaylonLineParticlesParams&  Params,
 	const FVector2D&                   Inertia
@@ -89,12 +67,12 @@ TSharedPtr<FShieldExplosion> FShieldExplosion::Create
 
 	Daylon::Install<SDaylonLineParticles>(Widget, 0.5f);
 
-	Widget->Inertia = Inertia;
+	Widget->SetInertia(Inertia);
 	Daylon::Show(&Widget.Get());
 	//Widget->SetRenderTransformPivot(FVector2D(0.5f));
 	Widget->SetPosition(P);
 	Widget->UpdateWidgetSize();
-	Widget->Set(Params);
+	Widget->Set(Params, Rng);
 
 	return Widget;
 }
@@ -107,19 +85,21 @@ void FShieldExplosions::SpawnOne
 	const FVector2D&                   Inertia
 )
 {
-	auto ExplosionPtr = FShieldExplosion::Create(P, Params, Inertia * InertialFactor);
+	check(Arena);
+
+	auto ExplosionPtr = FShieldExplosion::Create(Arena->GetRng(ERngStream::Explosions), P, Params, Inertia * InertialFactor);
 
 	Explosions.Add(ExplosionPtr);
 }
 
 
-void FShieldExplosions::Update(const TFunction<FVector2D(const FVector2D&)>& WrapFunction, float DeltaTime)
+void FShieldExplosions::Update(const Daylon::FToroidalWrap& Wrap, float DeltaTime)
 {
 	for(int32 Index = Explosions.Num() - 1; Index >= 0; Index--)
 	{
 		auto ExplosionPtr = Explosions[Index];
 
-		ExplosionPtr->Move(DeltaTime, WrapFunction);
+		ExplosionPtr->Move(DeltaTime, Wrap);
 
 		auto Widget = StaticCastSharedPtr<SDaylonLineParticles>(ExplosionPtr);
 		
@@ -7,34 +7,31 @@
 
 #include "CoreMinimal.h"
 #include "SDaylonParticles.h"
+#include "SDaylonParticleSystem.h"
 #include "SDaylonLineParticles.h"
 #include "DaylonPlayObject2D.h"
 
 
 class IArena; 
 
-class FExplosion : public Daylon::PlayObject2D<SDaylonParticles>  
-{
-	public:
-
-		static TSharedPtr<FExplosion>  Create  (FSlateBrush& Brush, const FVector2D& P, const FDaylonParticlesParams& Params, const FVector2D& Inertia = FVector2D(0));
-
-		virtual FVector2D  GetActualSize  () const override { return FVector2D(4); }
-};
-
 
 struct FExplosions
 {
+	// Every explosion is a burst in one particle system widget covering the viewport.
+	// Install() needs the root canvas; SpawnOne() calls it if nobody has yet.
+
 	IArena* Arena = nullptr;
 
-	TArray<TSharedPtr<FExplosion>>   Explosions; 
-	float                            InertialFactor = 1.0f;
+	TSharedPtr<SDaylonParticleSystem>  Particles; 
+	float                              InertialFactor = 1.0f;
 
 
-	void  SpawnOne   (const FVector2D& P, const FVector2D& Inertia = FVector2D(0));
-	void  SpawnOne   (const FVector2D& P, const FDaylonParticlesParams& Params, const FVector2D& Inertia = FVector2D(0));
-	void  Update     (const TFunction<FVector2D(const FVector2D&)>& WrapFunction, float DeltaTime);
-	void  RemoveAll  ();
+	void   Install        ();
+	void   SpawnOne       (const FVector2D& P, const FVector2D& Inertia = FVector2D(0));
+	void   SpawnOne       (const FVector2D& P, const FDaylonParticlesParams& Params, const FVector2D& Inertia = FVector2D(0));
+	void   Update         (const Daylon::FToroidalWrap& Wrap, float DeltaTime);
+	void   RemoveAll      ();
+	int32  GetNumDropped  () const { return (Particles ? Particles->GetNumDropped() : 0); }
 };
 
 // ---------------------------------------------------------------------------------------------------------
@@ -44,6 +41,7 @@ class FShieldExplosion : public Daylon::PlayObject2D<SDaylonLineParticles>
 	public:
 
 		static TSharedPtr<FShieldExplosion> Create(
+			Daylon::FRng&                      Rng,
 			const FVector2D&                   P,
 			const FDaylonLineParticlesParams&  Params,
 			const FVector2D&                   Inertia = FVector2D(0)
@@ -69,6 +67,6 @@ struct FShieldExplosions
 		const FVector2D&                   Inertia = FVector2D(0)
 	);
 
-	void  Update     (const TFunction<FVector2D(const FVector2D&)>& WrapFunction, float DeltaTime);
+	void  Update     (const Daylon::FToroidalWrap& Wrap, float DeltaTime);
 	void  RemoveAll  ();
 };
@@ -0,0 +1,117 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+// SpaceRox - an Atari Asteroids clone developed with Unreal Engine.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Constants.h"
+#include "DaylonGeometry.h"
+#include "DaylonRNG.h"
+
+
+// Gameplay rules shared by the widget-based game (UPlayViewBase and its play objects)
+// and the headless simulation (FSimWorld). They only deal in plain values, so keep
+// Slate out of here.
+
+
+inline int32 GetAsteroidSplitValue(int32 Value)
+{
+	// The value of the two rocks a rock splits into, or zero if it's too small to split.
+
+	switch(Value)
+	{
+		case ValueBigAsteroid:    return ValueMediumAsteroid;
+		case ValueMediumAsteroid: return ValueSmallAsteroid;
+		default:                  return 0;
+	}
+}
+
+
+inline void ComputeAsteroidSplitInertias(Daylon::FRng& Rng, const FVector2D& Inertia, FVector2D& OutInertia1, FVector2D& OutInertia2)
+{
+	// The kids veer off to either side of the parent's heading. They're generally
+	// faster than the parent, but once in a while the first one is slower.
+	// Either output can be the parent's own inertia.
+
+	const FVector2D ParentInertia = Inertia;
+
+	const bool BothKidsFast = Rng.RandRange(0, 10) < 9;
+
+	OutInertia2 = Daylon::DeviateVector(Rng, ParentInertia, MinAsteroidSplitAngle, MaxAsteroidSplitAngle);
+	OutInertia2 *= Rng.FRandRange(1.2f, 3.0f);
+
+	OutInertia1 = Daylon::DeviateVector(Rng, ParentInertia, -MinAsteroidSplitAngle, -MaxAsteroidSplitAngle);
+	OutInertia1 *= (BothKidsFast ? Rng.FRandRange(1.2f, 3.0f) : Rng.FRandRange(0.25f, 1.0f));
+}
+
+
+inline FVector2D GetAsteroidSpawnPosition(Daylon::FRng& Rng)
+{
+	// Wave rocks start somewhere along the top or left edge (which, wrapped, is also the bottom or right).
+
+	FVector2D P(0);
+
+	if(Rng.RandBool())
+	{
+		P.X = Rng.FRandRange(0.0, ViewportSize.X);
+	}
+	else
+	{
+		P.Y = Rng.FRandRange(0.0, ViewportSize.Y);
+	}
+
+	return P;
+}
+
+
+inline int32 GetNumWaveAsteroids(int32 WaveNumber)
+{
+	return FMath::Min(MaxInitialAsteroids, 2 + (WaveNumber * 2));
+}
+
+
+inline void ApplyPlayerShipThrust(FVector2D& Inertia, const FVector2D& Direction, float DeltaTime)
+{
+	Inertia += Direction * (PlayerThrustForce * DeltaTime);
+
+	// Limit speed to avoid breaking collision detector.
+
+	if(Inertia.Length() > MaxPlayerShipSpeed)
+	{
+		Inertia.Normalize();
+		Inertia *= MaxPlayerShipSpeed;
+	}
+}
+
+
+inline int32 IncreaseScore(int32& Score, int32 Amount)
+{
+	// Returns the number of bonus ships the increase earned.
+
+	if(Score >= MaxPlayerScore)
+	{
+		return 0;
+	}
+
+	const int32 PrevLevel = Score / PlayerShipBonusAt;
+
+	Score = FMath::Min(MaxPlayerScore, Score + Amount);
+
+	return (Score / PlayerShipBonusAt - PrevLevel);
+}
+
+
+inline FBox2d GetPlayerShipSpawnSafeZone(float ShieldsLeft)
+{
+	// The player ship doesn't respawn until nothing overlaps this box in the center of the screen.
+	// Make the safezone smaller if the player has enough shields. This makes it easier to respawn
+	// when there are lots of things around without having to potentially wait a really long time.
+
+	const auto SafeZoneDivisor = (ShieldsLeft > 3.0f) ? 8 : 4;
+
+	const auto ScreenCenter = ViewportSize / 2;
+	const auto SafeZoneSize = ViewportSize / SafeZoneDivisor;
+
+	return FBox2d(ScreenCenter - SafeZoneSize / 2, ScreenCenter + SafeZoneSize / 2);
+}
@@ -7,6 +7,7 @@
 
 
 #include "DaylonPlayObject2D.h"
+#include "DaylonPlayObjectPool.h"
 
 
 class FPlayObject : public Daylon::SpritePlayObject2D
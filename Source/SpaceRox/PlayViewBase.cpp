@@ -6,8 +6,11 @@
 #include "PlayViewBase.h"
 #include "Logging.h"
 #include "Constants.h"
-#include "Runtime/Engine/Classes/Kismet/KismetMathLibrary.h"
+#include "GameRules.h"
+#include "SimWorld.h"
 #include "Runtime/Engine/Classes/Kismet/KismetSystemLibrary.h"
+#include "Misc/ScopeExit.h"
+#include "HAL/IConsoleManager.h"
 
 
 
@@ -21,6 +24,9 @@
 
 #define FEATURE_MINIBOSS            1
 
+// Run the physics routine tests and benchmarks at startup. See PlayViewBaseTests.cpp.
+#define TEST_PHYSICS                0
+
 
 
 #if(DEBUG_MODULE == 1)
@@ -28,11 +34,26 @@
 #endif
 
 
+static TAutoConsoleVariable<int32> CVarParallelPlayfield(
+	TEXT("SpaceRox.ParallelPlayfield"),
+	1,
+	TEXT("1 = move rocks, powerups, torpedos and explosions on worker threads, 0 = all on the game thread."));
+
 
-FVector2D UPlayViewBase::WrapPositionToViewport(const FVector2D& P)
+// What the playfield jobs in UpdatePlayfield() read and write.
+
+enum EPlayfieldData : Daylon::FJobDataMask
 {
-	return FVector2D(UKismetMathLibrary::FWrap(P.X, 0.0, ViewportSize.X), UKismetMathLibrary::FWrap(P.Y, 0.0, ViewportSize.Y));
-}
+	PlayerShipData      = 1 << 0,
+	EnemyShipData       = 1 << 1, // Including bosses and scavengers
+	AsteroidData        = 1 << 2, // Including the powerups inside them
+	PowerupData         = 1 << 3, // Free-floating ones
+	TorpedoData         = 1 << 4,
+	ExplosionData       = 1 << 5,
+	ShieldExplosionData = 1 << 6,
+	DefaultStoreData    = 1 << 7  // Play objects not adopted into a collection's store, e.g. shield explosions and powerups inside rocks
+};
+
 
 
 void UPlayViewBase::InitializeScore()
@@ -45,19 +66,130 @@ void UPlayViewBase::InitializeScore()
 
 void UPlayViewBase::CreateTorpedos()
 {
+	InitializeSpriteBatches();
+
+	TorpedoComponents.Reserve(TorpedoCount);
+
 	for(int32 Index = 0; Index < TorpedoCount; Index++)
 	{
-		auto TorpedoPtr = FTorpedo::Create(TorpedoAtlas->Atlas, 0.5f);
+		auto TorpedoPtr = FTorpedo::Create(TorpedoAtlas->GetHandle(), 0.5f);
 
-		TorpedoPtr->Inertia = FVector2D(0);
-		TorpedoPtr->LifeRemaining = 0.0f;
+		TorpedoPtr->SetDrawnByBatch();
+		TorpedoPtr->SetInertia(FVector2D(0));
+		TorpedoPtr->SetLifeRemaining(0.0f);
 		TorpedoPtr->Hide();
 
 		Torpedos.Add(TorpedoPtr);
+		TorpedoComponents.Adopt(*TorpedoPtr.Get());
 	}
 }
 
 
+void UPlayViewBase::InitializeSpriteBatches()
+{
+	// Needs the root canvas, so it runs with the title graphics or the first time rocks or
+	// torpedos are made. The batches and the explosion particle system (drawn on top of them)
+	// cover the viewport and stay installed for good; rocks (which are pooled) are installed
+	// after them, but are collapsed and never drawn themselves.
+
+	if(TorpedoBatch)
+	{
+		return;
+	}
+
+	auto CreateBatch = [](const FDaylonSpriteAtlasHandle& Atlas)
+	{
+		auto Batch = SNew(SDaylonSpriteBatch).Size(ViewportSize);
+
+		Batch->SetAtlas(Atlas);
+		Daylon::InstallCanvasOverlay(Batch, ViewportSize);
+
+		return Batch;
+	};
+
+	RockBatches[0] = CreateBatch(LargeRockAtlas ->GetHandle());
+	RockBatches[1] = CreateBatch(MediumRockAtlas->GetHandle());
+	RockBatches[2] = CreateBatch(SmallRockAtlas ->GetHandle());
+	TorpedoBatch   = CreateBatch(TorpedoAtlas   ->GetHandle());
+
+	Explosions.Install();
+}
+
+
+void UPlayViewBase::UpdateSpriteBatches()
+{
+	// Refill the batches from the rock and torpedo components. Like the widgets they
+	// replace, this runs once per frame after everything has moved.
+
+	if(!TorpedoBatch)
+	{
+		return;
+	}
+
+	for(auto& Batch : RockBatches)
+	{
+		Batch->Reset();
+	}
+
+	TorpedoBatch->Reset();
+
+	const auto& Rocks = Asteroids.GetComponents();
+
+	for(int32 Index = 0; Index < Rocks.Num(); Index++)
+	{
+		const auto& Asteroid = Asteroids.Get(Index);
+
+		if(!Asteroid.IsVisible())
+		{
+			continue;
+		}
+
+		int32 BatchIndex;
+
+		switch(Rocks.Values[Index].Value)
+		{
+			case ValueMediumAsteroid: BatchIndex = 1; break;
+			case ValueSmallAsteroid:  BatchIndex = 2; break;
+			default:                  BatchIndex = 0; break;
+		}
+
+		auto& Instance = RockBatches[BatchIndex]->Add();
+
+		Instance.Position = Daylon::GetRenderPosition(Rocks.Motion[Index]);
+		Instance.Angle    = Rocks.Motion[Index].Angle;
+		Instance.Size     = Rocks.Collision[Index].Size;
+		Instance.Cel      = Asteroid.GetCurrentCel();
+		Instance.Tint.A   = Asteroid.GetRenderOpacity();
+	}
+
+	for(int32 Index = 0; Index < TorpedoComponents.Num(); Index++)
+	{
+		const auto& Torpedo = *Torpedos[Index].Get();
+
+		if(!Torpedo.IsVisible())
+		{
+			continue;
+		}
+
+		auto& Instance = TorpedoBatch->Add();
+
+		Instance.Position = Daylon::GetRenderPosition(TorpedoComponents.Motion[Index]);
+		Instance.Angle    = TorpedoComponents.Motion[Index].Angle;
+		Instance.Size     = TorpedoComponents.Collision[Index].Size;
+		Instance.Cel      = Torpedo.GetCurrentCel();
+	}
+
+	// Batches whose sprites didn't change aren't repainted.
+
+	for(auto& Batch : RockBatches)
+	{
+		Batch->Commit();
+	}
+
+	TorpedoBatch->Commit();
+}
+
+
 void UPlayViewBase::InitializeVariables()
 {
 	bHighScoreWasEntered          = false;
@@ -69,13 +201,25 @@ void UPlayViewBase::InitializeVariables()
 
 	ThrustSoundTimeRemaining      = 0.0f;
 	StartMsgAnimationAge          = 0.0f;
-	TimeUntilNextWave             = 0.0f;
-	TimeUntilNextPlayerShip       = 0.0f;
-	TimeUntilNextEnemyShip        = 0.0f;
-	TimeUntilNextBoss             = 0.0f;
-	TimeUntilGameOverStateEnds    = 0.0f;
 	MruHighScoreAnimationAge      = 0.0f;
-	TimeUntilNextScavenger        = 5.0f;
+	SimulationTimeAccumulator     = 0.0f;
+
+	Tasks.Reserve(64);
+
+	for(auto Countdown : { &WaveCountdown, &PlayerShipCountdown, &EnemyShipCountdown, &BossCountdown, &ScavengerCountdown, &IntroStateCountdown, &GameOverStateCountdown })
+	{
+		Countdown->Init(Tasks);
+		Countdown->Set(0.0f);
+	}
+
+	ScavengerCountdown.Set(5.0f);
+
+	const uint64 Seed = (RandomSeed != 0 ? (uint64)RandomSeed : FPlatformTime::Cycles64());
+
+	for(int32 Stream = 0; Stream < (int32)ERngStream::Count; Stream++)
+	{
+		Rngs[Stream].Seed(Seed, Stream);
+	}
 
 	Asteroids.Arena               =
 	Explosions.Arena              = 
@@ -85,6 +229,12 @@ void UPlayViewBase::InitializeVariables()
 	Explosions.InertialFactor       = ExplosionInertialFactor;
 	ShieldExplosions.InertialFactor = ExplosionInertialFactor;
 
+	// The pools create their widgets on first use, once the canvas is ready.
+	Asteroids.Pool           .Init(&FAsteroid::CreateWidget,  AsteroidPoolSize,  AsteroidPoolChunkSize);
+	EnemyShips.ShipPool      .Init(&FEnemyShip::CreateWidget, EnemyShipPoolSize, SmallPoolChunkSize);
+	EnemyShips.ScavengerPool .Init(&FScavenger::CreateWidget, ScavengerPoolSize, SmallPoolChunkSize);
+	PowerupPool              .Init(&FPowerup::CreateWidget,   PowerupPoolSize,   SmallPoolChunkSize);
+
 	GameState                     = EGameState::Startup;
 	SelectedMenuItem              = EMenuItem::StartPlaying;
 
@@ -94,20 +244,70 @@ void UPlayViewBase::InitializeVariables()
 }
 
 
+void UPlayViewBase::LogPoolStats() const
+{
+	// If a pool had to grow during play, raise its initial size in Constants.h.
+
+	auto LogPool = [](const TCHAR* Name, int32 HighWaterMark, int32 Capacity, int32 NumGrowths)
+	{
+		UE_LOG(LogGame, Log, TEXT("%s pool: high-water mark %d, capacity %d, grew %d times"), Name, HighWaterMark, Capacity, NumGrowths);
+	};
+
+	LogPool(TEXT("Rock"),       Asteroids.Pool.GetHighWaterMark(),           Asteroids.Pool.GetCapacity(),           Asteroids.Pool.GetNumGrowths());
+	LogPool(TEXT("Enemy ship"), EnemyShips.ShipPool.GetHighWaterMark(),      EnemyShips.ShipPool.GetCapacity(),      EnemyShips.ShipPool.GetNumGrowths());
+	LogPool(TEXT("Scavenger"),  EnemyShips.ScavengerPool.GetHighWaterMark(), EnemyShips.ScavengerPool.GetCapacity(), EnemyShips.ScavengerPool.GetNumGrowths());
+	LogPool(TEXT("Powerup"),    PowerupPool.GetHighWaterMark(),              PowerupPool.GetCapacity(),              PowerupPool.GetNumGrowths());
+
+	// Likewise if explosions had to be dropped, raise MaxExplosionParticles or MaxExplosionBursts.
+
+	UE_LOG(LogGame, Log, TEXT("Explosions: %d dropped to make room"), Explosions.GetNumDropped());
+}
+
+
 void UPlayViewBase::InitializeAtlases()
 {
-	PlayerShipAtlas           -> Atlas.InitCache();
-	LargeRockAtlas            -> Atlas.InitCache();
-	MediumRockAtlas           -> Atlas.InitCache();
-	SmallRockAtlas            -> Atlas.InitCache();
-	BigEnemyAtlas             -> Atlas.InitCache();
-	SmallEnemyAtlas           -> Atlas.InitCache();
-	DefensesAtlas             -> Atlas.InitCache();
-	DoubleGunsPowerupAtlas    -> Atlas.InitCache();
-	ShieldPowerupAtlas        -> Atlas.InitCache();
-	InvincibilityPowerupAtlas -> Atlas.InitCache();
-	ScavengerAtlas            -> Atlas.InitCache();
-	TorpedoAtlas              -> Atlas.InitCache();
+	// Every sprite drawn from an atlas shares the one built here, so anything baked
+	// into an atlas (like the powerups' translucency) has to be set before building it.
+
+	for(auto PowerupAtlas : { DoubleGunsPowerupAtlas, ShieldPowerupAtlas, InvincibilityPowerupAtlas })
+	{
+		PowerupAtlas->Atlas.AtlasBrush.TintColor = FLinearColor(1.0f, 1.0f, 1.0f, PowerupOpacity);
+	}
+
+	PlayerShipAtlas           -> Build();
+	LargeRockAtlas            -> Build();
+	MediumRockAtlas           -> Build();
+	SmallRockAtlas            -> Build();
+	BigEnemyAtlas             -> Build();
+	SmallEnemyAtlas           -> Build();
+	DefensesAtlas             -> Build();
+	DoubleGunsPowerupAtlas    -> Build();
+	ShieldPowerupAtlas        -> Build();
+	InvincibilityPowerupAtlas -> Build();
+	ScavengerAtlas            -> Build();
+	TorpedoAtlas              -> Build();
+	Miniboss1Atlas            -> Build();
+	Miniboss2Atlas            -> Build();
+}
+
+
+FSimParams UPlayViewBase::GetSimParams() const
+{
+	// Use the atlases' own properties rather than their handles, which are only built at play time.
+
+	FSimParams Params;
+
+	Params.BigAsteroidSize      = FAsteroid::GetSize(LargeRockAtlas ->Atlas);
+	Params.MediumAsteroidSize   = FAsteroid::GetSize(MediumRockAtlas->Atlas);
+	Params.SmallAsteroidSize    = FAsteroid::GetSize(SmallRockAtlas ->Atlas);
+
+	Params.SimulationRate       = SimulationRate;
+	Params.NumAsteroidsOverride = NumAsteroidsOverride;
+	Params.bAsteroidsCollide    = bAsteroidsCollide;
+	Params.bGodMode             = bGodMode;
+	Params.RandomSeed           = RandomSeed;
+
+	return Params;
 }
 
 
@@ -185,83 +385,8 @@ void UPlayViewBase::NativeOnInitialized()
 
 	IsInitialized = false;
 
-#if 0
-	// Test physics routines.
-	{
-		// Line segment vs. circle.
-		// Try lines we know should intersect.
-
-		double R = 100.0;
-		FVector2D CP(300, 300);
-
-		struct FLine { FVector2D P1, P2; };
-
-		const FLine Lines[] = 
-		{
-			// Horizontal lines wider than circle.
-			{ FVector2D(174, 230), FVector2D(430, 230) },
-			{ FVector2D(174, 300), FVector2D(430, 300) },
-			{ FVector2D(174, 374), FVector2D(430, 374) },
-
-			// Vertical lines wider than circle.
-			{ FVector2D(234, 180), FVector2D(234, 420) },
-			{ FVector2D(300, 180), FVector2D(300, 420) },
-			{ FVector2D(380, 180), FVector2D(380, 420) },
-
-			// Horizontal lines inside circle.
-			{ FVector2D(250, 245), FVector2D(360, 230) },
-			{ FVector2D(250, 300), FVector2D(360, 300) },
-			{ FVector2D(250, 350), FVector2D(360, 350) },
-
-			// Vertical lines inside circle.
-			{ FVector2D(234, 250), FVector2D(234, 360) },
-			{ FVector2D(300, 250), FVector2D(300, 360) },
-			{ FVector2D(350, 250), FVector2D(350, 360) },
-		};
-
-		auto PtInsideCircle = [&](const FVector2D& P)
-		{
-			return ((P - CP).Length() <= R);
-		};
-
-		auto InsideCircle = [&](const FLine& Line) 
-		{ 
-			// If either endpoint is inside the circle, then the line must intersect circle.
-			return (PtInsideCircle(Line.P1) || PtInsideCircle(Line.P2));
-		};
-
-		for(const auto& Line : Lines)
-		{
-			//if(!InsideCircle(Line))
-			{
-				bool Result = Daylon::DoesLineSegmentIntersectCircle(Line.P1, Line.P2, CP, R);
-				if(!Result)
-				{
-					UE_LOG(LogGame, Error, TEXT("Daylon::DoesLineSegmentIntersectCircle returned false negative for line %f, %f - %f, %f"),
-						Line.P1.X, Line.P1.Y, Line.P2.X, Line.P2.Y);
-				}
-			}
-		}
-
-		// Try random tiny lines inside or penetrating the circle.
-		for(int32 Idx = 0; Idx < 10000; Idx++)
-		{
-			FLine Line;
-			
-			Line.P1 = Daylon::RandVector2D() * R * Daylon::FRandRange(0.8f, 1.2f) + CP; // could be inside or outside
-			Line.P2 = Daylon::RandVector2D() * R * 0.9 + CP; // must be inside
-
-			//if(!InsideCircle(Line))
-			{
-				bool Result = Daylon::DoesLineSegmentIntersectCircle(Line.P1, Line.P2, CP, R);
-				if(!Result)
-				{
-					UE_LOG(LogGame, Error, TEXT("Daylon::DoesLineSegmentIntersectCircle returned false negative for line %f, %f - %f, %f"),
-						Line.P1.X, Line.P1.Y, Line.P2.X, Line.P2.Y);
-				}
-			}
-		}
-	}
+#if(TEST_PHYSICS == 1)
+	TestPhysics();
 #endif
 
 
@@ -298,11 +423,7 @@ void UPlayViewBase::ScheduleExplosion
 	const FDaylonParticlesParams& Params
 )
 {
-	Daylon::FScheduledTask Task;
-
-	Task.When = When;
-
-	Task.What = [P, Inertia, Params, ArenaPtr = TWeakObjectPtr<UPlayViewBase>(this)]()
+	auto Explode = [P, Inertia, Params, ArenaPtr = TWeakObjectPtr<UPlayViewBase>(this)]()
 	{
 		if(!ArenaPtr.IsValid() || !ArenaPtr->CanExplosionOccur())
 		{
@@ -312,7 +433,10 @@ void UPlayViewBase::ScheduleExplosion
 		ArenaPtr->GetExplosions().SpawnOne(P, Params, Inertia);
 	};
 
-	AddScheduledTask(Task);
+	// Explosions get scheduled in bursts, so keep them off the heap.
+	static_assert(Daylon::FTaskFunction::FitsInline<decltype(Explode)>(), "Scheduled explosion captures too much to store inline");
+
+	Tasks.Schedule(When, MoveTemp(Explode));
 }
 
 
@@ -424,7 +548,9 @@ void UPlayViewBase::TransitionToState(EGameState State)
 
 	
 
-			TimeUntilIntroStateEnds = MaxIntroStateLifetime;
+			// Held until InitialDelay runs out.
+			IntroStateCountdown.Set(MaxIntroStateLifetime);
+			IntroStateCountdown.SetPaused(true);
 			Asteroids.RemoveAll();
 
 			Daylon::Hide (MenuContent);
@@ -487,9 +613,10 @@ void UPlayViewBase::TransitionToState(EGameState State)
 				UE_LOG(LogGame, Warning, TEXT("Invalid previous state %d when entering active state"), (int32)PreviousState);
 			}
 
-			TimeUntilNextEnemyShip = 20.0f;
-			TimeUntilNextBoss      = 22.0f;
-			TimeUntilNextWave      =  2.0f;
+			EnemyShipCountdown.Set(20.0f);
+			BossCountdown     .Set(22.0f);
+			WaveCountdown     .Set( 2.0f);
+			WaveCountdown     .SetPaused(false);
 
 			if(!PlayerShip)
 			{
@@ -537,10 +664,12 @@ void UPlayViewBase::TransitionToState(EGameState State)
 			Daylon::Uninstall(PlayerShip);
 			PlayerShip.Reset();
 
+			LogPoolStats();
+
 
 			Daylon::Show(GameOverMessage);
 
-			TimeUntilGameOverStateEnds = MaxTimeUntilGameOverStateEnds;
+			GameOverStateCountdown.Set(MaxTimeUntilGameOverStateEnds);
 
 			break;
 
@@ -635,7 +764,47 @@ void UPlayViewBase::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 		return;
 	}
 
-	UpdateTasks(InDeltaTime);
+	// Play objects only touch their Slate slots (and the sprite batches) here, once per frame, whichever way we leave.
+	ON_SCOPE_EXIT { Daylon::SyncPlayObjects(); UpdateSpriteBatches(); };
+
+	// Simulate in fixed steps, however long the frame was, so that physics behaves the same
+	// at any frame rate and through hitches. Whatever time is left over carries into the next
+	// frame, and play objects are drawn that far between their last two steps.
+
+	const float StepTime = 1.0f / FMath::Max(1.0f, SimulationRate);
+
+	SimulationTimeAccumulator += InDeltaTime;
+
+	int32 NumSteps = 0;
+
+	while(SimulationTimeAccumulator >= StepTime)
+	{
+		if(NumSteps >= FMath::Max(1, MaxSimulationStepsPerFrame))
+		{
+			// Too far behind to catch up; let the game slow down instead of spiralling.
+			SimulationTimeAccumulator = 0.0f;
+			break;
+		}
+
+		Daylon::BeginSimulationStep();
+		Simulate(StepTime);
+
+		SimulationTimeAccumulator -= StepTime;
+		NumSteps++;
+	}
+
+	Daylon::SetRenderInterpolation(SimulationTimeAccumulator / StepTime);
+}
+
+
+void UPlayViewBase::Simulate(float DeltaTime)
+{
+	UpdateTasks(DeltaTime);
+
+	// Movement and collisions during play can be split into substeps, for fast movers.
+
+	const int32 NumSubsteps = FMath::Max(1, SimulationSubsteps);
+	const float SubstepTime = DeltaTime / NumSubsteps;
 
 	static float ExploCountAge = 1.0f;
 
@@ -644,7 +813,7 @@ void UPlayViewBase::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 	{
 		case EGameState::Intro:
 
-			InitialDelay -= InDeltaTime;
+			InitialDelay -= DeltaTime;
 
 			if(InitialDelay > 0.0f)
 			{
@@ -654,84 +823,82 @@ void UPlayViewBase::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 			Daylon::Show(IntroContent);
 			//TitleGraphic->SetOpacity(0.0f);
 
+			IntroStateCountdown.SetPaused(false);
+
 
 			// Fade in the title graphic and version number while explosions rage
 
 			if(TitleCels.IsEmpty())
 			{
 				InitializeTitleGraphics();
+				InitializeSpriteBatches();
 			}
 
 			{
 				static FBox2d Box(FVector2D(480, 300), FVector2D(1500, 550));
 
+				const float TimeUntilIntroStateEnds = IntroStateCountdown.GetRemaining();
+
 				if(TimeUntilIntroStateEnds > 0.0f)
 				{
 					for(auto& CelPtr : TitleCels)
 					{
-						CelPtr->Update(InDeltaTime);
+						CelPtr->Update(DeltaTime);
 					}
 
 					// TitleGraphic->SetOpacity(FMath::Max(0.0f, 1.0f - (TimeUntilIntroStateEnds * 1.5f) / MaxIntroStateLifetime));
 
 					VersionReadout->SetOpacity(FMath::Max(0.0f, 1.0f - (TimeUntilIntroStateEnds * 3.0f) / MaxIntroStateLifetime));
 
-					ExploCountAge -= InDeltaTime;
+					ExploCountAge -= DeltaTime;
 				
 					if(ExploCountAge <= 0.0f)
 					{
-						ExploCountAge = Daylon::FRandRange(0.05f, 0.2f);
+						auto& Rng = GetRng(ERngStream::Explosions);
+
+						ExploCountAge = Rng.FRandRange(0.05f, 0.2f);
 
-						Explosions.SpawnOne(Daylon::RandomPtWithinBox(Box), IntroExplosionParams);
+						Explosions.SpawnOne(Daylon::RandomPtWithinBox(Rng, Box), IntroExplosionParams);
 
-						if(Daylon::RandRange(0, 5) == 0)
+						if(Rng.RandRange(0, 5) == 0)
 						{
 							PlaySound(PlayerShipDestroyedSound);
 						}
 						else
 						{
-							PlaySound(ExplosionSounds[Daylon::RandRange(0, ExplosionSounds.Num() - 1)]);
+							PlaySound(ExplosionSounds[Rng.RandRange(0, ExplosionSounds.Num() - 1)]);
 						}
 					}
 				}
 			}
 
-			Explosions.Update(WrapPositionToViewport, InDeltaTime);
-
-			TimeUntilIntroStateEnds -= InDeltaTime;
+			Explosions.Update(GetViewportWrap(), DeltaTime);
 
 			break;
 
 
 		case EGameState::MainMenu:
 
-			Asteroids.Update          (InDeltaTime);
-			UpdatePowerups            (InDeltaTime);
+			Asteroids.Update          (DeltaTime);
+			UpdatePowerups            (DeltaTime);
 
 			break;
 
 
 		case EGameState::Active:
 
-			if(IsPlayerShipPresent())
+			for(int32 Substep = 0; Substep < NumSubsteps; Substep++)
 			{
-				PlayerShip->Perform     (InDeltaTime);
-			}
-
-			EnemyShips.Update         (InDeltaTime);
-			Asteroids.Update          (InDeltaTime);
-			UpdatePowerups            (InDeltaTime);
-			UpdateTorpedos            (InDeltaTime);
-			Explosions.Update         (WrapPositionToViewport, InDeltaTime);
-			ShieldExplosions.Update   (WrapPositionToViewport, InDeltaTime);
+				UpdatePlayfield           (SubstepTime, true);
 
-			CheckCollisions();
+				CheckCollisions();
+			}
 
-			ProcessWaveTransition     (InDeltaTime);
+			ProcessWaveTransition     (DeltaTime);
 
 			if(PlayerShip && PlayerShip->IsSpawning)
 			{
-				ProcessPlayerShipSpawn    (InDeltaTime);
+				ProcessPlayerShipSpawn    (DeltaTime);
 			}
 
 			break;
@@ -739,21 +906,17 @@ void UPlayViewBase::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 
 		case EGameState::Over:
 
-			EnemyShips.Update         (InDeltaTime);
-			Asteroids.Update          (InDeltaTime);
-			UpdatePowerups            (InDeltaTime);
-			UpdateTorpedos            (InDeltaTime);
-			Explosions.Update         (WrapPositionToViewport, InDeltaTime);
-			ShieldExplosions.Update   (WrapPositionToViewport, InDeltaTime);
+			for(int32 Substep = 0; Substep < NumSubsteps; Substep++)
+			{
+				UpdatePlayfield           (SubstepTime, false);
 
-			CheckCollisions(); // In case any late torpedos or enemies hit something
+				CheckCollisions(); // In case any late torpedos or enemies hit something
+			}
 
 			// Make the "game over" message blink
-			GameOverMessage->SetOpacity(0.5f + sin(TimeUntilGameOverStateEnds * PI) * 0.5f);
-
-			TimeUntilGameOverStateEnds -= InDeltaTime;
+			GameOverMessage->SetOpacity(0.5f + sin(GameOverStateCountdown.GetRemaining() * PI) * 0.5f);
 
-			if(TimeUntilGameOverStateEnds <= 0.0f)
+			if(GameOverStateCountdown.IsDue())
 			{
 				LoadHighScores();
 
@@ -772,8 +935,8 @@ void UPlayViewBase::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 
 		case EGameState::HighScores:
 
-			Asteroids.Update          (InDeltaTime);
-			UpdatePowerups            (InDeltaTime);
+			Asteroids.Update          (DeltaTime);
+			UpdatePowerups            (DeltaTime);
 
 			if(MostRecentHighScoreTextBlock[0] != nullptr)
 			{
@@ -786,7 +949,7 @@ void UPlayViewBase::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 					TextBlock->SetOpacity(FMath::Lerp(0.5f, 1.0f, 0.5f + sin(T) * 0.5f));
 				}
 
-				MruHighScoreAnimationAge = FMath::Wrap(MruHighScoreAnimationAge + InDeltaTime, 0.0f, 10.0f);
+				MruHighScoreAnimationAge = FMath::Wrap(MruHighScoreAnimationAge + DeltaTime, 0.0f, 10.0f);
 			}
 
 			break;
@@ -794,9 +957,9 @@ void UPlayViewBase::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 		case EGameState::Credits:
 		case EGameState::Help:
 
-			//EnemyShips.Update       (InDeltaTime);
-			Asteroids.Update          (InDeltaTime);
-			UpdatePowerups            (InDeltaTime);
+			//EnemyShips.Update       (DeltaTime);
+			Asteroids.Update          (DeltaTime);
+			UpdatePowerups            (DeltaTime);
 			break;
 
 
@@ -806,17 +969,32 @@ void UPlayViewBase::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 }
 
 
+int32 UPlayViewBase::NativePaint
+(
+	const FPaintArgs&          Args,
+	const FGeometry&           AllottedGeometry,
+	const FSlateRect&          MyCullingRect,
+	FSlateWindowElementList&   OutDrawElements,
+	int32                      LayerId,
+	const FWidgetStyle&        InWidgetStyle,
+	bool                       bParentEnabled
+) const
+{
+	LayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	return PaintCollisionOverlay(AllottedGeometry, OutDrawElements, LayerId);
+}
+
+
 void UPlayViewBase::ProcessWaveTransition(float DeltaTime)
 {
 	// If there are no more targets, then spawn the next wave after a few seconds.
 
-	if(TimeUntilNextWave < TimeBetweenWaves)
+	if(!WaveCountdown.IsPaused())
 	{
 		// We are currently counting down to the start of the next wave.
 
-		TimeUntilNextWave -= DeltaTime;
-
-		if(TimeUntilNextWave > 0.0f)
+		if(!WaveCountdown.IsDue())
 		{
 			// Time still remaining, don't start next wave yet.
 			return;
@@ -835,7 +1013,8 @@ void UPlayViewBase::ProcessWaveTransition(float DeltaTime)
 	}
 
 	// Wave has ended, start counting down.
-	TimeUntilNextWave = TimeBetweenWaves - DeltaTime;
+	WaveCountdown.SetPaused(false);
+	WaveCountdown.Set(TimeBetweenWaves - DeltaTime);
 }
 
 
@@ -849,7 +1028,7 @@ void UPlayViewBase::SpawnPowerup(TSharedPtr<FPowerup>& PowerupPtr, const FVector
 		return;
 	}
 #else
-	const auto PowerupKind = (EPowerup)Daylon::RandRange(1, 3);
+	const auto PowerupKind = (EPowerup)GetRng(ERngStream::Powerups).RandRange(1, 3);
 #endif
 
 	UDaylonSpriteWidgetAtlas* Atlas = nullptr;
@@ -863,11 +1042,9 @@ void UPlayViewBase::SpawnPowerup(TSharedPtr<FPowerup>& PowerupPtr, const FVector
 
 	check(Atlas);
 
-	Atlas->Atlas.AtlasBrush.TintColor = FLinearColor(1.0f, 1.0f, 1.0f, PowerupOpacity);
-
 	check(!PowerupPtr);
 
-	PowerupPtr = FPowerup::Create(Atlas->Atlas, FVector2D(32));
+	PowerupPtr = FPowerup::Create(PowerupPool, Atlas->GetHandle(), FVector2D(32));
 
 	auto& Powerup = *PowerupPtr.Get();
 
@@ -875,12 +1052,16 @@ void UPlayViewBase::SpawnPowerup(TSharedPtr<FPowerup>& PowerupPtr, const FVector
 
 	//Powerup.Show();
 	Powerup.SetPosition(P);
-	Powerup.Inertia.Set(0, 0);
+	Powerup.SetInertia(FVector2D(0));
 }
 
 
 void UPlayViewBase::SpawnAsteroids(int32 NumAsteroids)
 {
+	InitializeSpriteBatches();
+
+	auto& Rng = GetRng(ERngStream::Asteroids);
+
 	for(int32 Index = 0; Index < NumAsteroids; Index++)
 	{
 		// 0=big, 1=med, 2=small
@@ -895,23 +1076,14 @@ void UPlayViewBase::SpawnAsteroids(int32 NumAsteroids)
 		FVector2D P(500, Index * 300 + 200);
 #else
 		// Place randomly along edges of screen.
-		FVector2D P(0);
-
-		if(Daylon::RandBool())
-		{
-			P.X = Daylon::FRandRange(0.0, ViewportSize.X);
-		}
-		else
-		{
-			P.Y = Daylon::FRandRange(0.0, ViewportSize.Y);
-		}
+		const FVector2D P = GetAsteroidSpawnPosition(Rng);
 #endif
 
 
 #if(TEST_ASTEROIDS==1)
 		const auto Inertia = FVector2D(0);
 #else
-		const auto Inertia = Daylon::RandVector2D() * Daylon::FRandRange(MinAsteroidSpeed, MaxAsteroidSpeed);
+		const auto Inertia = Daylon::RandVector2D(Rng) * Rng.FRandRange(MinAsteroidSpeed, MaxAsteroidSpeed);
 #endif
 
 		UDaylonSpriteWidgetAtlas* AsteroidAtlas = nullptr;
@@ -936,10 +1108,10 @@ void UPlayViewBase::SpawnAsteroids(int32 NumAsteroids)
 				break;
 		}
 
-		auto Asteroid = FAsteroid::Spawn(this, AsteroidAtlas->Atlas);
-		Asteroid->Value = AsteroidValue;
-		Asteroid->LifeRemaining = 1.0f;
-		Asteroid->SpinSpeed = Daylon::FRandRange(MinAsteroidSpinSpeed, MaxAsteroidSpinSpeed);
+		auto Asteroid = FAsteroid::Spawn(this, AsteroidAtlas->GetHandle());
+		Asteroid->SetValue(AsteroidValue);
+		Asteroid->SetLifeRemaining(1.0f);
+		Asteroid->SetSpinSpeed(Rng.FRandRange(MinAsteroidSpinSpeed, MaxAsteroidSpinSpeed));
 
 		if(AsteroidSize == 0 && Index % 4 == 0)
 		{
@@ -956,7 +1128,8 @@ void UPlayViewBase::SpawnAsteroids(int32 NumAsteroids)
 
 void UPlayViewBase::StartWave()
 {
-	TimeUntilNextWave = TimeBetweenWaves;
+	// Stop counting until this wave ends.
+	WaveCountdown.SetPaused(true);
 
 	WaveNumber++;
 
@@ -965,14 +1138,15 @@ void UPlayViewBase::StartWave()
 #if(TEST_ASTEROIDS == 1)
 	const int32 NumAsteroids = 3;
 #else
-	const int32 NumAsteroids = NumAsteroidsOverride > 0 ? NumAsteroidsOverride : FMath::Min(MaxInitialAsteroids, 2 + (WaveNumber * 2));
+	const int32 NumAsteroids = NumAsteroidsOverride > 0 ? NumAsteroidsOverride : GetNumWaveAsteroids(WaveNumber);
 #endif
 
 	Asteroids.RemoveAll(); // to be safe
+	Asteroids.bCollideWithEachOther = bAsteroidsCollide;
 	SpawnAsteroids(NumAsteroids);
 
-	TimeUntilNextEnemyShip = MaxTimeUntilNextEnemyShip; 
-	TimeUntilNextBoss      = MaxTimeUntilNextBoss;
+	EnemyShipCountdown.Set(MaxTimeUntilNextEnemyShip);
+	BossCountdown     .Set(MaxTimeUntilNextBoss);
 
 	
 	// Spawn extra powerups if requested.
@@ -989,11 +1163,11 @@ void UPlayViewBase::StartWave()
 	{
 		TSharedPtr<FPowerup> PowerupPtr;
 
-		SpawnPowerup(PowerupPtr, Daylon::RandomPtWithinBox(Box));
+		SpawnPowerup(PowerupPtr, Daylon::RandomPtWithinBox(GetRng(ERngStream::Powerups), Box));
 
 		if(PowerupPtr)
 		{
-			Powerups.Add(PowerupPtr);
+			AddPowerup(PowerupPtr);
 		}
 	}
 }
@@ -1003,10 +1177,19 @@ void UPlayViewBase::UpdatePowerups(float DeltaTime)
 {
 	// This will move any free-floating powerups.
 
-	for(auto& Powerup : Powerups)
+	for(int32 Index = 0; Index < PowerupComponents.Num(); Index++)
 	{
-		Powerup->Move(DeltaTime, WrapPositionToViewport);
-		Powerup->Update(DeltaTime);
+		auto& Motion = PowerupComponents.Motion[Index];
+
+		Motion.OldPosition          = Motion.Position;
+		Motion.UnwrappedNewPosition = Motion.Position + Motion.Inertia * DeltaTime;
+		Motion.Position             = WrapPositionToViewport(Motion.UnwrappedNewPosition);
+
+		Motion.AddStepMotion(Motion.Inertia * DeltaTime);
+
+		PowerupComponents.Sprites[Index]->MarkSlotDirty();
+
+		Powerups[Index]->Update(DeltaTime);
 	}
 }
 
@@ -1033,23 +1216,44 @@ void UPlayViewBase::KillPowerup(int32 PowerupIndex)
 
 void UPlayViewBase::UpdateTasks(float DeltaTime)
 {
-	// Iterate backwards so we can safely remove tasks from the array.
+	// Advances the clock the countdowns read, and runs whichever scheduled tasks came due.
 
-	for(int32 Index = ScheduledTasks.Num() - 1; Index >= 0; Index--)
-	{
-		if(ScheduledTasks[Index].Tick(DeltaTime))
-		{
-			ScheduledTasks.RemoveAtSwap(Index);
-		}
-	}
+	Tasks.Tick(DeltaTime);
+}
 
-	for(int32 Index = DurationTasks.Num() - 1; Index >= 0; Index--)
+
+void UPlayViewBase::UpdatePlayfield(float DeltaTime, bool bWithPlayerShip)
+{
+	// Moves everything on the playfield one (sub)step, with the same results as calling the updates
+	// one after another in the order below.
+	//
+	// The player ship and enemies play sounds, spawn things and fire torpedos, so they run first, on
+	// the game thread. Everything after them only moves its own objects, so rocks, free powerups,
+	// torpedos and explosions then move on worker threads while the game thread does the shield
+	// explosions (which uninstall their widgets). Shield explosions and the powerups inside rocks
+	// share the default play object store, and destroying a shield explosion reorders it, so the
+	// shield explosions wait for the rocks. Worker jobs don't touch Slate: moved play objects
+	// and changed widgets wait for the next SyncPlayObjects(). We return once every job is done,
+	// so collision checks see the whole step.
+
+	PlayfieldJobs.Reset();
+
+	if(bWithPlayerShip && IsPlayerShipPresent())
 	{
-		if(!DurationTasks[Index].Tick(DeltaTime))
-		{
-			DurationTasks.RemoveAtSwap(Index);
-		}
+		PlayfieldJobs.Add(TEXT("PlayerShip"), 0, PlayerShipData | TorpedoData | DefaultStoreData, true,
+			[this, DeltaTime]() { PlayerShip->Perform(DeltaTime); });
 	}
+
+	PlayfieldJobs.Add(TEXT("EnemyShips"), PlayerShipData | AsteroidData, EnemyShipData | PowerupData | TorpedoData | ExplosionData | ShieldExplosionData | DefaultStoreData, true,
+		[this, DeltaTime]() { EnemyShips.Update(DeltaTime); });
+
+	PlayfieldJobs.Add(TEXT("Asteroids"),        0, AsteroidData        | DefaultStoreData, false, [this, DeltaTime]() { Asteroids.Update(DeltaTime); });
+	PlayfieldJobs.Add(TEXT("Powerups"),         0, PowerupData,                            false, [this, DeltaTime]() { UpdatePowerups(DeltaTime); });
+	PlayfieldJobs.Add(TEXT("Torpedos"),         0, TorpedoData,                            false, [this, DeltaTime]() { UpdateTorpedos(DeltaTime); });
+	PlayfieldJobs.Add(TEXT("Explosions"),       0, ExplosionData,                          false, [this, DeltaTime]() { Explosions.Update(GetViewportWrap(), DeltaTime); });
+	PlayfieldJobs.Add(TEXT("ShieldExplosions"), 0, ShieldExplosionData | DefaultStoreData, true,  [this, DeltaTime]() { ShieldExplosions.Update(GetViewportWrap(), DeltaTime); });
+
+	PlayfieldJobs.Run(CVarParallelPlayfield.GetValueOnGameThread() != 0);
 }
 
 
@@ -1057,24 +1261,32 @@ void UPlayViewBase::UpdateTorpedos(float DeltaTime)
 {
 	// todo?: fade torpedo from white to black as it gets older, and flicker it.
 
-	for (auto& TorpedoPtr : Torpedos)
+	for(int32 Index = 0; Index < TorpedoComponents.Num(); Index++)
 	{
-		auto& Torpedo = *TorpedoPtr.Get();
+		auto& Lifetime = TorpedoComponents.Lifetime[Index];
 
-		if(Torpedo.IsDead())
+		if(!Lifetime.IsAlive())
 		{
 			continue;
 		}
 
-		Torpedo.LifeRemaining -= DeltaTime;
+		Lifetime.LifeRemaining -= DeltaTime;
 
-		if (Torpedo.IsDead())
+		if(!Lifetime.IsAlive())
 		{
-			Torpedo.Kill();
+			Torpedos[Index]->Kill();
 			continue;
 		}
 
-		Torpedo.Move(DeltaTime, WrapPositionToViewport);
+		auto& Motion = TorpedoComponents.Motion[Index];
+
+		Motion.OldPosition          = Motion.Position;
+		Motion.UnwrappedNewPosition = Motion.Position + Motion.Inertia * DeltaTime;
+		Motion.Position             = WrapPositionToViewport(Motion.UnwrappedNewPosition);
+
+		Motion.AddStepMotion(Motion.Inertia * DeltaTime);
+
+		TorpedoComponents.Sprites[Index]->MarkSlotDirty();
 	}
 }
 
@@ -1090,15 +1302,11 @@ TSharedPtr<FTorpedo> UPlayViewBase::GetAvailableTorpedo()
 
 int32 UPlayViewBase::GetIndexOfAvailableTorpedo() const
 {
-	int32 Result = -1;
-
-	for(const auto& TorpedoPtr : Torpedos)
+	for(int32 Index = 0; Index < TorpedoComponents.Num(); Index++)
 	{
-		Result++;
-
-		if(TorpedoPtr->IsDead())
+		if(!TorpedoComponents.Lifetime[Index].IsAlive())
 		{
-			return Result;
+			return Index;
 		}
 	}
 
@@ -1114,12 +1322,23 @@ void UPlayViewBase::RemovePowerup(int32 PowerupIndex)
 		return;
 	}
 
-	Daylon::Uninstall(Powerups[PowerupIndex]);
+	PowerupPool.Release(Powerups[PowerupIndex]);
 
+	PowerupComponents.Release(PowerupIndex, true);
 	Powerups.RemoveAt(PowerupIndex);
 }
 
 
+int32 UPlayViewBase::AddPowerup(TSharedPtr<FPowerup> PowerupPtr)
+{
+	const int32 Index = Powerups.Add(PowerupPtr);
+
+	PowerupComponents.Adopt(*PowerupPtr.Get());
+
+	return Index;
+}
+
+
 void UPlayViewBase::RemovePowerups()
 {
 	while(!Powerups.IsEmpty())
@@ -1133,7 +1352,7 @@ void UPlayViewBase::RemoveTorpedos()
 {
 	for(auto TorpedoPtr : Torpedos)
 	{
-		TorpedoPtr->LifeRemaining = 0.0f;
+		TorpedoPtr->SetLifeRemaining(0.0f);
 		TorpedoPtr->Hide();
 	}
 }
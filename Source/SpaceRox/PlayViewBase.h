@@ -18,6 +18,7 @@
 
 #include "UDaylonParticlesWidget.h"
 #include "UDaylonSpriteWidget.h"
+#include "SDaylonSpriteBatch.h"
 #include "DaylonUtils.h"
 #include "PlayObject.h"
 
@@ -32,9 +33,13 @@
 #include "Asteroids.h"
 #include "EnemyShips.h"
 #include "Explosions.h"
+#include "Collision.h"
 #include "PlayViewBase.generated.h"
 
 
+struct FSimParams;
+
+
 
 enum class EMenuItem : uint8
 {
@@ -94,6 +99,7 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 	// UUserWidget
 	virtual void  NativeOnInitialized                 () override;
 	virtual void  NativeTick                          (const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual int32 NativePaint                         (const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 	virtual void  OnAnimationFinished_Implementation  (const UWidgetAnimation* Animation) override;
 
 
@@ -235,6 +241,25 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 	FSlateFontInfo HighScoreReadoutFont;
 
 
+	// -- Simulation -------------------------------------------------
+
+	// Gameplay is simulated this many times per second, whatever the frame rate
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Simulation, meta = (ClampMin = "30", ClampMax = "480"))
+	float SimulationRate = 120.0f;
+
+	// Splits each step's movement and collision checks during play into this many substeps (raise if fast movers miss collisions)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Simulation, meta = (ClampMin = "1", ClampMax = "8"))
+	int32 SimulationSubsteps = 1;
+
+	// Most steps to simulate in one frame; after a longer hitch, the game slows down instead of catching up
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Simulation, meta = (ClampMin = "1"))
+	int32 MaxSimulationStepsPerFrame = 8;
+
+	// Seeds the random number streams, so a given seed and the same player input replay the same game (use zero to seed from the clock)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Simulation)
+	int32 RandomSeed = 0;
+
+
 	// -- Testing-related properties -------------------------------------------------
 
 	// Number of seconds to delay starting the intro (useful for video captures, use zero for shipping)
@@ -253,11 +278,24 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Testing)
 	int32 NumPowerupsOverride = 0;
 
+	// Use a uniform grid to find which asteroids to collision-test (turn off to test every asteroid, for comparison)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Testing)
+	bool bUseCollisionGrid = true;
+
+	// Make asteroids bounce off each other (the original game lets them pass through)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Testing)
+	bool bAsteroidsCollide = false;
+
 	public:
 	// Make player omnipotent
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Testing)
 	bool bGodMode = false;
 
+	// What the headless FSimWorld needs to play like this view: the rock sizes from its atlases
+	// and its simulation and testing settings. Only reads properties, so it works on the class
+	// default object of the play view blueprint.
+	FSimParams GetSimParams() const;
+
 	
 	// -- Design-time widgets -----------------------------------------------------------
 
@@ -360,9 +398,7 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 
 	protected:
 
-	virtual TFunction<FVector2D(const FVector2D&)> GetWrapPositionFunction() const override { return WrapPositionToViewport; }
-
-	virtual void                          AddScheduledTask             (Daylon::FScheduledTask& Task) override { ScheduledTasks.Add(Task); }
+	virtual void                          AddScheduledTask             (Daylon::FScheduledTask&& Task) override { Tasks.Add(MoveTemp(Task)); }
 	virtual void                          ScheduleExplosion            (float When, const FVector2D& P, const FVector2D& Inertia, const FDaylonParticlesParams& Params) override;
 										    						    
 	virtual FVector2D                     WrapPosition                 (const FVector2D& P) override { return WrapPositionToViewport(P); }
@@ -372,17 +408,19 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 	virtual Daylon::FLoopedSound&         GetBigEnemySoundLoop         () override { return BigEnemyShipSoundLoop; }
 	virtual Daylon::FLoopedSound&         GetSmallEnemySoundLoop       () override { return SmallEnemyShipSoundLoop; }
 
-	virtual const FDaylonSpriteAtlas&     GetBigEnemyAtlas             () const override { return BigEnemyAtlas   ->Atlas; }
-	virtual const FDaylonSpriteAtlas&     GetSmallEnemyAtlas           () const override { return SmallEnemyAtlas ->Atlas; }
-	virtual const FDaylonSpriteAtlas&     GetScavengerAtlas            () const override { return ScavengerAtlas  ->Atlas; }
-	virtual const FDaylonSpriteAtlas&     GetMiniboss1Atlas            () const override { return Miniboss1Atlas  ->Atlas; }
-	virtual const FDaylonSpriteAtlas&     GetMiniboss2Atlas            () const override { return Miniboss2Atlas  ->Atlas; }
-	virtual const FDaylonSpriteAtlas&     GetMediumAsteroidAtlas       () const override { return MediumRockAtlas ->Atlas; }
-	virtual const FDaylonSpriteAtlas&     GetSmallAsteroidAtlas        () const override { return SmallRockAtlas  ->Atlas; }
-	virtual const FDaylonSpriteAtlas&     GetDefensesAtlas             () const override { return DefensesAtlas   ->Atlas; }
+	virtual const FDaylonSpriteAtlasHandle& GetBigEnemyAtlas           () const override { return BigEnemyAtlas   ->GetHandle(); }
+	virtual const FDaylonSpriteAtlasHandle& GetSmallEnemyAtlas         () const override { return SmallEnemyAtlas ->GetHandle(); }
+	virtual const FDaylonSpriteAtlasHandle& GetScavengerAtlas          () const override { return ScavengerAtlas  ->GetHandle(); }
+	virtual const FDaylonSpriteAtlasHandle& GetMiniboss1Atlas          () const override { return Miniboss1Atlas  ->GetHandle(); }
+	virtual const FDaylonSpriteAtlasHandle& GetMiniboss2Atlas          () const override { return Miniboss2Atlas  ->GetHandle(); }
+	virtual const FDaylonSpriteAtlasHandle& GetMediumAsteroidAtlas     () const override { return MediumRockAtlas ->GetHandle(); }
+	virtual const FDaylonSpriteAtlasHandle& GetSmallAsteroidAtlas      () const override { return SmallRockAtlas  ->GetHandle(); }
+	virtual const FDaylonSpriteAtlasHandle& GetDefensesAtlas           () const override { return DefensesAtlas   ->GetHandle(); }
 																    
 	virtual FAsteroids&                   GetAsteroids                 () override { return Asteroids; }
-	virtual TArray<TSharedPtr<FPowerup>>& GetPowerups                  () override { return Powerups; }
+	virtual const TArray<TSharedPtr<FPowerup>>& GetPowerups            () const override { return Powerups; }
+	virtual int32                         AddPowerup                   (TSharedPtr<FPowerup> PowerupPtr) override;
+	virtual Daylon::TPlayObjectPool<FPowerup>& GetPowerupPool          () override { return PowerupPool; }
 	virtual FExplosions&                  GetExplosions                () override { return Explosions; }
 	virtual FShieldExplosions&            GetShieldExplosions          () override { return ShieldExplosions; }
 
@@ -402,17 +440,11 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 	virtual bool                          IsGodModeActive              () const override { return bGodMode; }
 	virtual void                          IncreasePlayerScoreBy        (int32 Amount) override;
 
-	virtual float                         AdjustTimeUntilNextEnemyShip (float Amount) override { TimeUntilNextEnemyShip += Amount; return TimeUntilNextEnemyShip; }
-	virtual float                         GetTimeUntilNextEnemyShip    () const override { return TimeUntilNextEnemyShip; }
-	virtual void                          SetTimeUntilNextEnemyShip    (float Value) override { TimeUntilNextEnemyShip = Value; }
-
-	virtual float                         AdjustTimeUntilNextScavenger (float Amount) override { TimeUntilNextScavenger += Amount; return TimeUntilNextScavenger; }
-	virtual float                         GetTimeUntilNextScavenger    () const override { return TimeUntilNextScavenger; }
-	virtual void                          SetTimeUntilNextScavenger    (float Value) override { TimeUntilNextScavenger = Value; }
+	virtual Daylon::FCountdown&           GetEnemyShipCountdown        () override { return EnemyShipCountdown; }
+	virtual Daylon::FCountdown&           GetScavengerCountdown        () override { return ScavengerCountdown; }
+	virtual Daylon::FCountdown&           GetBossCountdown             () override { return BossCountdown; }
 
-	virtual float                         AdjustTimeUntilNextBoss      (float Amount) override { TimeUntilNextBoss += Amount; return TimeUntilNextBoss; }
-	virtual float                         GetTimeUntilNextBoss         () const override { return TimeUntilNextBoss; }
-	virtual void                          SetTimeUntilNextBoss         (float Value) override { TimeUntilNextBoss = Value; }
+	virtual Daylon::FRng&                 GetRng                       (ERngStream Stream) override { return Rngs[(int32)Stream]; }
 
 									      
 
@@ -430,8 +462,11 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 	void      InitializeVariables        ();
 	void      InitializeAtlases          ();
 	void      InitializeSoundLoops       ();
+	void      TestPhysics                ();
 	void      CreatePlayerShip           ();
 	void      CreateTorpedos             ();
+	void      InitializeSpriteBatches    ();
+	void      LogPoolStats               () const;
 
 	void      SpawnAsteroids             (int32 NumAsteroids);
 	void      SpawnPowerup               (TSharedPtr<FPowerup>& PowerupPtr, const FVector2D& P);
@@ -458,7 +493,7 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 	void      UpdateMenuReadout          ();
 	void      NavigateMenu               (Daylon::EListNavigationDirection Direction);
 
-	static FVector2D WrapPositionToViewport  (const FVector2D& P);
+	static FVector2D WrapPositionToViewport  (const FVector2D& P) { return GetViewportWrap()(P); }
 
 	int32     GetIndexOfAvailableTorpedo () const;
 	void      UpdatePlayerShipReadout    (EPowerup PowerupKind);
@@ -467,8 +502,13 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 
 	TSharedPtr<FPlayerShip>           PlayerShip;
 	TArray<TSharedPtr<FTorpedo>>      Torpedos;
+	Daylon::FPlayObjectStore          TorpedoComponents; // Indexed like Torpedos
 	FAsteroids                        Asteroids;
 	FExplosions                       Explosions; 
+
+	// Rocks and torpedos are drawn by these rather than by their own widgets.
+	TSharedPtr<SDaylonSpriteBatch>    RockBatches[3];    // Big, medium, small
+	TSharedPtr<SDaylonSpriteBatch>    TorpedoBatch;
 	FShieldExplosions                 ShieldExplosions;
 
 
@@ -477,12 +517,31 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 	void ProcessWaveTransition      (float DeltaTime);
 	void ProcessPlayerShipSpawn     (float DeltaTime);
 
-	void CheckCollisions            ();
+	void                       CheckCollisions                    ();
+	void                       DetectCollisions                   (FCollisionContacts& Contacts);
+	int32                      GetNumCollisionWorkItems           () const;
+	void                       DetectCollisionsForItem            (int32 Item, const FPlayerShipCollisionShape& PlayerShipShape, FCollisionScratch& Scratch);
+	FPlayerShipCollisionShape  GetPlayerShipCollisionShape        () const;
+	void                       DetectTorpedoCollisions            (int32 TorpedoIndex, const FPlayerShipCollisionShape& PlayerShipShape, FCollisionScratch& Scratch);
+	void                       DetectScavengerPowerupCollisions   (int32 ScavengerIndex, FCollisionScratch& Scratch);
+	void                       DetectPlayerShipCollisions         (const FPlayerShipCollisionShape& PlayerShipShape, FCollisionScratch& Scratch);
+	void                       DetectEnemyShipAsteroidCollisions  (int32 EnemyIndex, FCollisionScratch& Scratch);
+	void                       DetectScavengerAsteroidCollisions  (int32 ScavengerIndex, FCollisionScratch& Scratch);
+	void                       DetectBossAsteroidCollisions       (int32 BossIndex, FCollisionScratch& Scratch);
+	void                       ResolveCollisions                  (FCollisionContacts& Contacts);
+	bool                       ResolveContact                     (const FCollisionContact& Contact, FCollisionContacts& Contacts);
+	void                       GetAsteroidCandidates              (const FBox2d& Bounds, TArray<FAsteroidCandidate>& Candidates) const;
+	void                       PublishCollisionStats              ();
+	int32                      PaintCollisionOverlay              (const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId) const;
+
 	void ProcessPlayerShipCollision (float Mass = 0.0f, const FVector2D* PositionOther = nullptr, FVector2D* InertiaOther = nullptr);
 
 	void UpdateTorpedos             (float DeltaTime);
+	void UpdateSpriteBatches        ();
 	void UpdatePowerups             (float DeltaTime);
 	void UpdateTasks                (float DeltaTime);
+	void UpdatePlayfield            (float DeltaTime, bool bWithPlayerShip);
+	void Simulate                   (float DeltaTime); // One fixed step
 
 
 	// -- Member variables -----------------------------------------------------------
@@ -492,12 +551,19 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 	Daylon::FLoopedSound            BigEnemyShipSoundLoop;
 	Daylon::FLoopedSound            SmallEnemyShipSoundLoop;
 	EGameState                      GameState;
-	TArray<Daylon::FScheduledTask>  ScheduledTasks;
-	TArray<Daylon::FDurationTask>   DurationTasks;
+	Daylon::FTaskScheduler          Tasks;              // Also the clock for the countdowns below
+	Daylon::FJobGraph               PlayfieldJobs;      // Rebuilt by each UpdatePlayfield
+	Daylon::FRng                    Rngs[(int32)ERngStream::Count];
 	TArray<TSharedPtr<FPowerup>>    Powerups; // Not including those inside asteroids
-	float                           TimeUntilNextEnemyShip;
-	float                           TimeUntilNextBoss;
-	float                           TimeUntilNextScavenger;
+	Daylon::FPlayObjectStore        PowerupComponents;  // Indexed like Powerups
+	Daylon::TPlayObjectPool<FPowerup> PowerupPool;      // All powerups, including those inside asteroids or scavengers
+	TArray<FCollisionScratch>       CollisionScratch;   // One per detection thread
+	FCollisionContacts              CollisionContacts;  // Scratch list for CheckCollisions
+	FCollisionStats                 CollisionStats;     // From the last DetectCollisions, all threads
+	TArray<FCollisionDebugShape>    CollisionShapes;    // Ditto, only while the collision overlay is on
+	Daylon::FCountdown              EnemyShipCountdown;
+	Daylon::FCountdown              BossCountdown;
+	Daylon::FCountdown              ScavengerCountdown; // Paused while scavengers are present
 
 	FEnemyShips                     EnemyShips;
 
@@ -512,13 +578,14 @@ class SPACEROX_API UPlayViewBase : public UUserWidget, public IArena
 	EMenuItem                       SelectedMenuItem;
 	int32                           NumPlayerShips;
 	int32                           WaveNumber;
-	float                           TimeUntilNextWave;
+	Daylon::FCountdown              WaveCountdown;      // Paused while a wave is in progress
 	float                           ThrustSoundTimeRemaining;
 	float                           StartMsgAnimationAge;
-	float                           TimeUntilIntroStateEnds;
-	float                           TimeUntilNextPlayerShip;
-	float                           TimeUntilGameOverStateEnds;
+	Daylon::FCountdown              IntroStateCountdown;
+	Daylon::FCountdown              PlayerShipCountdown;
+	Daylon::FCountdown              GameOverStateCountdown;
 	float                           MruHighScoreAnimationAge;
+	float                           SimulationTimeAccumulator; // Frame time not yet simulated
 	bool                            IsInitialized;
 	bool                            bHighScoreWasEntered;
 };
@@ -6,6 +6,9 @@
 #include "PlayViewBase.h"
 #include "Logging.h"
 #include "Constants.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Styling/CoreStyle.h"
 
 
 
@@ -18,482 +21,1131 @@
 #endif
 
 
+static TAutoConsoleVariable<int32> CVarCollisionThreads(
+	TEXT("SpaceRox.CollisionThreads"),
+	0,
+	TEXT("Number of threads for collision detection. 0 = one per core, 1 = game thread only."));
+
+
+static TAutoConsoleVariable<int32> CVarCollisionOverlay(
+	TEXT("SpaceRox.CollisionOverlay"),
+	0,
+	TEXT("1 = draw the shapes tested for collisions (red if they hit) and per-kind test counts, hits and times."));
+
+
+// Use "stat SpaceRoxCollisions" to see these.
+
+DECLARE_STATS_GROUP(TEXT("SpaceRox Collisions"), STATGROUP_SpaceRoxCollisions, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT(TEXT("Detect collisions"),  STAT_DetectCollisions,  STATGROUP_SpaceRoxCollisions);
+DECLARE_CYCLE_STAT(TEXT("Resolve collisions"), STAT_ResolveCollisions, STATGROUP_SpaceRoxCollisions);
+
+#define COLLISION_KIND_STATS(Kind, Desc)  \
+	DECLARE_DWORD_COUNTER_STAT (TEXT(Desc " tests"), STAT_##Kind##Tests, STATGROUP_SpaceRoxCollisions); \
+	DECLARE_DWORD_COUNTER_STAT (TEXT(Desc " hits"),  STAT_##Kind##Hits,  STATGROUP_SpaceRoxCollisions); \
+	DECLARE_CYCLE_STAT         (TEXT(Desc),          STAT_##Kind##Time,  STATGROUP_SpaceRoxCollisions);
+
+COLLISION_KIND_STATS(TorpedoAsteroid,     "Torpedo vs. rock")
+COLLISION_KIND_STATS(TorpedoPlayerShip,   "Torpedo vs. player ship")
+COLLISION_KIND_STATS(TorpedoEnemyShip,    "Torpedo vs. enemy ship")
+COLLISION_KIND_STATS(TorpedoScavenger,    "Torpedo vs. scavenger")
+COLLISION_KIND_STATS(TorpedoBoss,         "Torpedo vs. boss")
+COLLISION_KIND_STATS(ScavengerPowerup,    "Scavenger vs. powerup")
+COLLISION_KIND_STATS(PlayerShipAsteroid,  "Player ship vs. rock")
+COLLISION_KIND_STATS(PlayerShipEnemyShip, "Player ship vs. enemy ship")
+COLLISION_KIND_STATS(PlayerShipScavenger, "Player ship vs. scavenger")
+COLLISION_KIND_STATS(PlayerShipBoss,      "Player ship vs. boss")
+COLLISION_KIND_STATS(PlayerShipPowerup,   "Player ship vs. powerup")
+COLLISION_KIND_STATS(EnemyShipAsteroid,   "Enemy ship vs. rock")
+COLLISION_KIND_STATS(ScavengerAsteroid,   "Scavenger vs. rock")
+COLLISION_KIND_STATS(BossAsteroid,        "Boss vs. rock")
+
+#undef COLLISION_KIND_STATS
+
+
+template <typename TestT>
+static bool TestAcrossWrap(const FBox2d& TargetBounds, const FBox2d& OtherBounds, TestT Test)
+{
+	// Run Test(Offset) with the target where it appears relative to the other object:
+	// in place and, if either object is in the viewport's edge band, across the wrap seams.
+	// Objects away from the edges cost a single test.
+
+	FVector2D Offsets[Daylon::MaxWrapOffsets];
+
+	const int32 NumOffsets = Daylon::GetWrapOffsets(TargetBounds, OtherBounds, ViewportSize, Offsets);
+
+	for(int32 OffsetIndex = 0; OffsetIndex < NumOffsets; OffsetIndex++)
+	{
+		if(Test(Offsets[OffsetIndex]))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+void UPlayViewBase::GetAsteroidCandidates(const FBox2d& Bounds, TArray<FAsteroidCandidate>& Candidates) const
+{
+	// Return, in ascending index order, the asteroids that might touch Bounds.
+	// Both paths visit asteroids in the same order so that kills happen identically.
+
+	Asteroids.GetCollisionCandidates(Bounds, bUseCollisionGrid, Candidates);
+}
+
+
 void UPlayViewBase::CheckCollisions()
 {
-	// Build a triangle representing the player ship.
+	if(bUseCollisionGrid)
+	{
+		Asteroids.RebuildGrid();
+	}
+
+	CollisionContacts.Reset(Asteroids.Num(), EnemyShips.NumShips(), EnemyShips.NumScavengers(), EnemyShips.NumBosses(), Powerups.Num());
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_DetectCollisions);
+		DetectCollisions(CollisionContacts);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ResolveCollisions);
+		ResolveCollisions(CollisionContacts);
+	}
+
+	PublishCollisionStats();
+}
+
+
+int32 UPlayViewBase::GetNumCollisionWorkItems() const
+{
+	// Work items, in order: each torpedo, each scavenger vs. powerups, the player ship,
+	// each enemy ship vs. rocks, each scavenger vs. rocks, each boss vs. rocks.
+
+	return Torpedos.Num() + EnemyShips.NumScavengers() + 1 + EnemyShips.NumShips() + EnemyShips.NumScavengers() + EnemyShips.NumBosses();
+}
+
+
+void UPlayViewBase::DetectCollisions(FCollisionContacts& Contacts)
+{
+	// Find what is touching what without changing any play object. See Collision.h.
+
+	const FPlayerShipCollisionShape PlayerShipShape = GetPlayerShipCollisionShape();
+
+	const int32 NumItems     = GetNumCollisionWorkItems();
+	const bool  RecordShapes = (CVarCollisionOverlay.GetValueOnGameThread() != 0);
+
+	// Slate only calls NativePaint (which draws the overlay) again when this widget
+	// is invalidated, so keep it volatile while the overlay is on.
+
+	if(bIsVolatile != RecordShapes)
+	{
+		ForceVolatile(RecordShapes);
+	}
+
+	int32 NumThreads = CVarCollisionThreads.GetValueOnGameThread();
+
+	if(NumThreads <= 0)
+	{
+		NumThreads = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	}
+
+	// Don't hand out runs so short that scheduling them costs more than testing them.
+
+	const int32 NumChunks = FMath::Clamp(FMath::Min(NumThreads, NumItems / MinCollisionWorkItemsPerThread), 1, NumItems);
+
+	if(CollisionScratch.Num() < NumChunks)
+	{
+		CollisionScratch.SetNum(NumChunks);
+	}
+
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		auto& Scratch = CollisionScratch[ChunkIndex];
+
+		Scratch.Contacts.Reset();
+		Scratch.Stats.Reset();
+		Scratch.Shapes.Reset();
+
+		Scratch.RecordShapes = RecordShapes;
+
+		const int32 FirstItem = (int32)((int64)NumItems *  ChunkIndex      / NumChunks);
+		const int32 EndItem   = (int32)((int64)NumItems * (ChunkIndex + 1) / NumChunks);
+
+		for(int32 Item = FirstItem; Item < EndItem; Item++)
+		{
+			DetectCollisionsForItem(Item, PlayerShipShape, Scratch);
+		}
+	},
+	(NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None));
+
+	CollisionStats.Reset();
+	CollisionShapes.Reset();
+
+	for(int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+	{
+		const auto& Scratch = CollisionScratch[ChunkIndex];
+
+		Contacts.Contacts.Append(Scratch.Contacts);
+		CollisionStats.Accumulate(Scratch.Stats);
+		CollisionShapes.Append(Scratch.Shapes);
+	}
+
+	for(const auto& Contact : Contacts.Contacts)
+	{
+		CollisionStats.Hits[(int32)Contact.Kind]++;
+	}
+}
+
+
+void UPlayViewBase::DetectCollisionsForItem(int32 Item, const FPlayerShipCollisionShape& PlayerShipShape, FCollisionScratch& Scratch)
+{
+	// Map the item number back to its object; see GetNumCollisionWorkItems.
+	// Enemies are visited from the last index down, like the loops this replaced.
+
+	if(Item < Torpedos.Num())
+	{
+		DetectTorpedoCollisions(Item, PlayerShipShape, Scratch);
+		return;
+	}
+
+	Item -= Torpedos.Num();
+
+	if(Item < EnemyShips.NumScavengers())
+	{
+		DetectScavengerPowerupCollisions(EnemyShips.NumScavengers() - 1 - Item, Scratch);
+		return;
+	}
+
+	Item -= EnemyShips.NumScavengers();
+
+	if(Item == 0)
+	{
+		DetectPlayerShipCollisions(PlayerShipShape, Scratch);
+		return;
+	}
+
+	Item--;
+
+	if(Item < EnemyShips.NumShips())
+	{
+		DetectEnemyShipAsteroidCollisions(EnemyShips.NumShips() - 1 - Item, Scratch);
+		return;
+	}
+
+	Item -= EnemyShips.NumShips();
+
+	if(Item < EnemyShips.NumScavengers())
+	{
+		DetectScavengerAsteroidCollisions(EnemyShips.NumScavengers() - 1 - Item, Scratch);
+		return;
+	}
+
+	Item -= EnemyShips.NumScavengers();
+
+	if(Item < EnemyShips.NumBosses())
+	{
+		DetectBossAsteroidCollisions(EnemyShips.NumBosses() - 1 - Item, Scratch);
+	}
+}
+
+
+FPlayerShipCollisionShape UPlayViewBase::GetPlayerShipCollisionShape() const
+{
+	if(!IsPlayerShipPresent())
+	{
+		return FPlayerShipCollisionShape();
+	}
+
+	return MakePlayerShipCollisionShape(PlayerShip->GetMotion(), PlayerShip->GetCollision());
+}
+
+
+void UPlayViewBase::DetectTorpedoCollisions(int32 TorpedoIndex, const FPlayerShipCollisionShape& PlayerShipShape, FCollisionScratch& Scratch)
+{
+	// See what an active torpedo has collided with.
+
+	if(!TorpedoComponents.Lifetime[TorpedoIndex].IsAlive())
+	{
+		return;
+	}
+
+	const auto& Torpedo = *Torpedos[TorpedoIndex].Get();
+
+	auto& Contacts = Scratch.Contacts;
+	auto& Stats    = Scratch.Stats;
+
+	// Objects near the viewport edges are also tested where they appear across the wrap seams
+	// (e.g. a big rock partly visible on the west edge while its centroid has wrapped to the east edge)
+	// by adding a candidate's wrap offset to its positions.
+
+	const auto& TorpedoMotion = TorpedoComponents.Motion[TorpedoIndex];
+
+	const FVector2D OldP     = TorpedoMotion.OldPosition;
+	const FVector2D CurrentP = TorpedoMotion.UnwrappedNewPosition;
+
+	const FBox2d TorpedoBounds = MakeSweptBounds(OldP, CurrentP, 0.0);
+
+	Scratch.AddDebugLine(OldP, CurrentP, false);
+
+	{
+		// See if torpedo hit any rocks.
+
+		FCollisionStatScope StatScope(Stats, ECollisionKind::TorpedoAsteroid);
+
+		GetAsteroidCandidates(TorpedoBounds, Scratch.AsteroidCandidates);
+
+		Stats.CountTests(ECollisionKind::TorpedoAsteroid, Scratch.AsteroidCandidates.Num());
+
+		DetectTorpedoAsteroidHits(OldP, CurrentP, Asteroids.GetComponents().Motion, Asteroids.GetComponents().Collision, Scratch);
+
+		for(int32 CandidateIndex = 0; CandidateIndex < Scratch.AsteroidCandidates.Num(); CandidateIndex++)
+		{
+			const auto& Candidate = Scratch.AsteroidCandidates[CandidateIndex];
+
+			const auto& Asteroid       = Asteroids.GetComponents().Motion[Candidate.Index];
+			const auto  AsteroidRadius = Asteroids.GetComponents().Collision[Candidate.Index].GetRadius();
+
+			const auto& Offset = Candidate.Offset;
+
+			const bool Hit = Scratch.AsteroidHits[CandidateIndex];
+
+			Scratch.AddDebugCircle(Asteroid.Position + Offset, AsteroidRadius, Hit);
+
+			if(Hit)
+			{
+				AddCollisionContact(Contacts, ECollisionKind::TorpedoAsteroid, TorpedoIndex, Candidate.Index, Offset);
+			}
+		}
+	}
+		
+	if(!Torpedo.FiredByPlayer && PlayerShipShape.IsPresent)
+	{
+		// See if a torpedo the player didn't fire hit the player ship.
+
+		FCollisionStatScope StatScope(Stats, ECollisionKind::TorpedoPlayerShip);
+
+		const bool Hit = TestAcrossWrap(TorpedoBounds, PlayerShipShape.Bounds, [&](const FVector2D& Offset)
+		{
+			Stats.CountTests(ECollisionKind::TorpedoPlayerShip);
+			return Daylon::DoesLineSegmentIntersectTriangle(OldP + Offset, CurrentP + Offset, PlayerShipShape.Triangle);
+		});
+
+		if(Hit)
+		{
+			AddCollisionContact(Contacts, ECollisionKind::TorpedoPlayerShip, TorpedoIndex, INDEX_NONE);
+		}
+	}
+
+	if(Torpedo.FiredByPlayer)
+	{
+		// See if the torpedo hit an enemy ship.
+
+		FCollisionStatScope StatScope(Stats, ECollisionKind::TorpedoEnemyShip);
+
+		for(int32 EnemyIndex = EnemyShips.NumShips() - 1; EnemyIndex >= 0; EnemyIndex--)
+		{
+			const auto& EnemyShip = EnemyShips.GetShip(EnemyIndex);
+
+			const auto EnemyBounds = MakeSweptBounds(EnemyShip.GetPosition(), EnemyShip.GetPosition(), EnemyShip.GetRadius());
+
+			const bool Hit = TestAcrossWrap(EnemyBounds, TorpedoBounds, [&](const FVector2D& Offset)
+			{
+				Stats.CountTests(ECollisionKind::TorpedoEnemyShip);
+				return Daylon::DoesLineSegmentIntersectCircle(OldP, CurrentP, EnemyShip.GetPosition() + Offset, EnemyShip.GetRadius());
+			});
+
+			Scratch.AddDebugCircle(EnemyShip.GetPosition(), EnemyShip.GetRadius(), Hit);
+
+			if(Hit)
+			{
+				AddCollisionContact(Contacts, ECollisionKind::TorpedoEnemyShip, TorpedoIndex, EnemyIndex);
+			}
+		}
+	}
+
+	if(Torpedo.FiredByPlayer)
+	{
+		// See if the torpedo hit a scavenger.
+
+		FCollisionStatScope StatScope(Stats, ECollisionKind::TorpedoScavenger);
+
+		for(int32 ScavengerIndex = EnemyShips.NumScavengers() - 1; ScavengerIndex >= 0; ScavengerIndex--)
+		{
+			const auto& Scavenger = EnemyShips.GetScavenger(ScavengerIndex);
+
+			const auto ScavengerBounds = MakeSweptBounds(Scavenger.GetPosition(), Scavenger.GetPosition(), Scavenger.GetRadius());
+
+			const bool Hit = TestAcrossWrap(ScavengerBounds, TorpedoBounds, [&](const FVector2D& Offset)
+			{
+				Stats.CountTests(ECollisionKind::TorpedoScavenger);
+				return Daylon::DoesLineSegmentIntersectCircle(OldP, CurrentP, Scavenger.GetPosition() + Offset, Scavenger.GetRadius());
+			});
+
+			Scratch.AddDebugCircle(Scavenger.GetPosition(), Scavenger.GetRadius(), Hit);
+
+			if(Hit)
+			{
+				AddCollisionContact(Contacts, ECollisionKind::TorpedoScavenger, TorpedoIndex, ScavengerIndex);
+			}
+		}
+	}
+
+	{
+		// Let bosses be hit by any torpedo, not just ours.
+
+		FCollisionStatScope StatScope(Stats, ECollisionKind::TorpedoBoss);
+
+		for(int32 BossIndex = EnemyShips.NumBosses() - 1; BossIndex >= 0; BossIndex--)
+		{
+			const auto& Boss = EnemyShips.GetBoss(BossIndex);
+
+			const auto BossBounds = MakeSweptBounds(Boss.GetPosition(), Boss.GetPosition(), Boss.GetCollisionRadius());
+
+			int32     Part;
+			int32     ShieldSegmentIndex;
+			FVector2D BossOffset;
+
+			const bool Hit = TestAcrossWrap(BossBounds, TorpedoBounds, [&](const FVector2D& Offset)
+			{
+				// The boss tests in its own space, so move the torpedo the other way.
+				Stats.CountTests(ECollisionKind::TorpedoBoss);
+				Part = Boss.CheckCollision(OldP - Offset, CurrentP - Offset, ShieldSegmentIndex);
+				BossOffset = Offset;
+				return (Part != INDEX_NONE);
+			});
+
+			Scratch.AddDebugCircle(Boss.GetPosition(), Boss.GetCollisionRadius(), Hit);
+
+			if(Hit)
+			{
+				auto& Contact = AddCollisionContact(Contacts, ECollisionKind::TorpedoBoss, TorpedoIndex, BossIndex, BossOffset);
+
+				Contact.Part               = Part;
+				Contact.ShieldSegmentIndex = ShieldSegmentIndex;
+			}
+		}
+	}
+}
+
+
+void UPlayViewBase::DetectScavengerPowerupCollisions(int32 ScavengerIndex, FCollisionScratch& Scratch)
+{
+	// Did a scavenger collide with a powerup?
+
+	auto& Stats = Scratch.Stats;
+
+	FCollisionStatScope StatScope(Stats, ECollisionKind::ScavengerPowerup);
+
+	const auto& Scavenger = EnemyShips.GetScavenger(ScavengerIndex);
+
+	const auto ScavengerBounds = MakeSweptBounds(Scavenger.GetPosition(), Scavenger.GetPosition(), Scavenger.GetRadius());
+
+	for(int32 PowerupIndex = 0; PowerupIndex < Powerups.Num(); PowerupIndex++)
+	{
+		const auto& Powerup = *Powerups[PowerupIndex].Get();
+
+		const auto PowerupBounds = MakeSweptBounds(Powerup.GetPosition(), Powerup.GetPosition(), Powerup.GetRadius());
+
+		const bool Hit = TestAcrossWrap(PowerupBounds, ScavengerBounds, [&](const FVector2D& Offset)
+		{
+			Stats.CountTests(ECollisionKind::ScavengerPowerup);
+			return (FVector2D::Distance(Scavenger.GetPosition(), Powerup.GetPosition() + Offset) < Scavenger.GetRadius() + Powerup.GetRadius());
+		});
+
+		if(Hit)
+		{
+			AddCollisionContact(Scratch.Contacts, ECollisionKind::ScavengerPowerup, ScavengerIndex, PowerupIndex);
+		}
+	}
+}
+
+
+void UPlayViewBase::DetectPlayerShipCollisions(const FPlayerShipCollisionShape& PlayerShipShape, FCollisionScratch& Scratch)
+{
+	if(!PlayerShipShape.IsPresent)
+	{
+		return;
+	}
+
+	auto& Contacts = Scratch.Contacts;
+	auto& Stats    = Scratch.Stats;
+
+	const auto& PlayerShipLineStart = PlayerShipShape.LineStart;
+	const auto& PlayerShipLineEnd   = PlayerShipShape.LineEnd;
+	const auto& PlayerShipTriangle  = PlayerShipShape.Triangle;
+	const auto& PlayerShipBounds    = PlayerShipShape.Bounds;
+
+	Scratch.AddDebugLine(PlayerShipLineStart, PlayerShipLineEnd, false);
+	Scratch.AddDebugLine(PlayerShipTriangle[0], PlayerShipTriangle[1], false);
+	Scratch.AddDebugLine(PlayerShipTriangle[1], PlayerShipTriangle[2], false);
+	Scratch.AddDebugLine(PlayerShipTriangle[2], PlayerShipTriangle[0], false);
+
+	{
+		// Check if player ship collided with a rock
+
+		FCollisionStatScope StatScope(Stats, ECollisionKind::PlayerShipAsteroid);
+
+		GetAsteroidCandidates(PlayerShipBounds, Scratch.AsteroidCandidates);
+
+		Stats.CountTests(ECollisionKind::PlayerShipAsteroid, Scratch.AsteroidCandidates.Num());
+
+		for(const auto& Candidate : Scratch.AsteroidCandidates)
+		{
+			const auto& Asteroid       = Asteroids.GetComponents().Motion[Candidate.Index];
+			const auto  AsteroidRadius = Asteroids.GetComponents().Collision[Candidate.Index].GetRadius();
+
+			const auto& Offset = Candidate.Offset;
+
+			const bool Hit = DoesPlayerShipHitAsteroid(PlayerShipShape, Asteroid, AsteroidRadius, Offset);
+
+			Scratch.AddDebugCircle(Asteroid.Position + Offset, AsteroidRadius, Hit);
+			Scratch.AddDebugLine(Asteroid.OldPosition + Offset, Asteroid.UnwrappedNewPosition + Offset, Hit);
+
+			if(Hit)
+			{
+				AddCollisionContact(Contacts, ECollisionKind::PlayerShipAsteroid, INDEX_NONE, Candidate.Index, Offset);
+			}
+		}
+	}
+
+	{
+		// Check if enemy ship collided with the player
+
+		FCollisionStatScope StatScope(Stats, ECollisionKind::PlayerShipEnemyShip);
+
+		for(int32 EnemyIndex = EnemyShips.NumShips() - 1; EnemyIndex >= 0; EnemyIndex--)
+		{
+			const auto& EnemyShip = EnemyShips.GetShip(EnemyIndex);
+
+			const auto EnemyBounds = MakeSweptBounds(EnemyShip.GetOldPosition(), EnemyShip.GetUnwrappedNewPosition(), EnemyShip.GetRadius());
+
+			const bool Hit = TestAcrossWrap(EnemyBounds, PlayerShipBounds, [&](const FVector2D& Offset)
+			{
+				Stats.CountTests(ECollisionKind::PlayerShipEnemyShip);
+				return (Daylon::DoesLineSegmentIntersectCircle(PlayerShipLineStart, PlayerShipLineEnd, EnemyShip.GetOldPosition() + Offset, EnemyShip.GetRadius())
+					|| FVector2D::Distance(PlayerShip->GetUnwrappedNewPosition(), EnemyShip.GetUnwrappedNewPosition() + Offset) < EnemyShip.GetRadius() + PlayerShip->GetRadius());
+			});
+
+			Scratch.AddDebugCircle(EnemyShip.GetOldPosition(), EnemyShip.GetRadius(), Hit);
+
+			if(Hit)
+			{
+				AddCollisionContact(Contacts, ECollisionKind::PlayerShipEnemyShip, INDEX_NONE, EnemyIndex);
+			}
+		}
+	}
+
+	{
+		// Check if scavenger collided with the player
+
+		FCollisionStatScope StatScope(Stats, ECollisionKind::PlayerShipScavenger);
+
+		for(int32 ScavengerIndex = EnemyShips.NumScavengers() - 1; ScavengerIndex >= 0; ScavengerIndex--)
+		{
+			const auto& Scavenger = EnemyShips.GetScavenger(ScavengerIndex);
+
+			const auto ScavengerBounds = MakeSweptBounds(Scavenger.GetOldPosition(), Scavenger.GetUnwrappedNewPosition(), Scavenger.GetRadius());
+
+			const bool Hit = TestAcrossWrap(ScavengerBounds, PlayerShipBounds, [&](const FVector2D& Offset)
+			{
+				Stats.CountTests(ECollisionKind::PlayerShipScavenger);
+				return (Daylon::DoesLineSegmentIntersectCircle(PlayerShipLineStart, PlayerShipLineEnd, Scavenger.GetOldPosition() + Offset, Scavenger.GetRadius())
+					|| FVector2D::Distance(PlayerShip->GetUnwrappedNewPosition(), Scavenger.GetUnwrappedNewPosition() + Offset) < Scavenger.GetRadius() + PlayerShip->GetRadius());
+			});
+
+			Scratch.AddDebugCircle(Scavenger.GetOldPosition(), Scavenger.GetRadius(), Hit);
+
+			if(Hit)
+			{
+				AddCollisionContact(Contacts, ECollisionKind::PlayerShipScavenger, INDEX_NONE, ScavengerIndex);
+			}
+		}
+	}
+
+	{
+		// Check if player ship collided with a boss
+
+		FCollisionStatScope StatScope(Stats, ECollisionKind::PlayerShipBoss);
+
+		for(int32 BossIndex = EnemyShips.NumBosses() - 1; BossIndex >= 0; BossIndex--)
+		{
+			const auto& Boss = EnemyShips.GetBoss(BossIndex);
+
+			const auto BossBounds = MakeSweptBounds(Boss.GetPosition(), Boss.GetPosition(), Boss.GetCollisionRadius());
+
+			int32     Part;
+			int32     ShieldSegmentIndex;
+			FVector2D HitPt;
+			FVector2D BossOffset;
+
+			const bool Hit = TestAcrossWrap(BossBounds, PlayerShipBounds, [&](const FVector2D& Offset)
+			{
+				// The boss tests in its own space, so move the player ship the other way.
+				Stats.CountTests(ECollisionKind::PlayerShipBoss);
+				Part = Boss.CheckCollision(PlayerShipLineStart - Offset, PlayerShipLineEnd - Offset, PlayerShip->GetRadius(), ShieldSegmentIndex, HitPt);
+				BossOffset = Offset;
+				return (Part != INDEX_NONE);
+			});
+
+			Scratch.AddDebugCircle(Boss.GetPosition(), Boss.GetCollisionRadius(), Hit);
+
+			if(Hit)
+			{
+				auto& Contact = AddCollisionContact(Contacts, ECollisionKind::PlayerShipBoss, INDEX_NONE, BossIndex, BossOffset);
+
+				// Bring the hit point back into the player ship's space.
+
+				Contact.Part               = Part;
+				Contact.ShieldSegmentIndex = ShieldSegmentIndex;
+				Contact.HitPt              = HitPt + BossOffset;
+			}
+		}
+	}
+
+	{
+		// Check if player ship collided with a powerup
+
+		FCollisionStatScope StatScope(Stats, ECollisionKind::PlayerShipPowerup);
+
+		for(int32 PowerupIndex = Powerups.Num() - 1; PowerupIndex >= 0; PowerupIndex--)
+		{
+			const auto& Powerup = *Powerups[PowerupIndex].Get();
+
+			const auto PowerupBounds = MakeSweptBounds(Powerup.GetOldPosition(), Powerup.GetUnwrappedNewPosition(), Powerup.GetRadius());
+
+			const bool Hit = TestAcrossWrap(PowerupBounds, PlayerShipBounds, [&](const FVector2D& Offset)
+			{
+				Stats.CountTests(ECollisionKind::PlayerShipPowerup);
+				return (Daylon::DoesLineSegmentIntersectCircle(PlayerShipLineStart, PlayerShipLineEnd, Powerup.GetOldPosition() + Offset, Powerup.GetRadius())
+					|| FVector2D::Distance(PlayerShip->GetUnwrappedNewPosition(), Powerup.GetUnwrappedNewPosition() + Offset) < Powerup.GetRadius() + PlayerShip->GetRadius());
+			});
+
+			Scratch.AddDebugCircle(Powerup.GetOldPosition(), Powerup.GetRadius(), Hit);
+
+			if(Hit)
+			{
+				AddCollisionContact(Contacts, ECollisionKind::PlayerShipPowerup, INDEX_NONE, PowerupIndex);
+			}
+		}
+	}
+}
+
+
+void UPlayViewBase::DetectEnemyShipAsteroidCollisions(int32 EnemyIndex, FCollisionScratch& Scratch)
+{
+	// Check if enemy ship collided with an asteroid
+
+	FCollisionStatScope StatScope(Scratch.Stats, ECollisionKind::EnemyShipAsteroid);
+
+	const auto& EnemyShip = EnemyShips.GetShip(EnemyIndex);
+
+	auto EnemyBounds = MakeSweptBounds(EnemyShip.GetPosition(), WrapPositionToViewport(EnemyShip.GetUnwrappedNewPosition()), EnemyShip.GetRadius());
+
+	GetAsteroidCandidates(EnemyBounds, Scratch.AsteroidCandidates);
+
+	Scratch.Stats.CountTests(ECollisionKind::EnemyShipAsteroid, Scratch.AsteroidCandidates.Num());
+
+	for(const auto& Candidate : Scratch.AsteroidCandidates)
+	{
+		const auto& Asteroid       = Asteroids.GetComponents().Motion[Candidate.Index];
+		const auto  AsteroidRadius = Asteroids.GetComponents().Collision[Candidate.Index].GetRadius();
+
+		const auto& Offset = Candidate.Offset;
+
+		const bool Hit = (Daylon::DoesLineSegmentIntersectCircle(Asteroid.OldPosition + Offset, Asteroid.UnwrappedNewPosition + Offset, EnemyShip.GetPosition(), EnemyShip.GetRadius())
+			|| FVector2D::Distance(WrapPositionToViewport(EnemyShip.GetUnwrappedNewPosition()), Asteroid.OldPosition + Offset) < AsteroidRadius + EnemyShip.GetRadius());
+
+		Scratch.AddDebugLine(Asteroid.OldPosition + Offset, Asteroid.UnwrappedNewPosition + Offset, Hit);
+
+		if(Hit)
+		{
+			AddCollisionContact(Scratch.Contacts, ECollisionKind::EnemyShipAsteroid, EnemyIndex, Candidate.Index, Offset);
+		}
+	}
+}
+
+
+void UPlayViewBase::DetectScavengerAsteroidCollisions(int32 ScavengerIndex, FCollisionScratch& Scratch)
+{
+	FCollisionStatScope StatScope(Scratch.Stats, ECollisionKind::ScavengerAsteroid);
 
-	FVector2D PlayerShipTriangle[3]; // tip, LR corner, LL corner.
-	FVector2D PlayerShipLineStart;
-	FVector2D PlayerShipLineEnd;
+	const auto& Scavenger = EnemyShips.GetScavenger(ScavengerIndex);
 
-	if(IsPlayerShipPresent())
+	auto ScavengerBounds = MakeSweptBounds(Scavenger.GetPosition(), WrapPositionToViewport(Scavenger.GetUnwrappedNewPosition()), Scavenger.GetRadius());
+
+	GetAsteroidCandidates(ScavengerBounds, Scratch.AsteroidCandidates);
+
+	Scratch.Stats.CountTests(ECollisionKind::ScavengerAsteroid, Scratch.AsteroidCandidates.Num());
+
+	for(const auto& Candidate : Scratch.AsteroidCandidates)
 	{
-		PlayerShipLineStart = PlayerShip->OldPosition;
-		PlayerShipLineEnd   = PlayerShip->UnwrappedNewPosition;
+		const auto& Asteroid       = Asteroids.GetComponents().Motion[Candidate.Index];
+		const auto  AsteroidRadius = Asteroids.GetComponents().Collision[Candidate.Index].GetRadius();
+
+		const auto& Offset = Candidate.Offset;
+
+		const bool Hit = (Daylon::DoesLineSegmentIntersectCircle(Asteroid.OldPosition + Offset, Asteroid.UnwrappedNewPosition + Offset, Scavenger.GetPosition(), Scavenger.GetRadius())
+			|| FVector2D::Distance(WrapPositionToViewport(Scavenger.GetUnwrappedNewPosition()), Asteroid.OldPosition + Offset) < AsteroidRadius + Scavenger.GetRadius());
+
+		Scratch.AddDebugLine(Asteroid.OldPosition + Offset, Asteroid.UnwrappedNewPosition + Offset, Hit);
+
+		if(Hit)
+		{
+			AddCollisionContact(Scratch.Contacts, ECollisionKind::ScavengerAsteroid, ScavengerIndex, Candidate.Index, Offset);
+		}
+	}
+}
+
+
+void UPlayViewBase::DetectBossAsteroidCollisions(int32 BossIndex, FCollisionScratch& Scratch)
+{
+	FCollisionStatScope StatScope(Scratch.Stats, ECollisionKind::BossAsteroid);
+
+	const auto& Boss = EnemyShips.GetBoss(BossIndex);
+
+	int32 ShieldSegmentIndex;
+	FVector2D HitPt;
 
-		float PlayerShipH = PlayerShip->GetSize().Y;
-		float PlayerShipW = PlayerShipH * (73.0f / 95.0f);
+	GetAsteroidCandidates(MakeSweptBounds(Boss.GetPosition(), Boss.GetPosition(), Boss.GetCollisionRadius()), Scratch.AsteroidCandidates);
 
-		PlayerShipTriangle[0].Set(0.0f,            -PlayerShipH / 2);
-		PlayerShipTriangle[1].Set( PlayerShipW / 2, PlayerShipH / 2);
-		PlayerShipTriangle[2].Set(-PlayerShipW / 2, PlayerShipH / 2);
+	Scratch.Stats.CountTests(ECollisionKind::BossAsteroid, Scratch.AsteroidCandidates.Num());
 
-		// Triangle is pointing up, vertices relative to its center. We need to rotate it for its current angle.
-			 
-		auto ShipAngle = PlayerShip->GetAngle();
+	for(const auto& Candidate : Scratch.AsteroidCandidates)
+	{
+		const auto& Asteroid       = Asteroids.GetComponents().Motion[Candidate.Index];
+		const auto  AsteroidRadius = Asteroids.GetComponents().Collision[Candidate.Index].GetRadius();
+
+		const auto& Offset = Candidate.Offset;
 
-		// Rotate and translate the triangle to match its current display space.
+		const auto Part = Boss.CheckCollision(Asteroid.OldPosition + Offset, Asteroid.UnwrappedNewPosition + Offset, AsteroidRadius, ShieldSegmentIndex, HitPt);
 
-		for(auto& Triangle : PlayerShipTriangle)
+		Scratch.AddDebugCircle(Asteroid.UnwrappedNewPosition + Offset, AsteroidRadius, Part != INDEX_NONE);
+
+		if(Part != INDEX_NONE)
 		{
-			Triangle = Daylon::Rotate(Triangle, ShipAngle);
+			auto& Contact = AddCollisionContact(Scratch.Contacts, ECollisionKind::BossAsteroid, BossIndex, Candidate.Index, Offset);
 
-			// Use the ship's old position because the current position can cause unwanted self-intersections.
-			Triangle += PlayerShip->OldPosition;
+			Contact.Part               = Part;
+			Contact.ShieldSegmentIndex = ShieldSegmentIndex;
+			Contact.HitPt              = HitPt;
 		}
+	}
+}
 
-		// Get the line segment for the player ship.
-		// Line segments are used to better detect collisions involving fast-moving objects.
 
-		PlayerShipLineStart = PlayerShip->OldPosition;
-		PlayerShipLineEnd   = PlayerShip->UnwrappedNewPosition;
-	}
+void UPlayViewBase::ResolveCollisions(FCollisionContacts& Contacts)
+{
+	// Apply the contacts found by DetectCollisions in order. Objects that die are only
+	// marked here; they're removed (and rocks split) once all contacts have been handled.
 
-	// See what the active torpedos have collided with.
+	const FCollisionContact* LastResolved = nullptr;
 
-	for(auto& TorpedoPtr : Torpedos)
+	for(const auto& Contact : Contacts.Contacts)
 	{
-		auto& Torpedo = *TorpedoPtr.Get();
-
-		if(!Torpedo.IsAlive())
+		if(LastResolved != nullptr && LastResolved->Kind == Contact.Kind && LastResolved->Subject == Contact.Subject)
 		{
+			// Subject already hit something of this kind.
 			continue;
 		}
 
-		// todo: we might not detect collisions near edge of viewport for
-		// wrapped objects. E.g. a big rock could be partly visible on the west edge,
-		// but it's centroid (position) is wrapped around to the east edge.
-
-		const FVector2D OldP     = Torpedo.OldPosition;
-		const FVector2D CurrentP = Torpedo.UnwrappedNewPosition;
+		if(ResolveContact(Contact, Contacts))
+		{
+			LastResolved = &Contact;
+		}
+	}
 
-		// See if torpedo hit any rocks.
+	// Remove the dead, in descending index order so that removing one object
+	// doesn't move another one still waiting to be removed.
+	// Powerups go first because killed scavengers and rocks can add new ones.
 
-		for(int32 AsteroidIndex = 0; AsteroidIndex < Asteroids.Num(); AsteroidIndex++)
+	for(int32 Index = Contacts.PowerupsTaken.Num() - 1; Index >= 0; Index--)
+	{
+		if(!Contacts.PowerupsTaken[Index])
 		{
-			auto& Asteroid = Asteroids.Get(AsteroidIndex);
+			continue;
+		}
 
-			if(Daylon::DoesLineSegmentIntersectCircle(OldP, CurrentP, Asteroid.GetPosition(), Asteroid.GetRadius())
-				|| Daylon::DoesLineSegmentIntersectCircle(Asteroid.OldPosition, Asteroid.UnwrappedNewPosition, OldP, Asteroid.GetRadius()))
-			{
-				// A torpedo hit a rock.
+		if(Contacts.PowerupsTakenByScavenger[Index])
+		{
+			// The scavenger holds on to the powerup's widget.
+			PowerupComponents.Release(Index, true);
+			Powerups.RemoveAt(Index);
+		}
+		else
+		{
+			KillPowerup(Index);
+		}
+	}
 
-				Torpedo.Kill();
-				Asteroids.Kill(AsteroidIndex, Torpedo.FiredByPlayer);
+	for(int32 Index = Contacts.EnemyShipsHit.Num() - 1; Index >= 0; Index--)
+	{
+		if(Contacts.EnemyShipsHit[Index])
+		{
+			EnemyShips.KillShip(Index);
+		}
+	}
 
-				// We don't need to check any other asteroids.
-				break;
-			}
+	for(int32 Index = Contacts.ScavengersHit.Num() - 1; Index >= 0; Index--)
+	{
+		if(Contacts.ScavengersHit[Index])
+		{
+			EnemyShips.KillScavenger(Index);
 		}
-		
-		if(Torpedo.IsAlive() && !Torpedo.FiredByPlayer && IsPlayerShipPresent())
+	}
+
+	for(int32 Index = Contacts.BossesHit.Num() - 1; Index >= 0; Index--)
+	{
+		if(Contacts.BossesHit[Index])
 		{
-			// Torpedo didn't hit a rock and the player didn't fire it, so see if it hit the player ship.
+			EnemyShips.KillBoss(Index);
+		}
+	}
 
-			if(Daylon::DoesLineSegmentIntersectTriangle(OldP, CurrentP, PlayerShipTriangle))
-			{
-				Torpedo.Kill();
-				SpawnExplosion(OldP, PlayerShip->Inertia);
-				ProcessPlayerShipCollision();
-			}
+	// Splitting a rock appends the new piece, which doesn't disturb lower indices.
+
+	for(int32 Index = Contacts.AsteroidsHit.Num() - 1; Index >= 0; Index--)
+	{
+		if(Contacts.AsteroidsHit[Index])
+		{
+			Asteroids.Kill(Index, Contacts.AsteroidsKilledByPlayer[Index]);
 		}
+	}
+}
+
+
+bool UPlayViewBase::ResolveContact(const FCollisionContact& Contact, FCollisionContacts& Contacts)
+{
+	// Returns false if the contact no longer applies because one of its objects
+	// was consumed by an earlier contact.
+
+	auto KillAsteroid = [&Contacts](int32 Index, bool KilledByPlayer)
+	{
+		Contacts.AsteroidsHit[Index]            = true;
+		Contacts.AsteroidsKilledByPlayer[Index] = KilledByPlayer;
+	};
 
-		if(Torpedo.IsAlive() && Torpedo.FiredByPlayer)
+	auto DamageBossShield = [&](FEnemyBoss& Boss, const FVector2D& P, float HealthDrop)
+	{
+		SpawnExplosion(P, FVector2D(0));
+		PlaySound(ShieldBonkSound, 0.5f);
+		float PartHealth = Boss.GetShieldSegmentHealth(Contact.Part, Contact.ShieldSegmentIndex);
+		PartHealth = FMath::Max(0.0f, PartHealth - HealthDrop);
+		Boss.SetShieldSegmentHealth(Contact.Part, Contact.ShieldSegmentIndex, PartHealth);
+	};
+
+	switch(Contact.Kind)
+	{
+		case ECollisionKind::TorpedoAsteroid:
+		case ECollisionKind::TorpedoPlayerShip:
+		case ECollisionKind::TorpedoEnemyShip:
+		case ECollisionKind::TorpedoScavenger:
+		case ECollisionKind::TorpedoBoss:
 		{
-			// See if the torpedo hit an enemy ship.
+			auto& Torpedo = *Torpedos[Contact.Subject].Get();
+
+			if(!Torpedo.IsAlive())
+			{
+				return false;
+			}
 
-			for(int32 EnemyIndex = EnemyShips.NumShips() - 1; EnemyIndex >= 0; EnemyIndex--)
+			switch(Contact.Kind)
 			{
-				auto& EnemyShip = EnemyShips.GetShip(EnemyIndex);
+				case ECollisionKind::TorpedoAsteroid:
+
+					if(Contacts.AsteroidsHit[Contact.Other])
+					{
+						return false;
+					}
 
-				if(Daylon::DoesLineSegmentIntersectCircle(OldP, CurrentP, EnemyShip.GetPosition(), EnemyShip.GetRadius()))
-				{
 					Torpedo.Kill();
-					IncreasePlayerScoreBy(EnemyShip.Value);
-					EnemyShips.KillShip(EnemyIndex);
+					KillAsteroid(Contact.Other, Torpedo.FiredByPlayer);
 					break;
-				}
-			}
 
-			// See if the torpedo hit a scavenger.
-			if(Torpedo.IsAlive())
-			{
-				for(int32 ScavengerIndex = EnemyShips.NumScavengers() - 1; ScavengerIndex >= 0; ScavengerIndex--)
-				{
-					auto& Scavenger = EnemyShips.GetScavenger(ScavengerIndex);
+				case ECollisionKind::TorpedoPlayerShip:
 
-					if(Daylon::DoesLineSegmentIntersectCircle(OldP, CurrentP, Scavenger.GetPosition(), Scavenger.GetRadius()))
+					if(!IsPlayerShipPresent())
 					{
-						Torpedo.Kill();
-						IncreasePlayerScoreBy(Scavenger.Value);
-						EnemyShips.KillScavenger(ScavengerIndex);
-						break;
+						return false;
 					}
-				}
-			}
-		}
 
+					Torpedo.Kill();
+					SpawnExplosion(Torpedo.GetOldPosition(), PlayerShip->GetInertia());
+					ProcessPlayerShipCollision();
+					break;
+
+				case ECollisionKind::TorpedoEnemyShip:
 
-		// Let bosses be hit by any torpedo, not just ours.
-		if(Torpedo.IsAlive() /* && Torpedo.FiredByPlayer*/)
-		{
-			int32 ShieldSegmentIndex;
-			int32 Part;
-				
-			for(int32 BossIndex = EnemyShips.NumBosses() - 1; BossIndex >= 0; BossIndex--)
-			{
-				auto& Boss = EnemyShips.GetBoss(BossIndex);
+					if(Contacts.EnemyShipsHit[Contact.Other])
+					{
+						return false;
+					}
+
+					Torpedo.Kill();
+					IncreasePlayerScoreBy(EnemyShips.GetShip(Contact.Other).GetValue());
+					Contacts.EnemyShipsHit[Contact.Other] = true;
+					break;
+
+				case ECollisionKind::TorpedoScavenger:
+
+					if(Contacts.ScavengersHit[Contact.Other])
+					{
+						return false;
+					}
 
-				Part = Boss.CheckCollision(OldP, CurrentP, ShieldSegmentIndex);
+					Torpedo.Kill();
+					IncreasePlayerScoreBy(EnemyShips.GetScavenger(Contact.Other).GetValue());
+					Contacts.ScavengersHit[Contact.Other] = true;
+					break;
 
-				if(Part != INDEX_NONE)
+				case ECollisionKind::TorpedoBoss:
 				{
+					if(Contacts.BossesHit[Contact.Other])
+					{
+						return false;
+					}
+
 					Torpedo.Kill();
 
-					if(Part == 0) 
+					auto& Boss = EnemyShips.GetBoss(Contact.Other);
+
+					if(Contact.Part == 0) 
 					{
 						if(Torpedo.FiredByPlayer)
 						{
-							IncreasePlayerScoreBy(Boss.Value);
+							IncreasePlayerScoreBy(Boss.GetValue());
 						}
-						EnemyShips.KillBoss(BossIndex);
+						Contacts.BossesHit[Contact.Other] = true;
 					} 
 					else
 					{
-						SpawnExplosion(CurrentP, FVector2D(0));
-						PlaySound(ShieldBonkSound, 0.5f);
-						float PartHealth = Boss.GetShieldSegmentHealth(Part, ShieldSegmentIndex);
-						PartHealth = FMath::Max(0.0f, PartHealth - 0.25f);
-						Boss.SetShieldSegmentHealth(Part, ShieldSegmentIndex, PartHealth);
+						DamageBossShield(Boss, Torpedo.GetUnwrappedNewPosition(), 0.25f);
 					}
+				}
+				break;
 
+				default:
 					break;
-				}
 			}
 		}
-	} // next torpedo
-
-
-	for(int32 ScavengerIndex = EnemyShips.NumScavengers() - 1; ScavengerIndex >= 0; ScavengerIndex--)
-	{
-		// Did a scavenger collide with a powerup?
-
-		auto& Scavenger = EnemyShips.GetScavenger(ScavengerIndex);
+		return true;
 
-		int32 PowerupIndex = 0;
 
-		for(auto PowerupPtr : Powerups)
+		case ECollisionKind::ScavengerPowerup:
 		{
-			const auto Distance = FVector2D::Distance(Scavenger.GetPosition(), PowerupPtr.Get()->GetPosition());
-					
-			if(Distance < Scavenger.GetRadius() + PowerupPtr.Get()->GetRadius())
+			if(Contacts.ScavengersHit[Contact.Subject] || Contacts.PowerupsTaken[Contact.Other])
 			{
-				// Collision occurred; acquire the powerup.
-				
-				PlaySound(GainDoubleGunPowerupSound);  // todo: play a scavenger-specific sound.
-
-				PowerupPtr.Get()->Hide();
-				Scavenger.AcquiredPowerups.Add(PowerupPtr);
-				Powerups.RemoveAtSwap(PowerupIndex);
-
-				Scavenger.CurrentTarget.Reset();
-
-				break;
+				return false;
 			}
-			PowerupIndex++;
-		}
-	}
 
+			// Acquire the powerup.
 
-	// Check if player ship collided with a rock
-
-	if(IsPlayerShipPresent())
-	{
-		for(int32 AsteroidIndex = 0; AsteroidIndex < Asteroids.Num(); AsteroidIndex++)
-		{
-			auto& Asteroid = Asteroids.Get(AsteroidIndex);
-
-			#define SHIP_INTERSECTS_ASTEROID  Daylon::DoesLineSegmentIntersectCircle(PlayerShipLineStart, PlayerShipLineEnd, Asteroid.GetPosition(), Asteroid.GetRadius() + PlayerShip->GetRadius())
-			#define ASTEROID_INTERSECTS_SHIP  Daylon::DoesLineSegmentIntersectTriangle(Asteroid.OldPosition, Asteroid.UnwrappedNewPosition, PlayerShipTriangle)
-	
-			if(SHIP_INTERSECTS_ASTEROID || ASTEROID_INTERSECTS_SHIP)
-			{
-				// Player collided with a rock.
-				static const TMap<int, float> AsteroidMasses = 
-				{
-					{ ValueBigAsteroid,    BigAsteroidMass    },
-					{ ValueMediumAsteroid, MediumAsteroidMass }, 
-					{ ValueSmallAsteroid,  SmallAsteroidMass  }
-				};
+			auto& Scavenger  = EnemyShips.GetScavenger(Contact.Subject);
+			auto  PowerupPtr = Powerups[Contact.Other];
 
-				if(AsteroidInertiaImpart == 0.0f)
-				{
-					ProcessPlayerShipCollision();
-				}
-				else
-				{
-					const FVector2D AsteroidPosition = Asteroid.GetPosition();
-					ProcessPlayerShipCollision(AsteroidMasses[Asteroid.Value] * AsteroidInertiaImpart, &AsteroidPosition, &Asteroid.Inertia);
-				}
+			PlaySound(GainDoubleGunPowerupSound);  // todo: play a scavenger-specific sound.
 
-				Asteroids.Kill(AsteroidIndex, CreditPlayerForKill);
+			PowerupPtr->Hide();
+			Scavenger.AcquiredPowerups.Add(PowerupPtr);
 
-				break;
-			}
+			Contacts.PowerupsTaken[Contact.Other]            = true;
+			Contacts.PowerupsTakenByScavenger[Contact.Other] = true;
 
-			#undef SHIP_INTERSECTS_ASTEROID 
-			#undef ASTEROID_INTERSECTS_SHIP
+			Scavenger.CurrentTarget.Reset();
 		}
-	}
+		return true;
 
 
-	// Check if enemy ship collided with the player
-
-	if(IsPlayerShipPresent())
-	{
-		for(int32 EnemyIndex = EnemyShips.NumShips() - 1; EnemyIndex >= 0; EnemyIndex--)
+		case ECollisionKind::PlayerShipAsteroid:
 		{
-			auto& EnemyShip = EnemyShips.GetShip(EnemyIndex);
-
-			if (Daylon::DoesLineSegmentIntersectCircle(PlayerShipLineStart, PlayerShipLineEnd, EnemyShip.OldPosition, EnemyShip.GetRadius())
-				|| FVector2D::Distance(PlayerShip->UnwrappedNewPosition, EnemyShip.UnwrappedNewPosition) < EnemyShip.GetRadius() + PlayerShip->GetRadius())
+			if(!IsPlayerShipPresent() || Contacts.AsteroidsHit[Contact.Other])
 			{
-				// Enemy ship collided with player ship.
+				return false;
+			}
 
-				IncreasePlayerScoreBy(EnemyShip.Value);
-				EnemyShips.KillShip(EnemyIndex);
+			auto& Asteroid = Asteroids.Get(Contact.Other);
 
+			if(AsteroidInertiaImpart == 0.0f)
+			{
 				ProcessPlayerShipCollision();
-
-				break;
 			}
-		}
-	}
+			else
+			{
+				const FVector2D AsteroidPosition = Asteroid.GetPosition() + Contact.Offset;
+				ProcessPlayerShipCollision(FAsteroids::GetMass(Asteroid.GetValue()) * AsteroidInertiaImpart, &AsteroidPosition, &Asteroid.GetMotion().Inertia);
+			}
 
+			KillAsteroid(Contact.Other, CreditPlayerForKill);
+		}
+		return true;
 
-	// Check if scavenger collided with the player
 
-	if(IsPlayerShipPresent())
-	{
-		for(int32 ScavengerIndex = EnemyShips.NumScavengers() - 1; ScavengerIndex >= 0; ScavengerIndex--)
-		{
-			auto& Scavenger = EnemyShips.GetScavenger(ScavengerIndex);
+		case ECollisionKind::PlayerShipEnemyShip:
 
-			if (Daylon::DoesLineSegmentIntersectCircle(PlayerShipLineStart, PlayerShipLineEnd, Scavenger.OldPosition, Scavenger.GetRadius())
-				|| FVector2D::Distance(PlayerShip->UnwrappedNewPosition, Scavenger.UnwrappedNewPosition) < Scavenger.GetRadius() + PlayerShip->GetRadius())
+			if(!IsPlayerShipPresent() || Contacts.EnemyShipsHit[Contact.Other])
 			{
-				// Enemy ship collided with player ship.
+				return false;
+			}
 
-				IncreasePlayerScoreBy(Scavenger.Value);
-				EnemyShips.KillScavenger(ScavengerIndex);
+			IncreasePlayerScoreBy(EnemyShips.GetShip(Contact.Other).GetValue());
+			Contacts.EnemyShipsHit[Contact.Other] = true;
 
-				ProcessPlayerShipCollision();
+			ProcessPlayerShipCollision();
+			return true;
 
-				break;
-			}
-		}
-	}
 
+		case ECollisionKind::PlayerShipScavenger:
 
-	// Check if player ship collided with a boss
+			if(!IsPlayerShipPresent() || Contacts.ScavengersHit[Contact.Other])
+			{
+				return false;
+			}
 
-	if(IsPlayerShipPresent())
-	{
-		int32 Part;
-		int32 ShieldSegmentIndex;
-		FVector2D HitPt;
+			IncreasePlayerScoreBy(EnemyShips.GetScavenger(Contact.Other).GetValue());
+			Contacts.ScavengersHit[Contact.Other] = true;
 
-		for(int32 BossIndex = EnemyShips.NumBosses() - 1; BossIndex >= 0; BossIndex--)
-		{
-			auto& Boss = EnemyShips.GetBoss(BossIndex);
+			ProcessPlayerShipCollision();
+			return true;
 
-			Part = Boss.CheckCollision(PlayerShipLineStart, PlayerShipLineEnd, PlayerShip->GetRadius(), ShieldSegmentIndex, HitPt);
 
-			if(Part == INDEX_NONE)
+		case ECollisionKind::PlayerShipBoss:
+		{
+			if(!IsPlayerShipPresent() || Contacts.BossesHit[Contact.Other])
 			{
-				continue;
+				return false;
 			}
-			
+
+			auto& Boss = EnemyShips.GetBoss(Contact.Other);
+
 			ProcessPlayerShipCollision();
 
 			// Player will have died if it wasn't shielded.
 
-			if(Part == 0) 
+			if(Contact.Part == 0) 
 			{ 
-				IncreasePlayerScoreBy(Boss.Value);
-				EnemyShips.KillBoss(BossIndex);
-				break;
+				IncreasePlayerScoreBy(Boss.GetValue());
+				Contacts.BossesHit[Contact.Other] = true;
+				return true;
 			} 
 
 			// Player hit a boss' shield.
 
-			SpawnExplosion(PlayerShipLineEnd, FVector2D(0));
-			PlaySound(ShieldBonkSound, 0.5f);
-			float PartHealth = Boss.GetShieldSegmentHealth(Part, ShieldSegmentIndex);
-			PartHealth = FMath::Max(0.0f, PartHealth - 0.25f);
-			Boss.SetShieldSegmentHealth(Part, ShieldSegmentIndex, PartHealth);
+			DamageBossShield(Boss, PlayerShip->GetUnwrappedNewPosition(), 0.25f);
 
 			if(IsPlayerShipPresent())
 			{
 				// Player was shielded or invincible (or in god mode)
 				// so do an elastic collision.
 
-				auto ShieldImpactNormal = (HitPt - Boss.UnwrappedNewPosition);
+				auto ShieldImpactNormal = (Contact.HitPt - (Boss.GetUnwrappedNewPosition() + Contact.Offset));
 				ShieldImpactNormal.Normalize();
 
 				// Have to treat player ship speed below 1.0 as 1.0 to prevent possible infinite loop during inertia scaling.
 				const auto BounceForce = ShieldImpactNormal * FMath::Max(1.0f, PlayerShip->GetSpeed());
 
-				PlayerShip->Inertia += BounceForce;
+				PlayerShip->GetMotion().Inertia += BounceForce;
 
 				while(PlayerShip->GetSpeed() < 100.0f)
 				{
-					PlayerShip->Inertia *= 1.1f;
+					PlayerShip->GetMotion().Inertia *= 1.1f;
 				}
 
 				// Move the player ship away from the boss to avoid overcolliding.
-				while(FVector2D::Distance(PlayerShip->UnwrappedNewPosition, HitPt) < 20.0f)
+				while(FVector2D::Distance(PlayerShip->GetUnwrappedNewPosition(), Contact.HitPt) < 20.0f)
 				{
 					PlayerShip->Move(1.0f / 60, WrapPositionToViewport);
 				}
 			}
-			break;
 		}
-	}
-
+		return true;
 
-	// Check if player ship collided with a powerup
 
-	if(IsPlayerShipPresent())
-	{
-		for(int32 PowerupIndex = Powerups.Num() - 1; PowerupIndex >= 0; PowerupIndex--)
+		case ECollisionKind::PlayerShipPowerup:
 		{
-			auto& Powerup = *Powerups[PowerupIndex].Get();
-
-			if (Daylon::DoesLineSegmentIntersectCircle(PlayerShipLineStart, PlayerShipLineEnd, Powerup.OldPosition, Powerup.GetRadius())
-				|| FVector2D::Distance(PlayerShip->UnwrappedNewPosition, Powerup.UnwrappedNewPosition) < Powerup.GetRadius() + PlayerShip->GetRadius())
+			if(!IsPlayerShipPresent() || Contacts.PowerupsTaken[Contact.Other])
 			{
-				// Powerup collided with player ship.
-
-				switch(Powerup.Kind)
-				{
-					case EPowerup::DoubleGuns:
-
-						PlayerShip->AdjustDoubleShotsLeft(DoubleGunsPowerupIncrease);
-						PlaySound(GainDoubleGunPowerupSound);
-						PlayAnimation(DoubleGunReadoutFlash, 0.0f, 1, EUMGSequencePlayMode::Forward, 1.0f, true);
-						break;
-
-					case EPowerup::Shields:
-
-						PlaySound(GainShieldPowerupSound);
-						PlayerShip->AdjustShieldsLeft(ShieldPowerupIncrease);
-						PlayAnimation(ShieldReadoutFlash, 0.0f, 1, EUMGSequencePlayMode::Forward, 1.0f, true);
-						break;
-
-					case EPowerup::Invincibility:
-						PlaySound(GainShieldPowerupSound); // todo: specific sound
-						PlayerShip->AdjustInvincibilityLeft(MaxInvincibilityTime);
-						PlayerShip->TimeUntilNextInvincibilityWarnFlash = MaxInvincibilityWarnTime;
-						PlayAnimation(InvincibilityReadoutFlash, 0.0f, 1, EUMGSequencePlayMode::Forward, 1.0f, true);
-						break;
-				}
-				
-				KillPowerup(PowerupIndex);
-
-				break;
+				return false;
 			}
-		}
-	}
 
+			const auto& Powerup = *Powerups[Contact.Other].Get();
 
-	// Check if enemy ship collided with an asteroid
-
-	for(int32 EnemyIndex = EnemyShips.NumShips() - 1; EnemyIndex >= 0; EnemyIndex--)
-	{
-		auto& EnemyShip = EnemyShips.GetShip(EnemyIndex);
+			switch(Powerup.Kind)
+			{
+				case EPowerup::DoubleGuns:
 
-		for(int32 AsteroidIndex = 0; AsteroidIndex < Asteroids.Num(); AsteroidIndex++)
-		{
-			auto& Asteroid = Asteroids.Get(AsteroidIndex);
+					PlayerShip->AdjustDoubleShotsLeft(DoubleGunsPowerupIncrease);
+					PlaySound(GainDoubleGunPowerupSound);
+					PlayAnimation(DoubleGunReadoutFlash, 0.0f, 1, EUMGSequencePlayMode::Forward, 1.0f, true);
+					break;
 
-			if(Daylon::DoesLineSegmentIntersectCircle(Asteroid.OldPosition, Asteroid.UnwrappedNewPosition, EnemyShip.GetPosition(), EnemyShip.GetRadius())
-				|| FVector2D::Distance(WrapPositionToViewport(EnemyShip.UnwrappedNewPosition), Asteroid.OldPosition) < Asteroid.GetRadius() + EnemyShip.GetRadius())
-			{
-				// Enemy ship collided with a rock.
+				case EPowerup::Shields:
 
-				EnemyShips.KillShip(EnemyIndex);
-				Asteroids.Kill(AsteroidIndex, DontCreditPlayerForKill);
+					PlaySound(GainShieldPowerupSound);
+					PlayerShip->AdjustShieldsLeft(ShieldPowerupIncrease);
+					PlayAnimation(ShieldReadoutFlash, 0.0f, 1, EUMGSequencePlayMode::Forward, 1.0f, true);
+					break;
 
-				break;
+				case EPowerup::Invincibility:
+					PlaySound(GainShieldPowerupSound); // todo: specific sound
+					PlayerShip->AdjustInvincibilityLeft(MaxInvincibilityTime);
+					PlayerShip->TimeUntilNextInvincibilityWarnFlash = MaxInvincibilityWarnTime;
+					PlayAnimation(InvincibilityReadoutFlash, 0.0f, 1, EUMGSequencePlayMode::Forward, 1.0f, true);
+					break;
 			}
+
+			Contacts.PowerupsTaken[Contact.Other] = true;
 		}
-	}
+		return true;
 
-	for(int32 ScavengerIndex = EnemyShips.NumScavengers() - 1; ScavengerIndex >= 0; ScavengerIndex--)
-	{
-		auto& Scavenger = EnemyShips.GetScavenger(ScavengerIndex);
 
-		for(int32 AsteroidIndex = 0; AsteroidIndex < Asteroids.Num(); AsteroidIndex++)
-		{
-			auto& Asteroid = Asteroids.Get(AsteroidIndex);
+		case ECollisionKind::EnemyShipAsteroid:
 
-			if(Daylon::DoesLineSegmentIntersectCircle(Asteroid.OldPosition, Asteroid.UnwrappedNewPosition, Scavenger.GetPosition(), Scavenger.GetRadius())
-				|| FVector2D::Distance(WrapPositionToViewport(Scavenger.UnwrappedNewPosition), Asteroid.OldPosition) < Asteroid.GetRadius() + Scavenger.GetRadius())
+			if(Contacts.EnemyShipsHit[Contact.Subject] || Contacts.AsteroidsHit[Contact.Other])
 			{
-				// Scavenger collided with a rock.
-
-				EnemyShips.KillScavenger(ScavengerIndex);
-				Asteroids.Kill(AsteroidIndex, DontCreditPlayerForKill);
-
-				break;
+				return false;
 			}
-		}
-	}
 
+			Contacts.EnemyShipsHit[Contact.Subject] = true;
+			KillAsteroid(Contact.Other, DontCreditPlayerForKill);
+			return true;
 
-	for(int32 BossIndex = EnemyShips.NumBosses() - 1; BossIndex >= 0; BossIndex--)
-	{
-		auto& Boss = EnemyShips.GetBoss(BossIndex);
 
-		int32 ShieldSegmentIndex;
-		FVector2D HitPt;
+		case ECollisionKind::ScavengerAsteroid:
 
-		for(int32 AsteroidIndex = 0; AsteroidIndex < Asteroids.Num(); AsteroidIndex++)
-		{
-			auto& Asteroid = Asteroids.Get(AsteroidIndex);
+			if(Contacts.ScavengersHit[Contact.Subject] || Contacts.AsteroidsHit[Contact.Other])
+			{
+				return false;
+			}
+
+			Contacts.ScavengersHit[Contact.Subject] = true;
+			KillAsteroid(Contact.Other, DontCreditPlayerForKill);
+			return true;
 
-			auto Part = Boss.CheckCollision(Asteroid.OldPosition, Asteroid.UnwrappedNewPosition, Asteroid.GetRadius(), ShieldSegmentIndex, HitPt);
 
-			if(Part == INDEX_NONE)
+		case ECollisionKind::BossAsteroid:
+		{
+			if(Contacts.BossesHit[Contact.Subject] || Contacts.AsteroidsHit[Contact.Other])
 			{
-				continue;
+				return false;
 			}
 
-			Asteroids.Kill(AsteroidIndex, DontCreditPlayerForKill);
+			const auto& Asteroid = Asteroids.Get(Contact.Other);
+
+			KillAsteroid(Contact.Other, DontCreditPlayerForKill);
 
-			if(Part == 0)
+			if(Contact.Part == 0)
 			{
 				// Asteroid hit boss center.
-				EnemyShips.KillBoss(BossIndex);
-				break;
+				Contacts.BossesHit[Contact.Subject] = true;
+				return true;
 			}
 
 			// Asteroid collided with a boss shield.
 			// The bigger the asteroid, the greater the health impact.
 			float HealthDrop = 1.0f;
 
-			switch(Asteroid.Value)
+			switch(Asteroid.GetValue())
 			{
 				case ValueMediumAsteroid: HealthDrop = 0.50f; break;
 				case ValueSmallAsteroid:  HealthDrop = 0.25f; break;
@@ -501,19 +1153,115 @@ void UPlayViewBase::CheckCollisions()
 
 			// The faster the asteroid was moving, the greater the health impact.
 			HealthDrop = FMath::Min(1.0f, HealthDrop * Asteroid.GetSpeed() / 200);
-			SpawnExplosion(PlayerShipLineEnd, FVector2D(0));
-			PlaySound(ShieldBonkSound, 0.5f);
-			float PartHealth = Boss.GetShieldSegmentHealth(Part, ShieldSegmentIndex);
-			PartHealth = FMath::Max(0.0f, PartHealth - HealthDrop);
-			Boss.SetShieldSegmentHealth(Part, ShieldSegmentIndex, PartHealth);
 
-			break;
+			DamageBossShield(EnemyShips.GetBoss(Contact.Subject), Contact.HitPt, HealthDrop);
 		}
+		return true;
+
+
+		default:
+			break;
 	}
+
+	return false;
 }
 
 
 
+void UPlayViewBase::PublishCollisionStats()
+{
+	// Hand the stats gathered by the last DetectCollisions to the stats system.
+	// Times are summed over every detection thread, so they can exceed STAT_DetectCollisions.
+
+#if STATS
+	#define PUBLISH_COLLISION_KIND_STATS(Kind)  \
+		SET_DWORD_STAT    (STAT_##Kind##Tests, CollisionStats.Tests [(int32)ECollisionKind::Kind]); \
+		SET_DWORD_STAT    (STAT_##Kind##Hits,  CollisionStats.Hits  [(int32)ECollisionKind::Kind]); \
+		SET_CYCLE_COUNTER (STAT_##Kind##Time,  (uint32)CollisionStats.Cycles[(int32)ECollisionKind::Kind]);
+
+	PUBLISH_COLLISION_KIND_STATS(TorpedoAsteroid)
+	PUBLISH_COLLISION_KIND_STATS(TorpedoPlayerShip)
+	PUBLISH_COLLISION_KIND_STATS(TorpedoEnemyShip)
+	PUBLISH_COLLISION_KIND_STATS(TorpedoScavenger)
+	PUBLISH_COLLISION_KIND_STATS(TorpedoBoss)
+	PUBLISH_COLLISION_KIND_STATS(ScavengerPowerup)
+	PUBLISH_COLLISION_KIND_STATS(PlayerShipAsteroid)
+	PUBLISH_COLLISION_KIND_STATS(PlayerShipEnemyShip)
+	PUBLISH_COLLISION_KIND_STATS(PlayerShipScavenger)
+	PUBLISH_COLLISION_KIND_STATS(PlayerShipBoss)
+	PUBLISH_COLLISION_KIND_STATS(PlayerShipPowerup)
+	PUBLISH_COLLISION_KIND_STATS(EnemyShipAsteroid)
+	PUBLISH_COLLISION_KIND_STATS(ScavengerAsteroid)
+	PUBLISH_COLLISION_KIND_STATS(BossAsteroid)
+
+	#undef PUBLISH_COLLISION_KIND_STATS
+#endif
+}
+
+
+int32 UPlayViewBase::PaintCollisionOverlay(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId) const
+{
+	if(CVarCollisionOverlay.GetValueOnGameThread() == 0)
+	{
+		return LayerId;
+	}
+
+	LayerId++;
+
+	// Play objects live in viewport space; scale that to however big we're being drawn.
+
+	const FVector2D Scale = AllottedGeometry.GetLocalSize() / ViewportSize;
+
+	const FLinearColor MissColor (0.0f, 1.0f, 0.0f, 0.5f);
+	const FLinearColor HitColor  (1.0f, 0.0f, 0.0f, 1.0f);
+
+	const int32 NumCircleSides = 24;
+
+	TArray<FVector2f> Points;
+
+	for(const auto& Shape : CollisionShapes)
+	{
+		Points.Reset();
+
+		if(Shape.Radius == 0.0)
+		{
+			Points.Add(UE::Slate::CastToVector2f(Shape.P1 * Scale));
+			Points.Add(UE::Slate::CastToVector2f(Shape.P2 * Scale));
+		}
+		else
+		{
+			for(int32 Side = 0; Side <= NumCircleSides; Side++)
+			{
+				const auto P = Shape.P1 + Daylon::AngleToVector2D(Side * 360.0f / NumCircleSides) * Shape.Radius;
+
+				Points.Add(UE::Slate::CastToVector2f(P * Scale));
+			}
+		}
+
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), Points, ESlateDrawEffect::None, Shape.Hit ? HitColor : MissColor, true, 1.0f);
+	}
+
+	// List the counts and times of every kind of collision that was tested.
+
+	FString Readout = FString::Printf(TEXT("%d shapes, %d contacts\n"), CollisionShapes.Num(), CollisionContacts.Contacts.Num());
+
+	for(int32 Index = 0; Index < (int32)ECollisionKind::Count; Index++)
+	{
+		if(CollisionStats.Tests[Index] == 0)
+		{
+			continue;
+		}
+
+		Readout += FString::Printf(TEXT("%s: %d tests, %d hits, %.3f ms\n"),
+			GetCollisionKindName((ECollisionKind)Index), CollisionStats.Tests[Index], CollisionStats.Hits[Index], FPlatformTime::ToMilliseconds64(CollisionStats.Cycles[Index]));
+	}
+
+	FSlateDrawElement::MakeText(OutDrawElements, LayerId, AllottedGeometry.ToOffsetPaintGeometry(FVector2D(20, 100)), Readout, FCoreStyle::GetDefaultFontStyle("Mono", 12), ESlateDrawEffect::None, FLinearColor::Yellow);
+
+	return LayerId;
+}
+
+
 #if(DEBUG_MODULE == 1)
 #pragma optimize("", on)
 #endif
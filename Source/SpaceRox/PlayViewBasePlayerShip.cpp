@@ -5,6 +5,7 @@
 
 #include "PlayViewBase.h"
 #include "Logging.h"
+#include "GameRules.h"
 
 
 
@@ -37,7 +38,7 @@ void UPlayViewBase::InitializePlayerShipCount()
 
 void UPlayViewBase::CreatePlayerShip()
 {
-	PlayerShip = FPlayerShip::Create(PlayerShipAtlas->Atlas, FVector2D(32), 0.4f);
+	PlayerShip = FPlayerShip::Create(PlayerShipAtlas->GetHandle(), PlayerShipSize, PlayerShipRadiusFactor);
 
 	PlayerShip->DoubleShotsLeft   .Bind([this](int32){ UpdatePlayerShipReadout(EPowerup::DoubleGuns);    });
 	PlayerShip->ShieldsLeft       .Bind([this](int32){ UpdatePlayerShipReadout(EPowerup::Shields);       });
@@ -101,7 +102,6 @@ void UPlayViewBase::ProcessPlayerShipSpawn(float DeltaTime)
 
 	if(IsWaitingToSpawnPlayerShip())
 	{
-		TimeUntilNextPlayerShip -= DeltaTime;
 		return;
 	}
 
@@ -134,18 +134,9 @@ bool UPlayViewBase::IsSafeToSpawnPlayerShip() const
 
 	// If any asteroid or enemy ship intersects a box in the center of the screen, return false.
 
-	// Make the safezone smaller if the player has enough shields. 
-	// This makes it easier to respawn when there are lots of things around
-	// without having to potentially wait a really long time.
+	const FBox2d SafeZoneBox = GetPlayerShipSpawnSafeZone(PlayerShip->ShieldsLeft);
 
-	const auto SafeZoneDivisor = (PlayerShip->ShieldsLeft > 3.0f) ? 8 : 4;
-
-	const auto ScreenCenter = ViewportSize / 2;
-	const auto SafeZoneSize = ViewportSize / SafeZoneDivisor;
-
-	UE::Geometry::FAxisAlignedBox2d SafeZone(
-		ScreenCenter - SafeZoneSize / 2,
-		ScreenCenter + SafeZoneSize / 2);
+	UE::Geometry::FAxisAlignedBox2d SafeZone(SafeZoneBox.Min, SafeZoneBox.Max);
 
 	return (!Daylon::PlayObjectsIntersectBox(Asteroids.Asteroids,   SafeZone) && 
 	        !Daylon::PlayObjectsIntersectBox(EnemyShips.Ships,      SafeZone) &&
@@ -155,7 +146,7 @@ bool UPlayViewBase::IsSafeToSpawnPlayerShip() const
 
 bool UPlayViewBase::IsWaitingToSpawnPlayerShip() const
 {
-	return (TimeUntilNextPlayerShip > 0.0f);
+	return !PlayerShipCountdown.IsDue();
 }
 
 
@@ -170,7 +161,7 @@ void UPlayViewBase::KillPlayerShip()
 	AddPlayerShips(-1);
 
 	PlayerShip->IsSpawning = true;
-	TimeUntilNextPlayerShip = MaxTimeUntilNextPlayerShip;
+	PlayerShipCountdown.Set(MaxTimeUntilNextPlayerShip);
 
 	// ProcessPlayerShipSpawn() will handle the wait til next spawn and transition to game over, if needed. 
 }
@@ -178,18 +169,15 @@ void UPlayViewBase::KillPlayerShip()
 
 void UPlayViewBase::IncreasePlayerScoreBy(int32 Amount)
 {
-	if(PlayerScore >= MaxPlayerScore)
-	{
-		return;
-	}
+	int32 Score = PlayerScore;
 
-	const int32 PrevLevel = PlayerScore / PlayerShipBonusAt;
+	const int32 NumBonusShips = IncreaseScore(Score, Amount);
 
-	PlayerScore = FMath::Min(MaxPlayerScore, PlayerScore + Amount);
+	PlayerScore = Score;
 
-	if(PrevLevel != PlayerScore / PlayerShipBonusAt)
+	if(NumBonusShips > 0)
 	{
-		AddPlayerShips(1);
+		AddPlayerShips(NumBonusShips);
 
 		PlaySound(PlayerShipBonusSound);
 	}
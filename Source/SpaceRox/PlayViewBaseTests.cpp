@@ -0,0 +1,790 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+// SpaceRox - an Atari Asteroids clone developed with Unreal Engine.
+
+
+#include "PlayViewBase.h"
+#include "Logging.h"
+#include "Constants.h"
+#include "DaylonParticleKernels.h"
+#include "Async/ParallelFor.h"
+#include "Runtime/GeometryCore/Public/Intersection/IntrTriangle2Triangle2.h"
+
+
+
+// Set to 1 to enable debugging
+#define DEBUG_MODULE                0
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", off)
+#endif
+
+
+// Tests and benchmarks for the physics routines in DaylonGeometry.
+// Enable TEST_PHYSICS in PlayViewBase.cpp to run them at startup; results go to the log.
+
+
+static void TestLineSegmentVsCircle()
+{
+	// Line segment vs. circle.
+	// Try lines we know should intersect.
+
+	double R = 100.0;
+	FVector2D CP(300, 300);
+
+	struct FLine { FVector2D P1, P2; };
+
+	const FLine Lines[] = 
+	{
+		// Horizontal lines wider than circle.
+		{ FVector2D(174, 230), FVector2D(430, 230) },
+		{ FVector2D(174, 300), FVector2D(430, 300) },
+		{ FVector2D(174, 374), FVector2D(430, 374) },
+
+		// Vertical lines wider than circle.
+		{ FVector2D(234, 180), FVector2D(234, 420) },
+		{ FVector2D(300, 180), FVector2D(300, 420) },
+		{ FVector2D(380, 180), FVector2D(380, 420) },
+
+		// Horizontal lines inside circle.
+		{ FVector2D(250, 245), FVector2D(360, 230) },
+		{ FVector2D(250, 300), FVector2D(360, 300) },
+		{ FVector2D(250, 350), FVector2D(360, 350) },
+
+		// Vertical lines inside circle.
+		{ FVector2D(234, 250), FVector2D(234, 360) },
+		{ FVector2D(300, 250), FVector2D(300, 360) },
+		{ FVector2D(350, 250), FVector2D(350, 360) },
+	};
+
+	auto PtInsideCircle = [&](const FVector2D& P)
+	{
+		return ((P - CP).Length() <= R);
+	};
+
+	auto InsideCircle = [&](const FLine& Line) 
+	{ 
+		// If either endpoint is inside the circle, then the line must intersect circle.
+		return (PtInsideCircle(Line.P1) || PtInsideCircle(Line.P2));
+	};
+
+	for(const auto& Line : Lines)
+	{
+		//if(!InsideCircle(Line))
+		{
+			bool Result = Daylon::DoesLineSegmentIntersectCircle(Line.P1, Line.P2, CP, R);
+			if(!Result)
+			{
+				UE_LOG(LogGame, Error, TEXT("Daylon::DoesLineSegmentIntersectCircle returned false negative for line %f, %f - %f, %f"),
+					Line.P1.X, Line.P1.Y, Line.P2.X, Line.P2.Y);
+			}
+		}
+	}
+
+	// Try random tiny lines inside or penetrating the circle.
+	for(int32 Idx = 0; Idx < 10000; Idx++)
+	{
+		FLine Line;
+		
+		Line.P1 = Daylon::RandVector2D() * R * Daylon::FRandRange(0.8f, 1.2f) + CP; // could be inside or outside
+		Line.P2 = Daylon::RandVector2D() * R * 0.9 + CP; // must be inside
+
+		//if(!InsideCircle(Line))
+		{
+			bool Result = Daylon::DoesLineSegmentIntersectCircle(Line.P1, Line.P2, CP, R);
+			if(!Result)
+			{
+				UE_LOG(LogGame, Error, TEXT("Daylon::DoesLineSegmentIntersectCircle returned false negative for line %f, %f - %f, %f"),
+					Line.P1.X, Line.P1.Y, Line.P2.X, Line.P2.Y);
+			}
+		}
+	}
+}
+
+
+static void TestLineSegmentVsCircles()
+{
+	// The batched test must agree with DoesLineSegmentIntersectCircle exactly
+	// on these lines, which all end inside the circle (TestLineSegmentVsCircleEdges
+	// covers the rest). Each random line is tested against five copies of the circle
+	// so that both the vectorized lanes and the scalar leftovers get exercised.
+
+	const double    R = 100.0;
+	const FVector2D CP(300, 300);
+
+	Daylon::FCircleArray Circles;
+	TBitArray<>          Hits;
+
+	for(int32 Idx = 0; Idx < 5; Idx++)
+	{
+		Circles.Add(CP, R);
+	}
+
+	int32 NumMismatches = 0;
+
+	for(int32 Idx = 0; Idx < 10000; Idx++)
+	{
+		const FVector2D P1 = Daylon::RandVector2D() * R * Daylon::FRandRange(0.8f, 1.2f) + CP; // could be inside or outside
+		const FVector2D P2 = Daylon::RandVector2D() * R * 0.9 + CP; // must be inside
+
+		const bool Expected = Daylon::DoesLineSegmentIntersectCircle(P1, P2, CP, R);
+
+		Daylon::DoesLineSegmentIntersectCircles(P1, P2, Circles, Hits);
+
+		for(int32 CircleIndex = 0; CircleIndex < Circles.Num(); CircleIndex++)
+		{
+			if(Hits[CircleIndex] != Expected)
+			{
+				UE_LOG(LogGame, Error, TEXT("Daylon::DoesLineSegmentIntersectCircles disagrees on circle %d for line %f, %f - %f, %f"),
+					CircleIndex, P1.X, P1.Y, P2.X, P2.Y);
+				NumMismatches++;
+			}
+		}
+	}
+
+	UE_LOG(LogGame, Log, TEXT("Daylon::DoesLineSegmentIntersectCircles: %d mismatches"), NumMismatches);
+}
+
+
+static void TestLineSegmentVsCircleEdges()
+{
+	// Lines that miss, cross or touch a circle without ending inside it, lines ending
+	// exactly on it, and zero-length lines, each built so we know the right answer.
+	// Touching counts as a hit, except for zero-length lines, which must be inside.
+	// Points on the circle come from Pythagorean triples and the tangents run along
+	// the axes or start at the touching point, so there's no rounding at the edge.
+	//
+	// The batched and Fast tests must always be right. DoesLineSegmentIntersectCircle
+	// is only counted: its root test misses some of the lines that don't end inside.
+
+	const FIntVector Triples[] = { { 3, 4, 5 }, { 5, 12, 13 }, { 8, 15, 17 }, { 7, 24, 25 }, { 20, 21, 29 } };
+
+	Daylon::FCircleArray Circles;
+	TBitArray<>          Hits;
+
+	int32 NumCases         = 0;
+	int32 NumMismatches    = 0;
+	int32 NumOldMismatches = 0;
+
+	auto Check = [&](const TCHAR* What, const FVector2D& P1, const FVector2D& P2, const FVector2D& CP, double R, bool Expected)
+	{
+		NumCases++;
+
+		Circles.Reset();
+
+		for(int32 Idx = 0; Idx < 5; Idx++)
+		{
+			Circles.Add(CP, R);
+		}
+
+		Daylon::DoesLineSegmentIntersectCircles(P1, P2, Circles, Hits);
+
+		for(int32 CircleIndex = 0; CircleIndex < Circles.Num(); CircleIndex++)
+		{
+			if(Hits[CircleIndex] != Expected)
+			{
+				UE_LOG(LogGame, Error, TEXT("Daylon::DoesLineSegmentIntersectCircles gets %s wrong on circle %d for line %f, %f - %f, %f"),
+					What, CircleIndex, P1.X, P1.Y, P2.X, P2.Y);
+				NumMismatches++;
+			}
+		}
+
+		if(Daylon::DoesLineSegmentIntersectCircleFast(P1, P2, CP, R) != Expected)
+		{
+			UE_LOG(LogGame, Error, TEXT("Daylon::DoesLineSegmentIntersectCircleFast gets %s wrong for line %f, %f - %f, %f"),
+				What, P1.X, P1.Y, P2.X, P2.Y);
+			NumMismatches++;
+		}
+
+		if(Daylon::DoesLineSegmentIntersectCircle(P1, P2, CP, R) != Expected)
+		{
+			NumOldMismatches++;
+		}
+	};
+
+	auto RandomEdgeOffset = [](const FIntVector& Triple, int32 Scale)
+	{
+		// A point on a circle of radius Triple.Z * Scale, relative to its center.
+
+		FVector2D Offset(Triple.X * Scale, Triple.Y * Scale);
+
+		if(Daylon::RandBool()) { Swap(Offset.X, Offset.Y); }
+		if(Daylon::RandBool()) { Offset.X = -Offset.X; }
+		if(Daylon::RandBool()) { Offset.Y = -Offset.Y; }
+
+		return Offset;
+	};
+
+	for(int32 Idx = 0; Idx < 2000; Idx++)
+	{
+		const FIntVector Triple = Triples[Daylon::RandRange(0, (int32)UE_ARRAY_COUNT(Triples) - 1)];
+		const int32      Scale  = Daylon::RandRange(1, 4);
+		const double     R      = Triple.Z * Scale;
+
+		const FVector2D CP(Daylon::RandRange(100, (int32)ViewportSize.X - 100), Daylon::RandRange(100, (int32)ViewportSize.Y - 100));
+
+		// Both ends outside: misses, crossings and tangents.
+
+		const FVector2D Normal = Daylon::RandVector2D();
+		const FVector2D Along(-Normal.Y, Normal.X);
+		const FVector2D Near   = CP + Normal * R * Daylon::FRandRange(1.05, 3.0);
+
+		Check(TEXT("a miss"), Near + Along * Daylon::FRandRange(0.0, 3 * R), Near - Along * Daylon::FRandRange(0.0, 3 * R), CP, R, false);
+
+		const FVector2D Inside    = CP + Daylon::RandVector2D() * R * Daylon::FRandRange(0.0, 0.95);
+		const FVector2D Direction = Daylon::RandVector2D();
+
+		Check(TEXT("a crossing"), Inside + Direction * (2.05 * R + Daylon::FRandRange(0.0, R)), Inside - Direction * (2.05 * R + Daylon::FRandRange(0.0, R)), CP, R, true);
+
+		const double Before = Daylon::RandRange(1, (int32)(2 * R));
+		const double After  = Daylon::RandRange(1, (int32)(2 * R));
+
+		switch(Daylon::RandRange(0, 3))
+		{
+			case 0:  Check(TEXT("a tangent"), CP + FVector2D( R, -Before), CP + FVector2D( R,  After), CP, R, true); break;
+			case 1:  Check(TEXT("a tangent"), CP + FVector2D(-R,  Before), CP + FVector2D(-R, -After), CP, R, true); break;
+			case 2:  Check(TEXT("a tangent"), CP + FVector2D(-Before,  R), CP + FVector2D( After,  R), CP, R, true); break;
+			default: Check(TEXT("a tangent"), CP + FVector2D( Before, -R), CP + FVector2D(-After, -R), CP, R, true); break;
+		}
+
+		// Ends exactly on the circle.
+
+		const FVector2D Offset = RandomEdgeOffset(Triple, Scale);
+		const FVector2D Edge   = CP + Offset;
+		const FVector2D Tangent(-Offset.Y / Scale, Offset.X / Scale);
+
+		Check(TEXT("a tangent from the edge"),  Edge, Edge + Tangent * Daylon::RandRange(1, 10), CP, R, true);
+		Check(TEXT("a line out from the edge"), Edge, Edge + Offset  * Daylon::RandRange(1, 3),  CP, R, true);
+		Check(TEXT("a line from the edge"),     Edge, Edge + Daylon::RandVector2D() * Daylon::FRandRange(0.0, 3 * R), CP, R, true);
+
+		const FVector2D OtherOffset = RandomEdgeOffset(Triple, Scale);
+
+		if(OtherOffset != Offset)
+		{
+			Check(TEXT("a chord"), Edge, CP + OtherOffset, CP, R, true);
+		}
+
+		// Zero length.
+
+		const FVector2D PtInside  = CP + Daylon::RandVector2D() * R * Daylon::FRandRange(0.0, 0.95);
+		const FVector2D PtOutside = CP + Daylon::RandVector2D() * R * Daylon::FRandRange(1.05, 3.0);
+
+		Check(TEXT("a point inside"),      PtInside,  PtInside,  CP, R, true);
+		Check(TEXT("a point outside"),     PtOutside, PtOutside, CP, R, false);
+		Check(TEXT("a point on the edge"), Edge,      Edge,      CP, R, false);
+	}
+
+	UE_LOG(LogGame, Log, TEXT("Daylon::DoesLineSegmentIntersectCircles edge cases: %d mismatches in %d lines (DoesLineSegmentIntersectCircle got %d wrong)"),
+		NumMismatches, NumCases, NumOldMismatches);
+}
+
+
+static void BenchmarkLineSegmentVsCircles()
+{
+	// Time a spread of short lines (roughly torpedo-sized moves) against a field of rocks,
+	// one circle at a time vs. all circles in a batch.
+
+	const int32 NumLines   = 10000;
+	const int32 NumCircles = 64;
+
+	TArray<FVector2D> LineStarts;
+	TArray<FVector2D> LineEnds;
+
+	for(int32 Idx = 0; Idx < NumLines; Idx++)
+	{
+		const FVector2D P1(Daylon::FRandRange(0.0f, ViewportSize.X), Daylon::FRandRange(0.0f, ViewportSize.Y));
+
+		LineStarts.Add(P1);
+		LineEnds.Add(P1 + Daylon::RandVector2D() * Daylon::FRandRange(0.0f, 20.0f));
+	}
+
+	Daylon::FCircleArray Circles;
+
+	for(int32 Idx = 0; Idx < NumCircles; Idx++)
+	{
+		Circles.Add(FVector2D(Daylon::FRandRange(0.0f, ViewportSize.X), Daylon::FRandRange(0.0f, ViewportSize.Y)), Daylon::FRandRange(10.0f, 80.0f));
+	}
+
+	int32 NumHitsOld = 0;
+
+	double StartTime = FPlatformTime::Seconds();
+
+	for(int32 LineIndex = 0; LineIndex < NumLines; LineIndex++)
+	{
+		for(int32 CircleIndex = 0; CircleIndex < NumCircles; CircleIndex++)
+		{
+			if(Daylon::DoesLineSegmentIntersectCircle(LineStarts[LineIndex], LineEnds[LineIndex],
+				FVector2D(Circles.X[CircleIndex], Circles.Y[CircleIndex]), Circles.Radius[CircleIndex]))
+			{
+				NumHitsOld++;
+			}
+		}
+	}
+
+	const double TimeOld = FPlatformTime::Seconds() - StartTime;
+
+	TBitArray<> Hits;
+	int32       NumHitsNew = 0;
+
+	StartTime = FPlatformTime::Seconds();
+
+	for(int32 LineIndex = 0; LineIndex < NumLines; LineIndex++)
+	{
+		NumHitsNew += Daylon::DoesLineSegmentIntersectCircles(LineStarts[LineIndex], LineEnds[LineIndex], Circles, Hits);
+	}
+
+	const double TimeNew = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogGame, Log, TEXT("Line segment vs. %d circles, %d lines: one at a time %.3f ms (%d hits), batched %.3f ms (%d hits), %.1fx"),
+		NumCircles, NumLines, TimeOld * 1000.0, NumHitsOld, TimeNew * 1000.0, NumHitsNew, (TimeNew > 0.0 ? TimeOld / TimeNew : 0.0));
+}
+
+
+static void FuzzTriangleRoutines()
+{
+	// Compare DoesLineSegmentIntersectTriangle and DoTrianglesIntersect against
+	// the GeometryCore triangle intersector they replaced, which faked segments
+	// with degenerate triangles. Shapes are kept small and close together so that
+	// hits and misses come up about equally often.
+
+	const int32 NumCases = 100000;
+
+	UE::Geometry::TIntrTriangle2Triangle2<double> Intersector;
+
+	auto RandomPoint = []()
+	{
+		return FVector2D(Daylon::FRandRange(0.0, 100.0), Daylon::FRandRange(0.0, 100.0));
+	};
+
+	int32 NumSegmentMismatches  = 0;
+	int32 NumTriangleMismatches = 0;
+	int32 NumHits               = 0;
+
+	for(int32 Idx = 0; Idx < NumCases; Idx++)
+	{
+		const FVector2D TriA[3] = { RandomPoint(), RandomPoint(), RandomPoint() };
+		const FVector2D TriB[3] = { RandomPoint(), RandomPoint(), RandomPoint() };
+
+		// Segment vs. triangle.
+
+		Intersector.SetTriangle0(UE::Geometry::FTriangle2d(TriA[0], TriA[1], TriA[1]));
+		Intersector.SetTriangle1(UE::Geometry::FTriangle2d(TriB));
+
+		const bool ExpectedSegmentHit = Intersector.Test();
+
+		if(Daylon::DoesLineSegmentIntersectTriangle(TriA[0], TriA[1], TriB) != ExpectedSegmentHit)
+		{
+			UE_LOG(LogGame, Error, TEXT("Daylon::DoesLineSegmentIntersectTriangle disagrees for line %f, %f - %f, %f vs. triangle %f, %f - %f, %f - %f, %f"),
+				TriA[0].X, TriA[0].Y, TriA[1].X, TriA[1].Y, TriB[0].X, TriB[0].Y, TriB[1].X, TriB[1].Y, TriB[2].X, TriB[2].Y);
+			NumSegmentMismatches++;
+		}
+
+		// Triangle vs. triangle.
+
+		Intersector.SetTriangle0(UE::Geometry::FTriangle2d(TriA));
+
+		const bool ExpectedTriangleHit = Intersector.Test();
+
+		if(ExpectedTriangleHit)
+		{
+			NumHits++;
+		}
+
+		if(Daylon::DoTrianglesIntersect(TriA, TriB) != ExpectedTriangleHit)
+		{
+			UE_LOG(LogGame, Error, TEXT("Daylon::DoTrianglesIntersect disagrees for triangles %f, %f - %f, %f - %f, %f vs. %f, %f - %f, %f - %f, %f"),
+				TriA[0].X, TriA[0].Y, TriA[1].X, TriA[1].Y, TriA[2].X, TriA[2].Y, TriB[0].X, TriB[0].Y, TriB[1].X, TriB[1].Y, TriB[2].X, TriB[2].Y);
+			NumTriangleMismatches++;
+		}
+	}
+
+	UE_LOG(LogGame, Log, TEXT("Triangle routines: %d cases (%d triangle hits), %d segment mismatches, %d triangle mismatches"),
+		NumCases, NumHits, NumSegmentMismatches, NumTriangleMismatches);
+}
+
+
+static void BenchmarkAsteroidCollisions()
+{
+	// Run a field of rocks (more than the game ever spawns) bouncing off each other for
+	// ten seconds' worth of 60 Hz frames, and check the first frame against testing every pair.
+
+	const int32 NumFrames = 600;
+	const float DeltaTime = 1.0f / 60;
+
+	for(int32 NumRocks : { 1000, 2000, 4000 })
+	{
+		FAsteroidBodies Bodies;
+
+		const int32 Values[] = { ValueBigAsteroid, ValueMediumAsteroid, ValueSmallAsteroid };
+		const float Radii [] = { 60.0f, 30.0f, 15.0f };
+
+		for(int32 Idx = 0; Idx < NumRocks; Idx++)
+		{
+			const int32 Size = Daylon::RandRange(0, 2);
+
+			Bodies.Add(FVector2D(Daylon::FRandRange(0.0f, ViewportSize.X), Daylon::FRandRange(0.0f, ViewportSize.Y)),
+				Daylon::RandVector2D() * Daylon::FRandRange(MinAsteroidSpeed, MaxAsteroidSpeed),
+				Radii[Size] * 0.5f, // Keep a thousand rocks from packing the screen solid
+				FAsteroids::GetMass(Values[Size]));
+		}
+
+		// Reference: every pair, at every wrap offset, in the same order as CollideBodies.
+
+		FAsteroidBodies Expected = Bodies;
+
+		for(int32 Index = 0; Index < Expected.Num(); Index++)
+		{
+			const FVector2D P = Expected.Positions[Index];
+			const FBox2d    Bounds(P - FVector2D(Expected.Radii[Index]), P + FVector2D(Expected.Radii[Index]));
+
+			for(int32 Other = Index + 1; Other < Expected.Num(); Other++)
+			{
+				const FVector2D OtherP = Expected.Positions[Other];
+
+				FVector2D Offsets[Daylon::MaxWrapOffsets];
+
+				const int32 NumOffsets = Daylon::GetWrapOffsets(FBox2d(OtherP - FVector2D(Expected.Radii[Other]), OtherP + FVector2D(Expected.Radii[Other])), Bounds, ViewportSize, Offsets);
+
+				for(int32 OffsetIndex = 0; OffsetIndex < NumOffsets; OffsetIndex++)
+				{
+					if(FVector2D::Distance(P, OtherP + Offsets[OffsetIndex]) < Expected.Radii[Index] + Expected.Radii[Other])
+					{
+						Daylon::ComputeCollisionInertia(Expected.Masses[Index], Expected.Masses[Other], AsteroidRestitution, P, OtherP + Offsets[OffsetIndex], Expected.Inertias[Index], Expected.Inertias[Other]);
+						break;
+					}
+				}
+			}
+		}
+
+		Daylon::FUniformGrid2D                  Grid;
+		TArray<Daylon::FUniformGrid2D::FEntry>  Neighbors;
+
+		Grid.Init(FBox2d(FVector2D(0), ViewportSize), CollisionGridCellSize);
+
+		int32 NumBounces = FAsteroids::CollideBodies(Bodies, Grid, Neighbors);
+		int32 NumMismatches = 0;
+
+		for(int32 Index = 0; Index < Bodies.Num(); Index++)
+		{
+			if(!Bodies.Inertias[Index].Equals(Expected.Inertias[Index], 0.001))
+			{
+				NumMismatches++;
+			}
+		}
+
+		if(NumMismatches > 0)
+		{
+			UE_LOG(LogGame, Error, TEXT("FAsteroids::CollideBodies disagrees with testing every pair for %d of %d rocks"), NumMismatches, NumRocks);
+		}
+
+		double WorstTime = 0.0;
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		for(int32 Frame = 0; Frame < NumFrames; Frame++)
+		{
+			for(int32 Index = 0; Index < Bodies.Num(); Index++)
+			{
+				auto& P = Bodies.Positions[Index];
+
+				P += Bodies.Inertias[Index] * DeltaTime;
+				P.Set(FMath::Wrap(P.X, 0.0, ViewportSize.X), FMath::Wrap(P.Y, 0.0, ViewportSize.Y));
+			}
+
+			const double FrameStartTime = FPlatformTime::Seconds();
+
+			NumBounces += FAsteroids::CollideBodies(Bodies, Grid, Neighbors);
+
+			WorstTime = FMath::Max(WorstTime, FPlatformTime::Seconds() - FrameStartTime);
+		}
+
+		const double TotalTime = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogGame, Log, TEXT("Rock vs. rock, %d rocks, %d frames: %.3f ms per frame (worst %.3f ms), %d bounces"),
+			NumRocks, NumFrames, TotalTime * 1000.0 / NumFrames, WorstTime * 1000.0, NumBounces);
+	}
+}
+
+
+static void BenchmarkParticleIntegration()
+{
+	// Advance a batch of particles for a second's worth of frames, one FDaylonParticle at a time
+	// the way the particle widgets used to, and with the SIMD kernel and compaction they use now.
+	// Lifetimes are spread out so that particles die along the way and get compacted.
+
+	const int32 Counts[]  = { 10000, 100000, 1000000 };
+	const int32 NumFrames = 60;
+	const float DeltaTime = 1.0f / 60.0f;
+
+	for(const int32 NumParticles : Counts)
+	{
+		TArray<FDaylonParticle> Particles;
+		TArray<float>           X, Y, InertiaX, InertiaY, LifeRemaining;
+
+		Particles    .SetNum(NumParticles);
+		X            .SetNumUninitialized(NumParticles);
+		Y            .SetNumUninitialized(NumParticles);
+		InertiaX     .SetNumUninitialized(NumParticles);
+		InertiaY     .SetNumUninitialized(NumParticles);
+		LifeRemaining.SetNumUninitialized(NumParticles);
+
+		for(int32 Idx = 0; Idx < NumParticles; Idx++)
+		{
+			auto& Particle = Particles[Idx];
+
+			Particle.Inertia       = Daylon::RandVector2D() * Daylon::FRandRange(30.0f, 240.0f);
+			Particle.LifeRemaining = Daylon::FRandRange(0.25f, 2.0f);
+
+			X            [Idx] = 0.0f;
+			Y            [Idx] = 0.0f;
+			InertiaX     [Idx] = Particle.Inertia.X;
+			InertiaY     [Idx] = Particle.Inertia.Y;
+			LifeRemaining[Idx] = Particle.LifeRemaining;
+		}
+
+		int32 NumAliveOld = 0;
+
+		double StartTime = FPlatformTime::Seconds();
+
+		for(int32 Frame = 0; Frame < NumFrames; Frame++)
+		{
+			NumAliveOld = 0;
+
+			for(auto& Particle : Particles)
+			{
+				NumAliveOld += (Particle.Update(DeltaTime) ? 1 : 0);
+			}
+		}
+
+		const double TimeOld = FPlatformTime::Seconds() - StartTime;
+
+		TBitArray<> LiveMask;
+		int32       NumAliveNew = NumParticles;
+
+		StartTime = FPlatformTime::Seconds();
+
+		for(int32 Frame = 0; Frame < NumFrames; Frame++)
+		{
+			const int32 Count = X.Num();
+
+			NumAliveNew = Daylon::IntegrateParticles(X.GetData(), Y.GetData(), InertiaX.GetData(), InertiaY.GetData(), LifeRemaining.GetData(), Count, DeltaTime, LiveMask);
+
+			if(NumAliveNew < Count)
+			{
+				Daylon::CompactByMask(X,             LiveMask, NumAliveNew);
+				Daylon::CompactByMask(Y,             LiveMask, NumAliveNew);
+				Daylon::CompactByMask(InertiaX,      LiveMask, NumAliveNew);
+				Daylon::CompactByMask(InertiaY,      LiveMask, NumAliveNew);
+				Daylon::CompactByMask(LifeRemaining, LiveMask, NumAliveNew);
+			}
+		}
+
+		const double TimeNew = FPlatformTime::Seconds() - StartTime;
+
+		// Throughput is particles simulated per frame, whether or not a path skips the dead ones.
+
+		const double ParticleFrames = (double)NumParticles * NumFrames;
+
+		UE_LOG(LogGame, Log, TEXT("Particle integration, %d particles x %d frames: one at a time %.0f particles/ms (%d alive), SIMD + compaction %.0f particles/ms (%d alive), %.1fx"),
+			NumParticles, NumFrames, 
+			(TimeOld > 0.0 ? ParticleFrames / (TimeOld * 1000.0) : 0.0), NumAliveOld,
+			(TimeNew > 0.0 ? ParticleFrames / (TimeNew * 1000.0) : 0.0), NumAliveNew,
+			(TimeNew > 0.0 ? TimeOld / TimeNew : 0.0));
+
+		if(NumAliveOld != NumAliveNew)
+		{
+			UE_LOG(LogGame, Error, TEXT("Particle integration: scalar and SIMD paths disagree on the number of live particles"));
+		}
+	}
+}
+
+
+static void BenchmarkTaskScheduling()
+{
+	// Run ten seconds' worth of frames over a backlog of pending tasks, ticking every task every
+	// frame the way UpdateTasks used to, and with FTaskScheduler, which only touches the ones that fire.
+
+	const int32 Counts[]  = { 1000, 10000, 100000 };
+	const int32 NumFrames = 600;
+	const float DeltaTime = 1.0f / 60.0f;
+
+	for(const int32 NumTasks : Counts)
+	{
+		TArray<float> Whens;
+
+		Whens.SetNumUninitialized(NumTasks);
+
+		for(auto& When : Whens)
+		{
+			When = Daylon::FRandRange(0.0f, 20.0f); // About half fire during the run
+		}
+
+		int32 NumFiredOld = 0;
+		int32 NumFiredNew = 0;
+
+		TArray<Daylon::FScheduledTask> OldTasks;
+
+		OldTasks.Reserve(NumTasks);
+
+		for(const float When : Whens)
+		{
+			auto& Task = OldTasks.AddDefaulted_GetRef();
+			Task.When = When;
+			Task.What = [&NumFiredOld]() { NumFiredOld++; };
+		}
+
+		double StartTime = FPlatformTime::Seconds();
+
+		for(int32 Frame = 0; Frame < NumFrames; Frame++)
+		{
+			for(int32 Index = OldTasks.Num() - 1; Index >= 0; Index--)
+			{
+				if(OldTasks[Index].Tick(DeltaTime))
+				{
+					OldTasks.RemoveAtSwap(Index);
+				}
+			}
+		}
+
+		const double TimeOld = FPlatformTime::Seconds() - StartTime;
+
+		Daylon::FTaskScheduler Scheduler;
+
+		for(const float When : Whens)
+		{
+			Scheduler.Schedule(When, [&NumFiredNew]() { NumFiredNew++; });
+		}
+
+		StartTime = FPlatformTime::Seconds();
+
+		for(int32 Frame = 0; Frame < NumFrames; Frame++)
+		{
+			Scheduler.Tick(DeltaTime);
+		}
+
+		const double TimeNew = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogGame, Log, TEXT("Task scheduling, %d tasks x %d frames: tick all %.3f ms/frame, scheduler %.3f ms/frame, %d fired, %.1fx"),
+			NumTasks, NumFrames,
+			TimeOld * 1000.0 / NumFrames, TimeNew * 1000.0 / NumFrames, NumFiredNew,
+			(TimeNew > 0.0 ? TimeOld / TimeNew : 0.0));
+
+		// Float countdowns and a double clock can disagree by a task or so right at the cutoff.
+		if(FMath::Abs(NumFiredOld - NumFiredNew) > 1)
+		{
+			UE_LOG(LogGame, Error, TEXT("Task scheduling: ticked tasks fired %d times, scheduler fired %d"), NumFiredOld, NumFiredNew);
+		}
+	}
+}
+
+
+static void BenchmarkRandomStreams()
+{
+	// Draw the same amount of random numbers from an MTRand (what Daylon::Rng used to be)
+	// and from an FRng stream. Then split a stream across work items and check that
+	// running them on worker threads gives the same numbers as running them in order.
+
+	const int32 NumDraws = 10'000'000;
+
+	Daylon::MTRand OldRng(1234);
+	Daylon::FRng   NewRng(1234);
+
+	double SumOld = 0.0;
+	double SumNew = 0.0;
+
+	double StartTime = FPlatformTime::Seconds();
+
+	for(int32 Index = 0; Index < NumDraws; Index++)
+	{
+		SumOld += OldRng.rand(10.0) + Daylon::RandRange(OldRng, 0, 99);
+	}
+
+	const double TimeOld = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+
+	for(int32 Index = 0; Index < NumDraws; Index++)
+	{
+		SumNew += NewRng.FRandRange(0.0, 10.0) + NewRng.RandRange(0, 99);
+	}
+
+	const double TimeNew = FPlatformTime::Seconds() - StartTime;
+
+	// The sums keep the loops from being optimized away, and should both be near 54.5 per draw.
+
+	UE_LOG(LogGame, Log, TEXT("Random numbers, %d draws: MTRand %.3f ms (mean %.2f), FRng %.3f ms (mean %.2f), %.1fx, state %d vs. %d bytes"),
+		NumDraws,
+		TimeOld * 1000.0, SumOld / NumDraws, TimeNew * 1000.0, SumNew / NumDraws,
+		(TimeNew > 0.0 ? TimeOld / TimeNew : 0.0),
+		(int32)sizeof(Daylon::MTRand), (int32)sizeof(Daylon::FRng));
+
+	const int32 NumItems        = 256;
+	const int32 NumDrawsPerItem = 10'000;
+
+	const Daylon::FRng Parent(5678);
+
+	auto RunItem = [&](int32 Item)
+	{
+		auto Rng = Parent.Split(Item);
+
+		uint32 Hash = 0;
+
+		for(int32 Index = 0; Index < NumDrawsPerItem; Index++)
+		{
+			Hash = Hash * 31 + Rng.Next();
+		}
+
+		return Hash;
+	};
+
+	TArray<uint32> Serial;
+	TArray<uint32> Parallel;
+
+	Serial  .SetNumUninitialized(NumItems);
+	Parallel.SetNumUninitialized(NumItems);
+
+	for(int32 Item = 0; Item < NumItems; Item++)
+	{
+		Serial[Item] = RunItem(Item);
+	}
+
+	ParallelFor(NumItems, [&](int32 Item) { Parallel[Item] = RunItem(Item); });
+
+	int32 NumDuplicates = 0;
+
+	for(int32 Item = 1; Item < NumItems; Item++)
+	{
+		NumDuplicates += (Serial[Item] == Serial[0] ? 1 : 0);
+	}
+
+	if(Serial != Parallel || NumDuplicates > 0)
+	{
+		UE_LOG(LogGame, Error, TEXT("Random streams: split streams differ between serial and parallel runs, or repeat (%d duplicates)"), NumDuplicates);
+	}
+	else
+	{
+		UE_LOG(LogGame, Log, TEXT("Random streams: %d split streams gave the same numbers serially and in parallel"), NumItems);
+	}
+}
+
+
+void UPlayViewBase::TestPhysics()
+{
+	TestLineSegmentVsCircle();
+	TestLineSegmentVsCircles();
+	TestLineSegmentVsCircleEdges();
+	BenchmarkLineSegmentVsCircles();
+	FuzzTriangleRoutines();
+	BenchmarkAsteroidCollisions();
+	BenchmarkParticleIntegration();
+	BenchmarkTaskScheduling();
+	BenchmarkRandomStreams();
+}
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", on)
+#endif
+
+#undef DEBUG_MODULE
@@ -4,9 +4,10 @@
 #include "Constants.h"
 #include "DaylonAudio.h"
 #include "DaylonGeometry.h"
+#include "GameRules.h"
 
 
-TSharedPtr<FPlayerShip> FPlayerShip::Create(const FDaylonSpriteAtlas& Atlas, const FVector2D& S, float RadiusFactor)
+TSharedPtr<FPlayerShip> FPlayerShip::Create(const FDaylonSpriteAtlasHandle& Atlas, const FVector2D& S, float RadiusFactor)
 {
 	auto Widget = SNew(FPlayerShip);
 
@@ -60,7 +61,7 @@ void FPlayerShip::InitializeDefenses()
 
 	Shield->SetAtlas(Arena->GetDefensesAtlas());
 	Shield->SetCurrentCel(ShieldDefenseAtlasCel);
-	Shield->SetSize(Arena->GetDefensesAtlas().GetCelPixelSize());
+	Shield->SetSize(Arena->GetDefensesAtlas()->GetCelPixelSize());
 	Shield->UpdateWidgetSize();
 
 	Shield->Start  (ViewportSize / 2, FVector2D(0), 1.0f);
@@ -73,7 +74,7 @@ void FPlayerShip::InitializeDefenses()
 
 	InvincibilityShield->SetAtlas(Arena->GetDefensesAtlas());
 	InvincibilityShield->SetCurrentCel(InvincibilityDefenseAtlasCel);
-	InvincibilityShield->SetSize(Arena->GetDefensesAtlas().GetCelPixelSize());
+	InvincibilityShield->SetSize(Arena->GetDefensesAtlas()->GetCelPixelSize());
 	InvincibilityShield->UpdateWidgetSize();
 	InvincibilityShield->Start(ViewportSize / 2, FVector2D(0), 1.0f);
 	InvincibilityShield->Hide();
@@ -111,19 +112,7 @@ void FPlayerShip::Perform(float DeltaTime)
 			Arena->GetPlayerShipThrustSoundLoop().Tick(DeltaTime);
 		}
 
-		const float Thrust = PlayerThrustForce * DeltaTime;
-
-		const FVector2D Force = GetDirectionVector() * Thrust;
-
-		Inertia += Force;
-
-		// Limit speed to avoid breaking collision detector.
-
-		if(Inertia.Length() > MaxPlayerShipSpeed)
-		{
-			Inertia.Normalize();
-			Inertia *= MaxPlayerShipSpeed;
-		}
+		ApplyPlayerShipThrust(GetMotion().Inertia, GetDirectionVector(), DeltaTime);
 	}
 	else
 	{
@@ -133,7 +122,7 @@ void FPlayerShip::Perform(float DeltaTime)
 		}
 	}
 
-	Move(DeltaTime, Arena->GetWrapPositionFunction());
+	Move(DeltaTime, GetViewportWrap());
 
 
 	// Update shield power levels.
@@ -143,7 +132,7 @@ void FPlayerShip::Perform(float DeltaTime)
 	if(Shield->IsVisible())
 	{
 		// We have to budge the shield texture by two px to look nicely centered around the player ship.
-		Shield->SetPosition(GetPosition() + Daylon::Rotate(FVector2D(0, 2), GetAngle()));
+		Shield->SetPositionRelativeTo(*this, Daylon::Rotate(FVector2D(0, 2), GetAngle()));
 		AdjustShieldsLeft(-DeltaTime);
 	}
 
@@ -172,7 +161,7 @@ void FPlayerShip::Perform(float DeltaTime)
 	if(InvincibilityShield->IsVisible())
 	{
 		InvincibilityShield->SetAngle(GetAngle());
-		InvincibilityShield->SetPosition(GetPosition() + Daylon::Rotate(FVector2D(0, -2), GetAngle()));
+		InvincibilityShield->SetPositionRelativeTo(*this, Daylon::Rotate(FVector2D(0, -2), GetAngle()));
 	}
 
 	if(InvincibilityLeft > 0.0f)
@@ -185,7 +174,7 @@ void FPlayerShip::Perform(float DeltaTime)
 void FPlayerShip::SpawnExplosion()
 {
 	const auto P           = GetPosition();
-	const auto ShipInertia = Inertia * 0; // Don't use any inertia 
+	const auto ShipInertia = GetInertia() * 0; // Don't use any inertia 
 
 	Arena->GetExplosions().SpawnOne(P, PlayerShipFirstExplosionParams, ShipInertia);
 
@@ -231,7 +220,7 @@ bool FPlayerShip::ProcessCollision(float MassOther, const FVector2D* PositionOth
 				1.0, // restitution coefficient, 1 = perfectly elastic collision
 				GetPosition(),
 				*PositionOther,
-				Inertia,
+				GetMotion().Inertia,
 				TmpInertiaOther);
 		}
 	}
@@ -262,7 +251,7 @@ void FPlayerShip::FireTorpedo()
 {
 	const FVector2D PlayerFwd = GetDirectionVector();
 
-	const auto TorpedoInertia = (PlayerFwd * MaxTorpedoSpeed) + Inertia;
+	const auto TorpedoInertia = (PlayerFwd * MaxTorpedoSpeed) + GetInertia();
 
 	// Position torpedo at nose of player ship.
 
@@ -6,15 +6,26 @@
 #include "Powerup.h"
 
 
-TSharedPtr<FPowerup> FPowerup::Create(const FDaylonSpriteAtlas& Atlas, const FVector2D& S)
+TSharedPtr<FPowerup> FPowerup::CreateWidget()
 {
 	auto Widget = SNew(FPowerup);
 
 	Daylon::Install<SDaylonSprite>(Widget, 0.5f);
 
+	return Widget;
+}
+
+
+TSharedPtr<FPowerup> FPowerup::Create(Daylon::TPlayObjectPool<FPowerup>& Pool, const FDaylonSpriteAtlasHandle& Atlas, const FVector2D& S)
+{
+	auto Widget = Pool.Acquire();
+
+	Widget->Kind = EPowerup::Nothing;
+
 	Widget->SetAtlas(Atlas);
 	Widget->SetSize(S);
 	Widget->UpdateWidgetSize();
+	Widget->Show();
 
 	return Widget;
 }
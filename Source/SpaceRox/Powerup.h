@@ -28,7 +28,8 @@ class FPowerup : public FPlayObject
 
 		EPowerup Kind = EPowerup::Nothing;
 
-		static TSharedPtr<FPowerup>  Create  (const FDaylonSpriteAtlas& Atlas, const FVector2D& S);
+		static TSharedPtr<FPowerup>  Create        (Daylon::TPlayObjectPool<FPowerup>& Pool, const FDaylonSpriteAtlasHandle& Atlas, const FVector2D& S);
+		static TSharedPtr<FPowerup>  CreateWidget  ();
 
 		virtual void  Update  (float DeltaTime) override { FPlayObject::Update(DeltaTime); }
 };
@@ -36,14 +37,14 @@ class FPowerup : public FPlayObject
 
 class FPowerupFactory
 {
-	Daylon::MTRand Rng;
+	Daylon::FRng   Rng;
 	TArray<int32>  MinXpsForPowerup;
 
 	public:
 
 		FPowerupFactory() 
 		{
-			Rng.seed(0); 
+			Rng.Seed(0); 
 			MinXpsForPowerup.Init(0, (int32)EPowerup::LAST);
 		}
 
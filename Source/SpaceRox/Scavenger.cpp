@@ -7,17 +7,30 @@
 #include "Constants.h"
 
 
-TSharedPtr<FScavenger> FScavenger::Create(const FDaylonSpriteAtlas& Atlas, const FVector2D& S)
+TSharedPtr<FScavenger> FScavenger::CreateWidget()
 {
 	auto Widget = SNew(FScavenger);
 
 	Daylon::Install<SDaylonSprite>(Widget, 0.5f);
 
+	return Widget;
+}
+
+
+TSharedPtr<FScavenger> FScavenger::Create(Daylon::TPlayObjectPool<FScavenger>& Pool, const FDaylonSpriteAtlasHandle& Atlas, const FVector2D& S)
+{
+	auto Widget = Pool.Acquire();
+
+	Widget->AcquiredPowerups.Reset();
+	Widget->CurrentTarget.Reset();
+	Widget->XDirection = 1;
+
 	Widget->SetAtlas(Atlas);
 	Widget->SetSize(S);
 	Widget->UpdateWidgetSize();
 
-	Widget->Value = ValueScavenger;
+	Widget->SetValue(ValueScavenger);
+	Widget->Show();
 
 	return Widget;
 }
@@ -24,5 +24,6 @@ class FScavenger : public FPlayObject
 		int XDirection = 1; // -1 to travel from right to left
 
 
-		static TSharedPtr<FScavenger>  Create  (const FDaylonSpriteAtlas& Atlas, const FVector2D& S);
+		static TSharedPtr<FScavenger>  Create        (Daylon::TPlayObjectPool<FScavenger>& Pool, const FDaylonSpriteAtlasHandle& Atlas, const FVector2D& S);
+		static TSharedPtr<FScavenger>  CreateWidget  ();
 };
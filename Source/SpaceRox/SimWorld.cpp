@@ -0,0 +1,485 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+// SpaceRox - an Atari Asteroids clone developed with Unreal Engine.
+
+
+#include "SimWorld.h"
+#include "Logging.h"
+#include "GameRules.h"
+
+
+
+// Set to 1 to enable debugging
+#define DEBUG_MODULE                0
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", off)
+#endif
+
+
+static void PlaceObject(Daylon::FMotionComponent& Motion, const FVector2D& P)
+{
+	Motion.Position             =
+	Motion.OldPosition          =
+	Motion.UnwrappedNewPosition = P;
+}
+
+
+static void MoveObject(Daylon::FMotionComponent& Motion, float DeltaTime)
+{
+	// Like FAsteroids::Update, minus the widgets.
+
+	Motion.OldPosition          = Motion.Position;
+	Motion.UnwrappedNewPosition = Motion.Position + Motion.Inertia * DeltaTime;
+	Motion.Position             = Daylon::WrapPosition(Motion.UnwrappedNewPosition, ViewportSize);
+}
+
+
+void FSimWorld::Start(const FSimParams& InParams)
+{
+	// Same as UPlayViewBase entering its active state.
+
+	Params = InParams;
+
+	checkf(Params.BigAsteroidSize.X > 0 && Params.MediumAsteroidSize.X > 0 && Params.SmallAsteroidSize.X > 0, TEXT("FSimWorld needs the rock sizes, see UPlayViewBase::GetSimParams"));
+
+	// Each game gets its own stream, so back-to-back games differ but a run with the same seed replays.
+	Rng.Seed(Params.RandomSeed != 0 ? (uint64)Params.RandomSeed : FPlatformTime::Cycles64(), NumGamesStarted++);
+
+	Grid    .Init(FBox2d(FVector2D(0), ViewportSize), CollisionGridCellSize);
+	BodyGrid.Init(FBox2d(FVector2D(0), ViewportSize), CollisionGridCellSize);
+
+	Asteroids.Reset();
+	Torpedos.Reset();
+	Torpedos.SetNum(TorpedoCount);
+
+	PlayerScore             = 0;
+	NumPlayerShips          = InitialPlayerShipCount;
+	WaveNumber              = 0;
+	FrameNumber             = 0;
+	TimeUntilNextWave       = 2.0f;
+	TimeUntilNextPlayerShip = 0.0f;
+
+	// See UPlayViewBase::CreatePlayerShip.
+
+	PlayerShipCollision.Size         = PlayerShipSize;
+	PlayerShipCollision.RadiusFactor = PlayerShipRadiusFactor;
+
+	PlayerShipMotion = Daylon::FMotionComponent();
+	PlaceObject(PlayerShipMotion, ViewportSize / 2);
+	PlayerShipLifetime.LifeRemaining = 1.0f;
+}
+
+
+void FSimWorld::Update(float DeltaTime, const FSimInput& Input)
+{
+	// Same order as UPlayViewBase::NativeTick in the active state.
+
+	FrameNumber++;
+
+	if(IsPlayerShipPresent())
+	{
+		UpdatePlayerShip(DeltaTime, Input);
+	}
+
+	for(int32 Index = 0; Index < Asteroids.Num(); Index++)
+	{
+		auto& Motion = Asteroids.Motion[Index];
+
+		MoveObject(Motion, DeltaTime);
+		Motion.Angle = Daylon::WrapAngle(Motion.Angle + Motion.SpinSpeed * DeltaTime);
+	}
+
+	if(Params.bAsteroidsCollide)
+	{
+		CollideAsteroids();
+	}
+
+	for(int32 Index = 0; Index < Torpedos.Num(); Index++)
+	{
+		auto& Lifetime = Torpedos.Lifetime[Index];
+
+		if(!Lifetime.IsAlive())
+		{
+			continue;
+		}
+
+		Lifetime.LifeRemaining -= DeltaTime;
+
+		if(Lifetime.IsAlive())
+		{
+			MoveObject(Torpedos.Motion[Index], DeltaTime);
+		}
+	}
+
+	CheckCollisions();
+
+	UpdateWaveTransition(DeltaTime);
+
+	if(!IsPlayerShipPresent())
+	{
+		UpdatePlayerShipSpawn(DeltaTime);
+	}
+}
+
+
+void FSimWorld::StartWave()
+{
+	TimeUntilNextWave = TimeBetweenWaves;
+
+	WaveNumber++;
+
+	const int32 NumAsteroids = Params.NumAsteroidsOverride > 0 ? Params.NumAsteroidsOverride : GetNumWaveAsteroids(WaveNumber);
+
+	Asteroids.Reset();
+
+	for(int32 Index = 0; Index < NumAsteroids; Index++)
+	{
+		const FVector2D P = GetAsteroidSpawnPosition(Rng);
+
+		AddAsteroid(ValueBigAsteroid, P, Daylon::RandVector2D(Rng) * Rng.FRandRange(MinAsteroidSpeed, MaxAsteroidSpeed), Rng.FRandRange(MinAsteroidSpinSpeed, MaxAsteroidSpinSpeed));
+	}
+}
+
+
+void FSimWorld::UpdateWaveTransition(float DeltaTime)
+{
+	// See UPlayViewBase::ProcessWaveTransition.
+
+	if(TimeUntilNextWave < TimeBetweenWaves)
+	{
+		TimeUntilNextWave -= DeltaTime;
+
+		if(TimeUntilNextWave <= 0.0f)
+		{
+			StartWave();
+		}
+
+		return;
+	}
+
+	if(Asteroids.IsEmpty())
+	{
+		TimeUntilNextWave = TimeBetweenWaves - DeltaTime;
+	}
+}
+
+
+void FSimWorld::AddAsteroid(int32 Value, const FVector2D& P, const FVector2D& Inertia, float SpinSpeed)
+{
+	// See FAsteroid::Spawn.
+
+	const int32 Index = Asteroids.Add();
+
+	Asteroids.Values   [Index].Value         = Value;
+	Asteroids.Lifetime [Index].LifeRemaining = 1.0f;
+	Asteroids.Collision[Index].Size          = GetAsteroidSize(Value);
+	Asteroids.Collision[Index].RadiusFactor  = AsteroidRadiusFactor;
+
+	auto& Motion = Asteroids.Motion[Index];
+
+	PlaceObject(Motion, P);
+
+	Motion.Inertia   = Inertia;
+	Motion.SpinSpeed = SpinSpeed;
+}
+
+
+FVector2D FSimWorld::GetAsteroidSize(int32 Value) const
+{
+	switch(Value)
+	{
+		case ValueBigAsteroid:    return Params.BigAsteroidSize;
+		case ValueMediumAsteroid: return Params.MediumAsteroidSize;
+		default:                  return Params.SmallAsteroidSize;
+	}
+}
+
+
+void FSimWorld::UpdatePlayerShip(float DeltaTime, const FSimInput& Input)
+{
+	// See FPlayerShip::Perform and UPlayViewBase::OnFireTorpedo.
+
+	if(Input.bFire)
+	{
+		FireTorpedo();
+	}
+
+	PlayerShipMotion.Angle = Daylon::WrapAngle(PlayerShipMotion.Angle + PlayerRotationSpeed * DeltaTime * Input.RotationForce);
+
+	if(Input.bThrust)
+	{
+		ApplyPlayerShipThrust(PlayerShipMotion.Inertia, Daylon::AngleToVector2D(PlayerShipMotion.Angle), DeltaTime);
+	}
+
+	MoveObject(PlayerShipMotion, DeltaTime);
+}
+
+
+void FSimWorld::FireTorpedo()
+{
+	// See FPlayerShip::FireTorpedo (without double guns).
+
+	const int32 Index = Torpedos.Lifetime.IndexOfByPredicate([](const Daylon::FLifetimeComponent& Lifetime) { return !Lifetime.IsAlive(); });
+
+	if(Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FVector2D PlayerFwd = Daylon::AngleToVector2D(PlayerShipMotion.Angle);
+
+	FVector2D P = PlayerShipMotion.Position + PlayerFwd * (PlayerShipCollision.Size.Y / 2 + 2.0);
+
+	P = Daylon::WrapPosition(P, ViewportSize);
+
+	PlaceObject(Torpedos.Motion[Index], P);
+
+	Torpedos.Motion  [Index].Inertia       = (PlayerFwd * MaxTorpedoSpeed) + PlayerShipMotion.Inertia;
+	Torpedos.Lifetime[Index].LifeRemaining = MaxTorpedoLifeTime;
+}
+
+
+void FSimWorld::UpdatePlayerShipSpawn(float DeltaTime)
+{
+	// See UPlayViewBase::ProcessPlayerShipSpawn.
+
+	if(TimeUntilNextPlayerShip > 0.0f)
+	{
+		TimeUntilNextPlayerShip -= DeltaTime;
+		return;
+	}
+
+	if(NumPlayerShips == 0)
+	{
+		return;
+	}
+
+	// Like UPlayViewBase::IsSafeToSpawnPlayerShip, with each rock's box the size of its sprite.
+
+	const FBox2d SafeZone = GetPlayerShipSpawnSafeZone(0.0f);
+
+	for(int32 Index = 0; Index < Asteroids.Num(); Index++)
+	{
+		const FVector2D P        = Asteroids.Motion[Index].UnwrappedNewPosition;
+		const FVector2D HalfSize = Asteroids.Collision[Index].Size / 2;
+
+		if(FBox2d(P - HalfSize, P + HalfSize).Intersect(SafeZone))
+		{
+			return;
+		}
+	}
+
+	PlayerShipMotion.Inertia = FVector2D(0);
+	PlaceObject(PlayerShipMotion, ViewportSize / 2);
+	PlayerShipLifetime.LifeRemaining = 1.0f;
+}
+
+
+void FSimWorld::CollideAsteroids()
+{
+	// See FAsteroids::CollideWithEachOther.
+
+	Bodies.Reset();
+
+	for(int32 Index = 0; Index < Asteroids.Num(); Index++)
+	{
+		const auto& Motion = Asteroids.Motion[Index];
+
+		Bodies.Add(Motion.Position, Motion.Inertia, Asteroids.Collision[Index].GetRadius(), FAsteroids::GetMass(Asteroids.Values[Index].Value));
+	}
+
+	FAsteroids::CollideBodies(Bodies, BodyGrid, BodyNeighbors);
+
+	for(int32 Index = 0; Index < Asteroids.Num(); Index++)
+	{
+		Asteroids.Motion[Index].Inertia = Bodies.Inertias[Index];
+	}
+}
+
+
+void FSimWorld::CheckCollisions()
+{
+	// Torpedos vs. rocks, then the player ship vs. rocks, in index order, with each rock
+	// hit at most once per frame, using the same broadphase and tests as UPlayViewBase's
+	// detection phase. Removals and splits wait until everything's been tested,
+	// like UPlayViewBase::ResolveCollisions.
+
+	const int32 NumAsteroids = Asteroids.Num();
+
+	Grid.Reset();
+
+	for(int32 Index = 0; Index < NumAsteroids; Index++)
+	{
+		FAsteroids::AddToGrid(Grid, Index, FAsteroid::GetCollisionBounds(Asteroids.Motion[Index], Asteroids.Collision[Index].GetRadius()));
+	}
+
+	TBitArray<> AsteroidsHit(false, NumAsteroids);
+
+	auto& Candidates = Scratch.AsteroidCandidates;
+
+	for(int32 TorpedoIndex = 0; TorpedoIndex < Torpedos.Num(); TorpedoIndex++)
+	{
+		if(!Torpedos.Lifetime[TorpedoIndex].IsAlive())
+		{
+			continue;
+		}
+
+		const auto& TorpedoMotion = Torpedos.Motion[TorpedoIndex];
+
+		FAsteroids::QueryGrid(Grid, MakeSweptBounds(TorpedoMotion.OldPosition, TorpedoMotion.UnwrappedNewPosition, 0.0), Candidates);
+
+		DetectTorpedoAsteroidHits(TorpedoMotion.OldPosition, TorpedoMotion.UnwrappedNewPosition, Asteroids.Motion, Asteroids.Collision, Scratch);
+
+		for(int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); CandidateIndex++)
+		{
+			const int32 AsteroidIndex = Candidates[CandidateIndex].Index;
+
+			if(Scratch.AsteroidHits[CandidateIndex] && !AsteroidsHit[AsteroidIndex])
+			{
+				AsteroidsHit[AsteroidIndex] = true;
+				Torpedos.Lifetime[TorpedoIndex].LifeRemaining = 0.0f;
+				break;
+			}
+		}
+	}
+
+	if(IsPlayerShipPresent())
+	{
+		const FPlayerShipCollisionShape PlayerShipShape = MakePlayerShipCollisionShape(PlayerShipMotion, PlayerShipCollision);
+
+		FAsteroids::QueryGrid(Grid, PlayerShipShape.Bounds, Candidates);
+
+		for(const auto& Candidate : Candidates)
+		{
+			if(AsteroidsHit[Candidate.Index]
+				|| !DoesPlayerShipHitAsteroid(PlayerShipShape, Asteroids.Motion[Candidate.Index], Asteroids.Collision[Candidate.Index].GetRadius(), Candidate.Offset))
+			{
+				continue;
+			}
+
+			AsteroidsHit[Candidate.Index] = true;
+
+			if(!Params.bGodMode)
+			{
+				KillPlayerShip();
+			}
+
+			break;
+		}
+	}
+
+	// Rocks only ever get hit by the player (or by running into the player ship), so always credit them.
+	// Go in descending order so removals (which swap the last rock in) and kids added by splits
+	// don't disturb the indices still to visit.
+
+	for(int32 Index = NumAsteroids - 1; Index >= 0; Index--)
+	{
+		if(AsteroidsHit[Index])
+		{
+			KillAsteroid(Index, CreditPlayerForKill);
+		}
+	}
+}
+
+
+void FSimWorld::KillAsteroid(int32 Index, bool KilledByPlayer)
+{
+	// See FAsteroids::Kill and FAsteroid::Split.
+
+	if(KilledByPlayer)
+	{
+		NumPlayerShips += IncreaseScore(PlayerScore, Asteroids.Values[Index].Value);
+	}
+
+	const int32 SplitValue = GetAsteroidSplitValue(Asteroids.Values[Index].Value);
+
+	if(SplitValue == 0)
+	{
+		Asteroids.Remove(Index);
+		return;
+	}
+
+	auto& Motion = Asteroids.Motion[Index];
+
+	FVector2D KidInertia;
+
+	ComputeAsteroidSplitInertias(Rng, Motion.Inertia, Motion.Inertia, KidInertia);
+
+	Motion.SpinSpeed *= AsteroidSpinScale;
+
+	Asteroids.Values   [Index].Value = SplitValue;
+	Asteroids.Collision[Index].Size  = GetAsteroidSize(SplitValue);
+
+	// Motion is a reference into the array, so copy what the kid needs before adding it.
+
+	const FVector2D P         = Motion.UnwrappedNewPosition;
+	const float     SpinSpeed = Motion.SpinSpeed;
+
+	AddAsteroid(SplitValue, P, KidInertia, SpinSpeed);
+}
+
+
+void FSimWorld::KillPlayerShip()
+{
+	// See UPlayViewBase::KillPlayerShip.
+
+	PlayerShipLifetime.LifeRemaining = 0.0f;
+	NumPlayerShips                   = FMath::Max(0, NumPlayerShips - 1);
+	TimeUntilNextPlayerShip          = MaxTimeUntilNextPlayerShip;
+}
+
+
+FSimInput FSimWorld::ComputeAutopilotInput() const
+{
+	FSimInput Input;
+
+	if(!IsPlayerShipPresent())
+	{
+		return Input;
+	}
+
+	// Find the nearest rock, allowing for the shortest way being across a wrap seam.
+
+	FVector2D ToTarget(0);
+	double    BestDistanceSquared = TNumericLimits<double>::Max();
+
+	for(const auto& Asteroid : Asteroids.Motion)
+	{
+		FVector2D Delta = Asteroid.Position - PlayerShipMotion.Position;
+
+		Delta.X = FMath::Wrap(Delta.X, -ViewportSize.X / 2, ViewportSize.X / 2);
+		Delta.Y = FMath::Wrap(Delta.Y, -ViewportSize.Y / 2, ViewportSize.Y / 2);
+
+		if(Delta.SizeSquared() < BestDistanceSquared)
+		{
+			BestDistanceSquared = Delta.SizeSquared();
+			ToTarget            = Delta;
+		}
+	}
+
+	if(!ToTarget.Normalize())
+	{
+		return Input;
+	}
+
+	// Turn whichever way brings the nose closer to the target, and shoot a few times a second when lined up.
+
+	const float Angle = PlayerShipMotion.Angle;
+
+	const double TurnLeft  = Daylon::AngleToVector2D(Angle - 5.0f) | ToTarget;
+	const double TurnRight = Daylon::AngleToVector2D(Angle + 5.0f) | ToTarget;
+
+	Input.RotationForce = (TurnRight > TurnLeft ? 1.0f : -1.0f);
+	Input.bFire         = ((Daylon::AngleToVector2D(Angle) | ToTarget) > 0.985 && FrameNumber % 8 == 0);
+
+	return Input;
+}
+
+
+#if(DEBUG_MODULE == 1)
+#pragma optimize("", on)
+#endif
+
+#undef DEBUG_MODULE
@@ -0,0 +1,130 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+// SpaceRox - an Atari Asteroids clone developed with Unreal Engine.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Constants.h"
+#include "Asteroids.h"
+#include "Collision.h"
+#include "DaylonPlayObjectStore.h"
+#include "DaylonSpatialGrid.h"
+#include "DaylonRNG.h"
+
+
+// A model of the core game (rocks, torpedos, the player ship, score, ships left and waves)
+// that needs no renderer, viewport or widget tree, so it can run thousands of frames per
+// second unattended, e.g. from the SpaceRoxSim commandlet.
+//
+// It keeps its objects in the same components the game's play objects use, sized like the
+// game's (see UPlayViewBase::GetSimParams), and plays by the same rules: GameRules.h for
+// spawning, splitting, thrust and scoring, FAsteroids for the broadphase grid and rock bounces,
+// and Collision.h for the player ship's shape and the torpedo and ship vs. rock tests.
+//
+// Not modelled yet: enemy ships, scavengers, bosses, powerups and the player ship's defenses.
+
+
+struct FSimObjects
+{
+	// Components laid out like an FPlayObjectStore's, minus the widgets.
+	// Remove() mirrors TArray::RemoveAtSwap, as FPlayObjectStore::Release() does.
+
+	TArray<Daylon::FMotionComponent>     Motion;
+	TArray<Daylon::FCollisionComponent>  Collision;
+	TArray<Daylon::FLifetimeComponent>   Lifetime;
+	TArray<Daylon::FValueComponent>      Values;
+
+	int32  Num     () const { return Motion.Num(); }
+	bool   IsEmpty () const { return Motion.IsEmpty(); }
+
+	void   Reset   ()             { Motion.Reset(); Collision.Reset(); Lifetime.Reset(); Values.Reset(); }
+	void   SetNum  (int32 Number) { Motion.SetNum(Number); Collision.SetNum(Number); Lifetime.SetNum(Number); Values.SetNum(Number); }
+
+	// Returns the index of a new object with default components.
+	int32  Add     ()             { Collision.AddDefaulted(); Lifetime.AddDefaulted(); Values.AddDefaulted(); return Motion.AddDefaulted(); }
+	void   Remove  (int32 Index)  { Motion.RemoveAtSwap(Index); Collision.RemoveAtSwap(Index); Lifetime.RemoveAtSwap(Index); Values.RemoveAtSwap(Index); }
+};
+
+
+struct FSimInput
+{
+	// What the player is doing this frame.
+
+	float  RotationForce = 0.0f;  // -1 to 1, like UPlayViewBase::RotationForce
+	bool   bThrust       = false;
+	bool   bFire         = false; // Fire button went down this frame
+};
+
+
+struct FSimParams
+{
+	// Rock sizes come from the play view's atlases, like FAsteroid::Spawn's;
+	// use UPlayViewBase::GetSimParams rather than filling them in by hand.
+
+	FVector2D  BigAsteroidSize      = FVector2D(0);
+	FVector2D  MediumAsteroidSize   = FVector2D(0);
+	FVector2D  SmallAsteroidSize    = FVector2D(0);
+
+	float  SimulationRate       = 0.0f;   // Like UPlayViewBase::SimulationRate
+	int32  NumAsteroidsOverride = 0;      // Like UPlayViewBase::NumAsteroidsOverride
+	bool   bAsteroidsCollide    = false;  // Like UPlayViewBase::bAsteroidsCollide
+	bool   bGodMode             = false;
+	int32  RandomSeed           = 0;      // Like UPlayViewBase::RandomSeed
+};
+
+
+class FSimWorld
+{
+	public:
+
+		FSimParams                   Params;
+
+		FSimObjects                  Asteroids;
+		FSimObjects                  Torpedos;
+
+		// The player ship's components. It's present while it's alive.
+		Daylon::FMotionComponent     PlayerShipMotion;
+		Daylon::FCollisionComponent  PlayerShipCollision;
+		Daylon::FLifetimeComponent   PlayerShipLifetime;
+
+		int32                        PlayerScore             = 0;
+		int32                        NumPlayerShips          = 0;
+		int32                        WaveNumber              = 0;
+		int64                        FrameNumber             = 0;
+		float                        TimeUntilNextWave       = 0.0f;
+		float                        TimeUntilNextPlayerShip = 0.0f;
+		Daylon::FRng                 Rng;
+
+
+		void       Start                 (const FSimParams& InParams);
+		void       Update                (float DeltaTime, const FSimInput& Input);
+
+		bool       IsPlayerShipPresent   () const { return PlayerShipLifetime.IsAlive(); }
+		bool       IsOver                () const { return (NumPlayerShips == 0 && !IsPlayerShipPresent()); }
+
+		// A simple pilot for unattended runs: turns toward the nearest rock and shoots when lined up.
+		FSimInput  ComputeAutopilotInput () const;
+
+
+	protected:
+
+		int32                                   NumGamesStarted = 0;
+		Daylon::FUniformGrid2D                  Grid;
+		FCollisionScratch                       Scratch;
+		FAsteroidBodies                         Bodies;
+		Daylon::FUniformGrid2D                  BodyGrid;
+		TArray<Daylon::FUniformGrid2D::FEntry>  BodyNeighbors;
+
+		void       StartWave             ();
+		void       AddAsteroid           (int32 Value, const FVector2D& P, const FVector2D& Inertia, float SpinSpeed);
+		FVector2D  GetAsteroidSize       (int32 Value) const;
+		void       UpdatePlayerShip      (float DeltaTime, const FSimInput& Input);
+		void       UpdatePlayerShipSpawn (float DeltaTime);
+		void       UpdateWaveTransition  (float DeltaTime);
+		void       FireTorpedo           ();
+		void       CollideAsteroids      ();
+		void       CheckCollisions       ();
+		void       KillAsteroid          (int32 Index, bool KilledByPlayer);
+		void       KillPlayerShip        ();
+};
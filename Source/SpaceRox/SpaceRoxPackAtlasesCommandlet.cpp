@@ -0,0 +1,379 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+// SpaceRox - an Atari Asteroids clone developed with Unreal Engine.
+
+
+#include "SpaceRoxPackAtlasesCommandlet.h"
+#include "UDaylonSpriteWidget.h"
+#include "Logging.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Texture2D.h"
+#include "ImageCore.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+#endif
+
+
+USpaceRoxPackAtlasesCommandlet::USpaceRoxPackAtlasesCommandlet()
+{
+	IsClient        = false;
+	IsServer        = false;
+	IsEditor        = true;
+	LogToConsole    = true;
+	ShowErrorCount  = true;
+}
+
+
+#if WITH_EDITOR
+
+struct FAtlasBlock
+{
+	// The rows of an atlas's cels that are in use, copied out of its texture.
+	// Blocks are packed whole, so the cels keep their layout within the page.
+
+	UDaylonSpriteWidgetAtlas*  Asset;
+	FImage                     Pixels;          // BGRA8
+	FIntPoint                  CelSize;
+	int32                      Page     = INDEX_NONE;
+	FIntPoint                  Position = FIntPoint(0);
+};
+
+
+struct FAtlasPage
+{
+	// Blocks are placed left to right along shelves, and shelves are stacked downward.
+
+	int32      ShelfX       = 0;
+	int32      ShelfY       = 0;
+	int32      ShelfHeight  = 0;
+	FIntPoint  UsedSize     = FIntPoint(0);
+
+
+	bool Place(FAtlasBlock& Block, int32 PageSize, int32 Padding)
+	{
+		const FIntPoint Size((int32)Block.Pixels.SizeX, (int32)Block.Pixels.SizeY);
+
+		if(ShelfX > 0 && ShelfX + Size.X > PageSize)
+		{
+			ShelfY     += ShelfHeight + Padding;
+			ShelfX      = 0;
+			ShelfHeight = 0;
+		}
+
+		if(ShelfX + Size.X > PageSize || ShelfY + Size.Y > PageSize)
+		{
+			return false;
+		}
+
+		Block.Position = FIntPoint(ShelfX, ShelfY);
+
+		ShelfX     += Size.X + Padding;
+		ShelfHeight = FMath::Max(ShelfHeight, Size.Y);
+
+		UsedSize.X = FMath::Max(UsedSize.X, Block.Position.X + Size.X);
+		UsedSize.Y = FMath::Max(UsedSize.Y, Block.Position.Y + Size.Y);
+
+		return true;
+	}
+};
+
+
+static bool SaveAssetPackage(UObject* Asset)
+{
+	UPackage* Package = Asset->GetPackage();
+
+	const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+
+	if(!UPackage::SavePackage(Package, Asset, *Filename, SaveArgs))
+	{
+		UE_LOG(LogGame, Error, TEXT("SpaceRoxPackAtlases: could not save %s"), *Filename);
+		return false;
+	}
+
+	return true;
+}
+
+
+static bool ClearPacking(UDaylonSpriteWidgetAtlas* Asset)
+{
+	if(Asset->PackedTexture == nullptr && Asset->PackedCelUVs.IsEmpty())
+	{
+		return true;
+	}
+
+	Asset->PackedTexture = nullptr;
+	Asset->PackedCelUVs.Empty();
+	Asset->MarkPackageDirty();
+
+	return SaveAssetPackage(Asset);
+}
+
+
+static bool ReadAtlasBlock(UDaylonSpriteWidgetAtlas* Asset, FAtlasBlock& Block)
+{
+	// Returns false if the atlas can't be packed, in which case it keeps using its own texture.
+
+	const auto& Atlas   = Asset->Atlas;
+	auto        Texture = Cast<UTexture2D>(Atlas.AtlasBrush.GetResourceObject());
+
+	if(Texture == nullptr || !Texture->Source.IsValid())
+	{
+		UE_LOG(LogGame, Warning, TEXT("SpaceRoxPackAtlases: %s has no source texture, skipping it"), *Asset->GetName());
+		return false;
+	}
+
+	FImage SourceImage;
+
+	if(!Texture->Source.GetMipImage(SourceImage, 0, 0, 0))
+	{
+		UE_LOG(LogGame, Warning, TEXT("SpaceRoxPackAtlases: could not read %s, skipping %s"), *Texture->GetName(), *Asset->GetName());
+		return false;
+	}
+
+	if(Atlas.CelsAcross <= 0 || Atlas.CelsDown <= 0 || SourceImage.SizeX % Atlas.CelsAcross != 0 || SourceImage.SizeY % Atlas.CelsDown != 0)
+	{
+		// The runtime UVs split the texture evenly, so cels that aren't a whole number of pixels can't be copied exactly.
+
+		UE_LOG(LogGame, Warning, TEXT("SpaceRoxPackAtlases: %s (%d x %d) doesn't divide into %d x %d cels, skipping %s"),
+			*Texture->GetName(), (int32)SourceImage.SizeX, (int32)SourceImage.SizeY, Atlas.CelsAcross, Atlas.CelsDown, *Asset->GetName());
+		return false;
+	}
+
+	FImage Image;
+	SourceImage.CopyTo(Image, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+
+	Block.Asset   = Asset;
+	Block.CelSize = FIntPoint(Image.SizeX / Atlas.CelsAcross, Image.SizeY / Atlas.CelsDown);
+
+	// Leave out trailing rows with no cels in use.
+
+	const int32 NumRows = FMath::DivideAndRoundUp(FMath::Clamp(Atlas.NumCels, 1, Atlas.CelsAcross * Atlas.CelsDown), Atlas.CelsAcross);
+
+	Block.Pixels.Init(Image.SizeX, NumRows * Block.CelSize.Y, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+
+	FMemory::Memcpy(Block.Pixels.RawData.GetData(), Image.RawData.GetData(), Block.Pixels.RawData.Num());
+
+	return true;
+}
+
+
+static UTexture2D* SavePage(const FString& OutPath, int32 PageIndex, const FIntPoint& Size, const TArray<FColor>& Pixels)
+{
+	const FString PackageName = FString::Printf(TEXT("%s/T_PackedAtlas_%d"), *OutPath, PageIndex);
+	const FString AssetName   = FPackageName::GetLongPackageAssetName(PackageName);
+
+	UPackage* Package = CreatePackage(*PackageName);
+	Package->FullyLoad();
+
+	auto Texture = FindObject<UTexture2D>(Package, *AssetName);
+
+	const bool IsNew = (Texture == nullptr);
+
+	if(IsNew)
+	{
+		Texture = NewObject<UTexture2D>(Package, *AssetName, RF_Public | RF_Standalone);
+	}
+
+	Texture->PreEditChange(nullptr);
+
+	Texture->Source.Init(Size.X, Size.Y, 1, 1, TSF_BGRA8, (const uint8*)Pixels.GetData());
+
+	Texture->SRGB                = true;
+	Texture->CompressionSettings = TC_EditorIcon;   // Uncompressed, like UI textures
+	Texture->MipGenSettings      = TMGS_NoMipmaps;
+	Texture->LODGroup            = TEXTUREGROUP_UI;
+
+	Texture->PostEditChange();
+
+	if(IsNew)
+	{
+		FAssetRegistryModule::AssetCreated(Texture);
+	}
+
+	Package->MarkPackageDirty();
+
+	return (SaveAssetPackage(Texture) ? Texture : nullptr);
+}
+
+#endif // WITH_EDITOR
+
+
+int32 USpaceRoxPackAtlasesCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString Root    = TEXT("/Game");
+	FString OutPath = TEXT("/Game/PackedAtlases");
+	int32   PageSize = 4096;
+	int32   Padding  = 2;
+
+	FParse::Value(*Params, TEXT("root="),     Root);
+	FParse::Value(*Params, TEXT("out="),      OutPath);
+	FParse::Value(*Params, TEXT("pagesize="), PageSize);
+	FParse::Value(*Params, TEXT("padding="),  Padding);
+
+	const bool Unpack = FParse::Param(*Params, TEXT("unpack"));
+
+	if(PageSize <= 0 || Padding < 0)
+	{
+		UE_LOG(LogGame, Error, TEXT("SpaceRoxPackAtlases: -pagesize must be positive and -padding can't be negative"));
+		return 1;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UDaylonSpriteWidgetAtlas::StaticClass()->GetClassPathName());
+	Filter.PackagePaths.Add(*Root);
+	Filter.bRecursivePaths = true;
+
+	TArray<FAssetData> AssetDatas;
+	AssetRegistry.GetAssets(Filter, AssetDatas);
+
+	// Sort so that the same assets always pack the same way.
+
+	AssetDatas.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+	int32 NumErrors = 0;
+
+	TArray<FAtlasBlock> Blocks;
+
+	for(const auto& AssetData : AssetDatas)
+	{
+		auto Asset = Cast<UDaylonSpriteWidgetAtlas>(AssetData.GetAsset());
+
+		if(Asset == nullptr)
+		{
+			continue;
+		}
+
+		FAtlasBlock Block;
+
+		if(Unpack || !ReadAtlasBlock(Asset, Block))
+		{
+			NumErrors += (ClearPacking(Asset) ? 0 : 1);
+			continue;
+		}
+
+		if((int32)Block.Pixels.SizeX > PageSize || (int32)Block.Pixels.SizeY > PageSize)
+		{
+			UE_LOG(LogGame, Warning, TEXT("SpaceRoxPackAtlases: %s (%d x %d) is bigger than a page, leaving it unpacked"),
+				*Asset->GetName(), (int32)Block.Pixels.SizeX, (int32)Block.Pixels.SizeY);
+
+			NumErrors += (ClearPacking(Asset) ? 0 : 1);
+			continue;
+		}
+
+		Blocks.Add(MoveTemp(Block));
+	}
+
+	if(Unpack)
+	{
+		UE_LOG(LogGame, Display, TEXT("SpaceRoxPackAtlases: unpacked %d atlases"), AssetDatas.Num());
+		return (NumErrors > 0 ? 1 : 0);
+	}
+
+	// Shelf packing works best tallest first.
+
+	Blocks.StableSort([](const FAtlasBlock& A, const FAtlasBlock& B) { return A.Pixels.SizeY > B.Pixels.SizeY; });
+
+	TArray<FAtlasPage> Pages;
+
+	for(int32 BlockIndex = 0; BlockIndex < Blocks.Num(); BlockIndex++)
+	{
+		auto& Block = Blocks[BlockIndex];
+
+		for(int32 PageIndex = 0; PageIndex < Pages.Num() && Block.Page == INDEX_NONE; PageIndex++)
+		{
+			if(Pages[PageIndex].Place(Block, PageSize, Padding))
+			{
+				Block.Page = PageIndex;
+			}
+		}
+
+		if(Block.Page == INDEX_NONE)
+		{
+			verify(Pages.AddDefaulted_GetRef().Place(Block, PageSize, Padding));
+			Block.Page = Pages.Num() - 1;
+		}
+	}
+
+	for(int32 PageIndex = 0; PageIndex < Pages.Num(); PageIndex++)
+	{
+		// Trim the page to the power of two sizes that hold its blocks.
+
+		const FIntPoint PageDims(
+			FMath::Min(PageSize, (int32)FMath::RoundUpToPowerOfTwo(Pages[PageIndex].UsedSize.X)),
+			FMath::Min(PageSize, (int32)FMath::RoundUpToPowerOfTwo(Pages[PageIndex].UsedSize.Y)));
+
+		TArray<FColor> Pixels;
+		Pixels.Init(FColor(0, 0, 0, 0), PageDims.X * PageDims.Y);
+
+		for(const auto& Block : Blocks)
+		{
+			if(Block.Page != PageIndex)
+			{
+				continue;
+			}
+
+			const auto  Src      = Block.Pixels.AsBGRA8();
+			const int32 SrcWidth = (int32)Block.Pixels.SizeX;
+
+			for(int32 Y = 0; Y < (int32)Block.Pixels.SizeY; Y++)
+			{
+				FMemory::Memcpy(&Pixels[(Block.Position.Y + Y) * PageDims.X + Block.Position.X], &Src[Y * SrcWidth], SrcWidth * sizeof(FColor));
+			}
+		}
+
+		auto Texture = SavePage(OutPath, PageIndex, PageDims, Pixels);
+
+		if(Texture == nullptr)
+		{
+			NumErrors++;
+			continue;
+		}
+
+		const FVector2D InvPageDims(1.0 / PageDims.X, 1.0 / PageDims.Y);
+
+		for(const auto& Block : Blocks)
+		{
+			if(Block.Page != PageIndex)
+			{
+				continue;
+			}
+
+			const auto& Atlas = Block.Asset->Atlas;
+
+			Block.Asset->PackedTexture = Texture;
+			Block.Asset->PackedCelUVs.Reset(Atlas.NumCels);
+
+			for(int32 CelIndex = 0; CelIndex < Atlas.NumCels; CelIndex++)
+			{
+				const FIntPoint CelPos(
+					Block.Position.X + (CelIndex % Atlas.CelsAcross) * Block.CelSize.X,
+					Block.Position.Y + (CelIndex / Atlas.CelsAcross) * Block.CelSize.Y);
+
+				Block.Asset->PackedCelUVs.Add(FBox2D(FVector2D(CelPos) * InvPageDims, FVector2D(CelPos + Block.CelSize) * InvPageDims));
+			}
+
+			Block.Asset->MarkPackageDirty();
+
+			NumErrors += (SaveAssetPackage(Block.Asset) ? 0 : 1);
+		}
+
+		UE_LOG(LogGame, Display, TEXT("SpaceRoxPackAtlases: page %d is %d x %d"), PageIndex, PageDims.X, PageDims.Y);
+	}
+
+	UE_LOG(LogGame, Display, TEXT("SpaceRoxPackAtlases: packed %d of %d atlases into %d pages"), Blocks.Num(), AssetDatas.Num(), Pages.Num());
+
+	return (NumErrors > 0 ? 1 : 0);
+#else
+	UE_LOG(LogGame, Error, TEXT("SpaceRoxPackAtlases: only runs in the editor"));
+	return 1;
+#endif
+}
@@ -0,0 +1,36 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+// SpaceRox - an Atari Asteroids clone developed with Unreal Engine.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SpaceRoxPackAtlasesCommandlet.generated.h"
+
+/**
+ * Packs the cels of every UDaylonSpriteWidgetAtlas asset into one or a few large page
+ * textures, and stores each atlas's page and remapped cel UVs in the atlas asset. At runtime,
+ * UDaylonSpriteWidgetAtlas::Build() picks these up, so sprites of different kinds draw from
+ * the same texture and Slate can batch them. Rerun it after editing any atlas. For example:
+ *
+ *   UnrealEditor-Cmd SpaceRox.uproject -run=SpaceRoxPackAtlases -pagesize=4096
+ *
+ * -root=Path      only pack atlases under this content path (default /Game)
+ * -out=Path       where to save the page textures (default /Game/PackedAtlases)
+ * -pagesize=N     largest page width and height in pixels (default 4096)
+ * -padding=N      transparent pixels between packed atlases (default 2)
+ * -unpack         clear the packing from the atlases instead, so they use their own textures again
+ */
+UCLASS()
+class SPACEROX_API USpaceRoxPackAtlasesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+	public:
+
+	USpaceRoxPackAtlasesCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,98 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+// SpaceRox - an Atari Asteroids clone developed with Unreal Engine.
+
+
+#include "SpaceRoxSimCommandlet.h"
+#include "SimWorld.h"
+#include "PlayViewBase.h"
+#include "Logging.h"
+
+
+USpaceRoxSimCommandlet::USpaceRoxSimCommandlet()
+{
+	IsClient        = false;
+	IsServer        = false;
+	IsEditor        = false;
+	LogToConsole    = true;
+	ShowErrorCount  = true;
+}
+
+
+int32 USpaceRoxSimCommandlet::Main(const FString& Params)
+{
+	int64 NumFrames = 100000;
+
+	FParse::Value(*Params, TEXT("frames="), NumFrames);
+
+	// Start from the play view blueprint's settings and rock sizes, so the sim plays like the game.
+
+	FString PlayViewPath = TEXT("/Game/PlayView.PlayView_C");
+
+	FParse::Value(*Params, TEXT("playview="), PlayViewPath);
+
+	UClass* PlayViewClass = LoadClass<UPlayViewBase>(nullptr, *PlayViewPath);
+
+	if(PlayViewClass == nullptr)
+	{
+		UE_LOG(LogGame, Error, TEXT("SpaceRoxSim: can't load play view class %s"), *PlayViewPath);
+		return 1;
+	}
+
+	FSimParams SimParams = GetDefault<UPlayViewBase>(PlayViewClass)->GetSimParams();
+
+	FParse::Value(*Params, TEXT("rocks="), SimParams.NumAsteroidsOverride);
+	FParse::Value(*Params, TEXT("seed="),  SimParams.RandomSeed);
+
+	SimParams.bAsteroidsCollide |= FParse::Param(*Params, TEXT("collide"));
+	SimParams.bGodMode          |= FParse::Param(*Params, TEXT("godmode"));
+
+	if(NumFrames <= 0)
+	{
+		UE_LOG(LogGame, Error, TEXT("SpaceRoxSim: -frames must be positive"));
+		return 1;
+	}
+
+	// Step at the game's simulation rate.
+
+	const float DeltaTime = 1.0f / SimParams.SimulationRate;
+
+	FSimWorld World;
+
+	int32 NumGames    = 0;
+	int64 TotalScore  = 0;
+	int32 BestScore   = 0;
+	int64 TotalWaves  = 0;
+	int32 MaxRocks    = 0;
+
+	World.Start(SimParams);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for(int64 Frame = 0; Frame < NumFrames; Frame++)
+	{
+		World.Update(DeltaTime, World.ComputeAutopilotInput());
+
+		MaxRocks = FMath::Max(MaxRocks, World.Asteroids.Num());
+
+		if(World.IsOver())
+		{
+			NumGames++;
+			TotalScore += World.PlayerScore;
+			TotalWaves += World.WaveNumber;
+			BestScore   = FMath::Max(BestScore, World.PlayerScore);
+
+			World.Start(SimParams);
+		}
+	}
+
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogGame, Display, TEXT("SpaceRoxSim: %lld frames (%.1f game minutes) in %.3f seconds, %.0f frames per second"),
+		NumFrames, NumFrames * DeltaTime / 60, ElapsedTime, (ElapsedTime > 0.0 ? NumFrames / ElapsedTime : 0.0));
+
+	UE_LOG(LogGame, Display, TEXT("SpaceRoxSim: %d games over, average score %.0f (best %d), average wave %.1f, at most %d rocks at once"),
+		NumGames, (NumGames > 0 ? (double)TotalScore / NumGames : 0.0), BestScore, (NumGames > 0 ? (double)TotalWaves / NumGames : 0.0), MaxRocks);
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+// Copyright 2023 Daylon Graphics Ltd. All Rights Reserved.
+
+// SpaceRox - an Atari Asteroids clone developed with Unreal Engine.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SpaceRoxSimCommandlet.generated.h"
+
+/**
+ * Runs FSimWorld games back to back under the autopilot, with no renderer or widgets,
+ * and logs how fast they ran and how they went. Rock sizes, the step rate and the defaults
+ * for the options below come from the play view blueprint. For example:
+ *
+ *   UnrealEditor-Cmd SpaceRox.uproject -run=SpaceRoxSim -nullrhi -frames=1000000 -rocks=200 -collide
+ *
+ * -frames=N     total frames to simulate (default 100000)
+ * -rocks=N      rocks per wave instead of the usual wave sizes
+ * -seed=N       random seed, so a run can be repeated (default: from the clock)
+ * -collide      make rocks bounce off each other
+ * -godmode      the player ship can't be destroyed
+ * -playview=P   play view blueprint class to take settings from (default /Game/PlayView.PlayView_C)
+ */
+UCLASS()
+class SPACEROX_API USpaceRoxSimCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+	public:
+
+	USpaceRoxSimCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
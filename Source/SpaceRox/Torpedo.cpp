@@ -6,7 +6,7 @@
 #include "Torpedo.h"
 
 
-TSharedPtr<FTorpedo> FTorpedo::Create(const FDaylonSpriteAtlas& Atlas, float RadiusFactor)
+TSharedPtr<FTorpedo> FTorpedo::Create(const FDaylonSpriteAtlasHandle& Atlas, float RadiusFactor)
 {
 	auto Widget = SNew(FTorpedo);
 
@@ -14,7 +14,7 @@ TSharedPtr<FTorpedo> FTorpedo::Create(const FDaylonSpriteAtlas& Atlas, float Rad
 
 	Widget->SetAtlas(Atlas);
 	Widget->SetCurrentCel(0);
-	Widget->SetSize(Atlas.GetCelPixelSize());
+	Widget->SetSize(Atlas->GetCelPixelSize());
 	Widget->UpdateWidgetSize();
 
 	return Widget;